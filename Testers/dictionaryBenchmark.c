@@ -0,0 +1,193 @@
+/*---------- ID HEADER -------------------------------------
+/   Author(s):    Aidan Andrews, Kyle Scidmore
+/   File Name:    dictionaryBenchmark.c
+/
+/   File Description:
+/     This file is a standalone benchmark comparing the forward dictionary
+/     backends (pointer Trie built serially, with its reverse Trie and in
+/     parallel, compact Trie and DAWG) on the same word list.
+/     For each backend it reports the build time, the memory the structure
+/     occupies, the time for looking up every word in a shuffled order, and
+/     the time the move generator needs for one rack on one board.
+/     It also times the legacy drivers (generateCombinations and findMoves)
+/     on the same rack and board.
+/
+/---------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../io.h"
+#include "../moveGenerator.h"
+#include "../solver.h"
+
+#define LOOKUP_ROUNDS 5
+#define GENERATOR_ROUNDS 50
+#define LEGACY_ROUNDS 5
+
+double now(void);
+size_t countTrieNodes(const TrieNode *node);
+char (*readWords(const char *filename, size_t *totalWords))[BOARD_SIZE + 1];
+void benchmarkBackend(const char *name, int structure, const char *dictionaryFile, char (*words)[BOARD_SIZE + 1], size_t totalWords, Board *board, const char *rack);
+void benchmarkLegacyDrivers(const char *dictionaryFile, Board *board, const char *rack);
+
+double now(void) {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec + time.tv_nsec / 1e9;
+}
+
+size_t countTrieNodes(const TrieNode *node) {
+    size_t total = 1;
+    for (int i = 0; i < MAX_CHARACTERS; i++) {
+        if (node->children[i]) {
+            total += countTrieNodes(node->children[i]);
+        }
+    }
+    return total;
+}
+
+char (*readWords(const char *filename, size_t *totalWords))[BOARD_SIZE + 1] {
+    FILE *file = fopen(filename, "r");
+    if (!file) {
+        perror("Failed to open dictionary file");
+        exit(1);
+    }
+
+    size_t capacity = 4096;
+    char (*words)[BOARD_SIZE + 1] = malloc(capacity * sizeof(*words));
+    *totalWords = 0;
+    while (words && fscanf(file, "%15s", words[*totalWords]) == 1) {
+        for (char *letter = words[*totalWords]; *letter; letter++) {
+            *letter = toupper((unsigned char)*letter);
+        }
+        if (++*totalWords == capacity) {
+            capacity *= 2;
+            words = realloc(words, capacity * sizeof(*words));
+        }
+    }
+    fclose(file);
+    if (!words) {
+        perror("Failed to allocate memory");
+        exit(1);
+    }
+
+    // Shuffle so lookups do not walk the structure in storage order
+    srand(12345);
+    for (size_t i = *totalWords; i > 1; i--) {
+        size_t j = (size_t)rand() % i;
+        char swap[BOARD_SIZE + 1];
+        memcpy(swap, words[i - 1], sizeof(swap));
+        memcpy(words[i - 1], words[j], sizeof(swap));
+        memcpy(words[j], swap, sizeof(swap));
+    }
+    return words;
+}
+
+void benchmarkBackend(const char *name, int structure, const char *dictionaryFile, char (*words)[BOARD_SIZE + 1], size_t totalWords, Board *board, const char *rack) {
+    double start = now();
+    Dictionary *dictionary = loadDictionaryStructures(dictionaryFile, structure);
+    double loadTime = now() - start;
+
+    size_t nodes = 0;
+    size_t bytes = 0;
+    size_t reverseBytes = 0;
+    if (dictionary->trie) {
+        nodes = countTrieNodes(dictionary->trie);
+        bytes = trieMemoryUsage(dictionary->trie, &reverseBytes);
+    } else if (dictionary->compactTrie) {
+        nodes = dictionary->compactTrie->totalNodes;
+        bytes = compactTrieMemoryUsage(dictionary->compactTrie);
+    } else if (dictionary->dawg) {
+        nodes = dictionary->dawg->totalNodes;
+        bytes = dawgMemoryUsage(dictionary->dawg);
+    }
+
+    size_t found = 0;
+    start = now();
+    for (int round = 0; round < LOOKUP_ROUNDS; round++) {
+        for (size_t i = 0; i < totalWords; i++) {
+            found += dictionarySearchWord(dictionary, words[i]);
+        }
+    }
+    double lookupTime = (now() - start) / ((double)LOOKUP_ROUNDS * totalWords);
+
+    Move *moves = malloc(MAX_FOUND_MOVES * sizeof(Move));
+    int totalMoves = 0;
+    start = now();
+    for (int round = 0; round < GENERATOR_ROUNDS; round++) {
+        totalMoves = 0;
+        generateMovesInDictionary(dictionary, board, rack, moves, &totalMoves, MAX_FOUND_MOVES);
+    }
+    double generatorTime = (now() - start) / GENERATOR_ROUNDS;
+
+    printf("%-13s %9zu nodes %8.1f MB  build %7.1f ms  lookup %6.1f ns/word  generate %6.2f ms (%d moves)\n",
+        name, nodes, bytes / 1e6, loadTime * 1e3, lookupTime * 1e9, generatorTime * 1e3, totalMoves);
+    if (reverseBytes > 0) {
+        printf("              of which reverse Trie %zu nodes %8.1f MB\n",
+            countTrieNodes(reverseTrieRoot(dictionary->trie)), reverseBytes / 1e6);
+    }
+    if (found != (size_t)LOOKUP_ROUNDS * totalWords) {
+        printf("              warning: %zu of %zu lookups failed\n", (size_t)LOOKUP_ROUNDS * totalWords - found, (size_t)LOOKUP_ROUNDS * totalWords);
+    }
+
+    free(moves);
+    freeDictionary(dictionary);
+}
+
+void benchmarkLegacyDrivers(const char *dictionaryFile, Board *board, const char *rack) {
+    Dictionary *dictionary = loadDictionaryStructures(dictionaryFile, DICTIONARY_TRIE);
+    char **combinations = malloc(MAX_TOTAL_COMBINATIONS * sizeof(char *));
+    Move *moves = malloc(MAX_FOUND_MOVES * sizeof(Move));
+    unsigned int totalCombinations = 0;
+    int totalMoves = 0;
+    double combinationTime = 0;
+    double findTime = 0;
+
+    for (int round = 0; round < LEGACY_ROUNDS; round++) {
+        totalCombinations = 0;
+        double start = now();
+        generateCombinations(rack, combinations, &totalCombinations);
+        combinationTime += now() - start;
+
+        totalMoves = 0;
+        start = now();
+        findMoves(dictionary->trie, moves, &totalMoves, board->squares, combinations, totalCombinations);
+        findTime += now() - start;
+
+        for (unsigned int i = 0; i < totalCombinations; i++) {
+            free(combinations[i]);
+        }
+    }
+
+    printf("Legacy drivers  combinations %7.1f ms (%u)  findMoves %7.1f ms (%d moves)\n",
+        combinationTime * 1e3 / LEGACY_ROUNDS, totalCombinations, findTime * 1e3 / LEGACY_ROUNDS, totalMoves);
+
+    free(moves);
+    free(combinations);
+    freeDictionary(dictionary);
+}
+
+int main(int argc, char *argv[]) {
+    const char *dictionaryFile = argc > 1 ? argv[1] : "ValidInputFiles/dictionary.txt";
+    const char *boardFile = argc > 2 ? argv[2] : "ValidInputFiles/validBoard.txt";
+    const char *rack = argc > 3 ? argv[3] : "ICKBEAM";
+
+    Board board;
+    initBoard(&board);
+    loadBoard(&board, boardFile);
+
+    size_t totalWords = 0;
+    char (*words)[BOARD_SIZE + 1] = readWords(dictionaryFile, &totalWords);
+    printf("%zu words from %s, rack %s on %s\n", totalWords, dictionaryFile, rack, boardFile);
+
+    benchmarkBackend("Trie", DICTIONARY_TRIE, dictionaryFile, words, totalWords, &board, rack);
+    benchmarkBackend("Trie+Reverse", DICTIONARY_TRIE | DICTIONARY_REVERSE_TRIE, dictionaryFile, words, totalWords, &board, rack);
+    benchmarkBackend("Parallel Trie", DICTIONARY_TRIE | DICTIONARY_PARALLEL, dictionaryFile, words, totalWords, &board, rack);
+    benchmarkBackend("Compact Trie", DICTIONARY_COMPACT_TRIE, dictionaryFile, words, totalWords, &board, rack);
+    benchmarkBackend("DAWG", DICTIONARY_DAWG, dictionaryFile, words, totalWords, &board, rack);
+    benchmarkLegacyDrivers(dictionaryFile, &board, rack);
+
+    free(words);
+    return 0;
+}
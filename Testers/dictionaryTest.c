@@ -66,6 +66,162 @@ int testDictionary(const char *filename) {
     return passed;
 }
 
+int testGaddagDictionary(const char *filename) {
+    Dictionary *dictionary = loadDictionaryStructures(filename, DICTIONARY_GADDAG);
+
+    const char *testWords[] = {"APPLE", "MANGO", "PEACH", "GRAPES", "BANANA", "GGGGGGG"};
+    int numTests = sizeof(testWords) / sizeof(testWords[0]);
+    const char *results[sizeof(testWords) / sizeof(testWords[0])];
+    char resultBuffers[sizeof(testWords) / sizeof(testWords[0])][256];
+
+    for (int i = 0; i < numTests; i++) {
+        snprintf(resultBuffers[i], 256, "Searching for '%s': %s", testWords[i], searchGaddag(dictionary->gaddag, testWords[i]) ? "FOUND" : "NOT FOUND");
+        results[i] = resultBuffers[i];
+    }
+
+    int passed = compareResultsToValidOutput(results, numTests, validOutput);
+
+    freeDictionary(dictionary);
+    return passed;
+}
+
+int testDawgDictionary(const char *filename) {
+    Dictionary *dictionary = loadDictionaryStructures(filename, DICTIONARY_DAWG);
+
+    const char *testWords[] = {"APPLE", "MANGO", "PEACH", "GRAPES", "BANANA", "GGGGGGG"};
+    int numTests = sizeof(testWords) / sizeof(testWords[0]);
+    const char *results[sizeof(testWords) / sizeof(testWords[0])];
+    char resultBuffers[sizeof(testWords) / sizeof(testWords[0])][256];
+
+    for (int i = 0; i < numTests; i++) {
+        snprintf(resultBuffers[i], 256, "Searching for '%s': %s", testWords[i], searchDawg(dictionary->dawg, testWords[i]) ? "FOUND" : "NOT FOUND");
+        results[i] = resultBuffers[i];
+    }
+
+    int passed = compareResultsToValidOutput(results, numTests, validOutput);
+
+    freeDictionary(dictionary);
+    return passed;
+}
+
+int testCompactTrieDictionary(const char *filename) {
+    Dictionary *dictionary = loadDictionaryStructures(filename, DICTIONARY_COMPACT_TRIE);
+
+    const char *testWords[] = {"APPLE", "MANGO", "PEACH", "GRAPES", "BANANA", "GGGGGGG"};
+    int numTests = sizeof(testWords) / sizeof(testWords[0]);
+    const char *results[sizeof(testWords) / sizeof(testWords[0])];
+    char resultBuffers[sizeof(testWords) / sizeof(testWords[0])][256];
+
+    for (int i = 0; i < numTests; i++) {
+        snprintf(resultBuffers[i], 256, "Searching for '%s': %s", testWords[i], searchCompactTrie(dictionary->compactTrie, testWords[i]) ? "FOUND" : "NOT FOUND");
+        results[i] = resultBuffers[i];
+    }
+
+    int passed = compareResultsToValidOutput(results, numTests, validOutput);
+
+    freeDictionary(dictionary);
+    return passed;
+}
+
+int testParallelDictionary(const char *filename) {
+    Dictionary *dictionary = loadDictionaryStructures(filename, DICTIONARY_TRIE | DICTIONARY_PARALLEL);
+
+    const char *testWords[] = {"APPLE", "MANGO", "PEACH", "GRAPES", "BANANA", "GGGGGGG"};
+    int numTests = sizeof(testWords) / sizeof(testWords[0]);
+    const char *results[sizeof(testWords) / sizeof(testWords[0])];
+    char resultBuffers[sizeof(testWords) / sizeof(testWords[0])][256];
+
+    for (int i = 0; i < numTests; i++) {
+        snprintf(resultBuffers[i], 256, "Searching for '%s': %s", testWords[i], searchWord(dictionary->trie, testWords[i]) ? "FOUND" : "NOT FOUND");
+        results[i] = resultBuffers[i];
+    }
+
+    int passed = compareResultsToValidOutput(results, numTests, validOutput);
+
+    freeDictionary(dictionary);
+    return passed;
+}
+
+int testReverseDictionary(const char *filename) {
+    Dictionary *dictionary = loadDictionaryStructures(filename, DICTIONARY_TRIE | DICTIONARY_REVERSE_TRIE);
+    TrieNode *forwardOnly = loadDictionary(filename);
+
+    const char *testWords[] = {"APPLE", "MANGO", "PEACH", "GRAPES", "BANANA", "GGGGGGG"};
+    int numTests = sizeof(testWords) / sizeof(testWords[0]);
+    const char *results[sizeof(testWords) / sizeof(testWords[0])];
+    char resultBuffers[sizeof(testWords) / sizeof(testWords[0])][256];
+    int passed = reverseTrieRoot(dictionary->trie) != NULL && reverseTrieRoot(forwardOnly) == NULL;
+
+    for (int i = 0; i < numTests; i++) {
+        char reversed[BOARD_SIZE + 1];
+        int length = (int)strlen(testWords[i]);
+        for (int j = 0; j < length; j++) {
+            reversed[j] = testWords[i][length - 1 - j];
+        }
+        reversed[length] = '\0';
+
+        // The reverse Trie and the fallback through the forward Trie must agree
+        int found = searchReversedWord(dictionary->trie, reversed);
+        if (found != searchReversedWord(forwardOnly, reversed)) {
+            passed = 0;
+        }
+        snprintf(resultBuffers[i], 256, "Searching for '%s': %s", testWords[i], found ? "FOUND" : "NOT FOUND");
+        results[i] = resultBuffers[i];
+    }
+
+    passed = compareResultsToValidOutput(results, numTests, validOutput) && passed;
+
+    freeTrie(forwardOnly);
+    freeDictionary(dictionary);
+    return passed;
+}
+
+int testDictionaryImage(const char *filename) {
+    const char *imageFile = "Testers/dictionaryTests/validDictionary.dawg";
+
+    if (!compileDictionaryImage(filename, imageFile)) {
+        return 0;
+    }
+
+    Dictionary *dictionary = loadDictionaryImage(imageFile);
+    if (!dictionary) {
+        remove(imageFile);
+        return 0;
+    }
+
+    const char *testWords[] = {"APPLE", "MANGO", "PEACH", "GRAPES", "BANANA", "GGGGGGG"};
+    int numTests = sizeof(testWords) / sizeof(testWords[0]);
+    const char *results[sizeof(testWords) / sizeof(testWords[0])];
+    char resultBuffers[sizeof(testWords) / sizeof(testWords[0])][256];
+
+    for (int i = 0; i < numTests; i++) {
+        snprintf(resultBuffers[i], 256, "Searching for '%s': %s", testWords[i], dictionarySearchWord(dictionary, testWords[i]) ? "FOUND" : "NOT FOUND");
+        results[i] = resultBuffers[i];
+    }
+
+    int passed = compareResultsToValidOutput(results, numTests, validOutput);
+    freeDictionary(dictionary);
+
+    // A damaged image must be rejected rather than used
+    FILE *file = fopen(imageFile, "r+b");
+    if (file) {
+        fseek(file, -1, SEEK_END);
+        int last = fgetc(file);
+        fseek(file, -1, SEEK_END);
+        fputc(last ^ 0xFF, file);
+        fclose(file);
+    }
+    fprintf(stderr, "Expected rejection: ");
+    dictionary = loadDictionaryImage(imageFile);
+    if (dictionary) {
+        freeDictionary(dictionary);
+        passed = 0;
+    }
+
+    remove(imageFile);
+    return passed;
+}
+
 int compareResultsToValidOutput(const char *results[], int numResults, const char *validOutputFile) {
     FILE *file = fopen(validOutputFile, "r");
     if (!file) {
@@ -99,6 +255,12 @@ int main() {
 
     int testValid = testDictionary(validDictionary);
     int testInvalid = testDictionary(invalidDictionary);
+    int testGaddag = testGaddagDictionary(validDictionary);
+    int testDawg = testDawgDictionary(validDictionary);
+    int testCompact = testCompactTrieDictionary(validDictionary);
+    int testParallel = testParallelDictionary(validDictionary);
+    int testReverse = testReverseDictionary(validDictionary);
+    int testImage = testDictionaryImage(validDictionary);
 
     printf("%s[ %s ]%s Valid Dictionary Test\n",
         (testValid) ? GREEN : RED,
@@ -109,6 +271,30 @@ int main() {
         (testInvalid) ? GREEN : RED,
         (testInvalid) ? "PASSED" : "FAILED",
         RESET);
+    printf("%s[ %s ]%s Valid GADDAG Dictionary Test\n",
+        (testGaddag) ? GREEN : RED,
+        (testGaddag) ? "PASSED" : "FAILED",
+        RESET);
+    printf("%s[ %s ]%s Valid DAWG Dictionary Test\n",
+        (testDawg) ? GREEN : RED,
+        (testDawg) ? "PASSED" : "FAILED",
+        RESET);
+    printf("%s[ %s ]%s Valid Compact Trie Dictionary Test\n",
+        (testCompact) ? GREEN : RED,
+        (testCompact) ? "PASSED" : "FAILED",
+        RESET);
+    printf("%s[ %s ]%s Valid Parallel Dictionary Test\n",
+        (testParallel) ? GREEN : RED,
+        (testParallel) ? "PASSED" : "FAILED",
+        RESET);
+    printf("%s[ %s ]%s Valid Reverse Trie Dictionary Test\n",
+        (testReverse) ? GREEN : RED,
+        (testReverse) ? "PASSED" : "FAILED",
+        RESET);
+    printf("%s[ %s ]%s Dictionary Image Test\n",
+        (testImage) ? GREEN : RED,
+        (testImage) ? "PASSED" : "FAILED",
+        RESET);
     printf("All tests completed.\n");
     
     return 0;
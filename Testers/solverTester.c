@@ -13,6 +13,12 @@
 #include "../io.h"
 #include "../dataStruct.h"
 #include "../solver.h"
+#include "../moveGenerator.h"
+#include "../allocationCounter.h"
+#include "../solverContext.h"
+#include "../batch.h"
+#include "../server.h"
+#include "../gameState.h"
 #include <stdio.h>
 
 #define MAX_TOTAL_COMBINATIONS 150000 // Highest amount of total combinations possible with 7 pieces in the players Hand
@@ -21,30 +27,107 @@
 #define RED "\033[1;31m"
 #define RESET "\033[0m"
 
-void testSolver(char exampleLetters[], TrieNode *root);
+void testSolver(char exampleLetters[], const Dictionary *dictionary, const Dictionary *reverseDictionary);
 void strToLower(const char *src, char *dst);
 void validateCombinations(char exampleLetters[], char *combinations[MAX_TOTAL_COMBINATIONS], int totalCombinations);
 void printCombinations(char *combinations[MAX_TOTAL_COMBINATIONS], int totalCombinations);
 void testCombinationGenerator(char exampleLetters[]);
+void testPermutationIterator(char exampleLetters[], char *combinations[], unsigned int totalCombinations);
 void printFoundWords(char *foundWords[], int totalWordsFound);
 void printFoundMoves(Move foundMoves[], int totalMovesFound);
 void duplicateFinder(Move foundMoves[], int totalMovesFound);
+void validateSolver(Move foundMoves[], int totalMovesFound, char exampleLetters[], const char *testName);
 void checkValidPlacements(Square board[BOARD_SIZE][BOARD_SIZE]);
+void testCrossChecks(char exampleLetters[], const Dictionary *dictionary, Board *board, char *combinations[], int totalCombinations);
+bool sameMoves(const Move first[], int firstCount, const Move second[], int secondCount);
+int findMoveIndex(const Move moves[], int totalMoves, const Move *move);
+bool coversMoves(const Move moves[], int totalMoves, const Move part[], int partCount);
+void testGaddagThroughAnchor(const Dictionary *dictionary);
+int findMoveIndex(const Move moves[], int totalMoves, const Move *move)
+{
+    for (int i = 0; i < totalMoves; i++)
+    {
+        if (strcmp(moves[i].word, move->word) == 0 && moves[i].row == move->row && moves[i].col == move->col &&
+            moves[i].direction == move->direction)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+bool coversMoves(const Move moves[], int totalMoves, const Move part[], int partCount)
+{
+    for (int i = 0; i < partCount; i++)
+    {
+        int index = findMoveIndex(moves, totalMoves, &part[i]);
+        if (index < 0 || moves[index].score != part[i].score)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void testGaddagThroughAnchor(const Dictionary *dictionary)
+{
+    Board board;
+    Move anchorMoves[100];
+    Move gaddagMoves[100];
+    int anchorCount = 0;
+    int gaddagCount = 0;
+
+    // CAT needs its A between the C and the T, so it neither starts nor ends on the anchor
+    initBoard(&board);
+    setBoardTile(&board, CENTER, CENTER - 1, 'C');
+    setBoardTile(&board, CENTER, CENTER + 1, 'T');
+    Move cat = {CENTER, CENTER - 1, RIGHT, "CAT", 0};
+    calculateScore(&cat, board.squares, 1);
+
+    generateMoves(dictionary->trie, &board, "A", anchorMoves, &anchorCount, 100);
+    generateMovesWithGaddag(dictionary->gaddag, &board, "A", gaddagMoves, &gaddagCount, 100);
+    bool error = findMoveIndex(anchorMoves, anchorCount, &cat) >= 0 || !coversMoves(gaddagMoves, gaddagCount, &cat, 1);
+
+    printf("%s[ %s ]%s %s\n",
+           (!error) ? GREEN : RED,
+           (!error) ? "PASSED" : "FAILED",
+           RESET,
+           "GADDAG Through-Anchor Test");
+}
+
+void testTopMoves(char exampleLetters[], const Dictionary *dictionary, Board *board, const Move allMoves[], int totalMoves);
+void testSolveAllocations(char exampleLetters[], const Dictionary *dictionary, Board *board);
+void testAnytimeSearch(char exampleLetters[], const Dictionary *dictionary, Board *board, const Move allMoves[], int totalMoves);
+void testSolverContext(char exampleLetters[], const Dictionary *dictionary, Board *board);
+void testBatch(char exampleLetters[], const Dictionary *dictionary, Board *board, const char *boardFile);
+void testServer(char exampleLetters[], const Dictionary *dictionary, Board *board);
+void *runTestServer(void *server);
+int readReplies(int fd, char *reply, int size, int totalReplies);
+void testGameState(char exampleLetters[], const Dictionary *dictionary, Board *board);
+bool sameGameState(const GameState *first, const GameState *second);
+bool playGame(char exampleLetters[], const Dictionary *dictionary, Board *board, bool checkEveryRun);
+bool placedWalkedSquares(Square board[BOARD_SIZE][BOARD_SIZE], const GeneratedMove *generatedMove, const TilePlacement placements[], int totalPlacements);
+bool runsAreWords(Square board[BOARD_SIZE][BOARD_SIZE], const Dictionary *dictionary, const MoveUndo *undo);
 
 int main()
 {
     char testLetters1[] = {"ICKBEAM"}; 
     char testLetters2[] = {"ABSOLU"};  
     char testLetters3[] = {"ABCDEFG"}; 
-    TrieNode *root = loadDictionary("Testers/solverTests/dictionary.txt");
+    Dictionary *dictionary = loadDictionaryStructures("Testers/solverTests/dictionary.txt", DICTIONARY_TRIE | DICTIONARY_GADDAG | DICTIONARY_DAWG | DICTIONARY_COMPACT_TRIE);
+    Dictionary *reverseDictionary = loadDictionaryStructures("Testers/solverTests/dictionary.txt", DICTIONARY_TRIE | DICTIONARY_REVERSE_TRIE);
 
     testCombinationGenerator(testLetters1);
     testCombinationGenerator(testLetters2);
     testCombinationGenerator(testLetters3);
 
-    testSolver(testLetters1, root);
-    testSolver(testLetters2, root);
-    testSolver(testLetters3, root);
+    testSolver(testLetters1, dictionary, reverseDictionary);
+    testSolver(testLetters2, dictionary, reverseDictionary);
+    testSolver(testLetters3, dictionary, reverseDictionary);
+    testGaddagThroughAnchor(dictionary);
+
+    freeDictionary(dictionary);
+    freeDictionary(reverseDictionary);
 }
 
 void printCombinations(char *combinations[MAX_TOTAL_COMBINATIONS], int totalCombinations)
@@ -75,13 +158,69 @@ void testCombinationGenerator(char exampleLetters[])
 
     generateCombinations(exampleLetters, combinations, &totalCombinations);
     validateCombinations(exampleLetters, combinations, totalCombinations);
+    testPermutationIterator(exampleLetters, combinations, totalCombinations);
+
+    for (unsigned int i = 0; i < totalCombinations; i++)
+    {
+        free(combinations[i]);
+    }
+}
+
+void testPermutationIterator(char exampleLetters[], char *combinations[], unsigned int totalCombinations)
+{
+    static char chunk[97][MAX_COMBINATION_LENGTH + 1];
+    RackPermutations permutations;
+    RackPermutations resumed;
+    unsigned int position = 0;
+    unsigned int resumedAt = totalCombinations / 2;
+    bool error = false;
+
+    // Taken in chunks, the iterator must stream exactly the generated combinations
+    initRackPermutations(&permutations, exampleLetters);
+    int taken;
+    while ((taken = takeRackPermutations(&permutations, chunk, 97)) > 0)
+    {
+        for (int i = 0; i < taken; i++, position++)
+        {
+            if (position >= totalCombinations || strcmp(chunk[i], combinations[position]) != 0)
+            {
+                error = true;
+            }
+        }
+    }
+    error |= position != totalCombinations;
+    error |= nextRackPermutation(&permutations) != NULL;
+
+    // A copy of the iterator resumes where the original was
+    initRackPermutations(&permutations, exampleLetters);
+    for (position = 0; position < resumedAt; position++)
+    {
+        nextRackPermutation(&permutations);
+    }
+    resumed = permutations;
+    const char *permutation;
+    while ((permutation = nextRackPermutation(&resumed)) != NULL)
+    {
+        error |= position >= totalCombinations || strcmp(permutation, combinations[position++]) != 0;
+    }
+    error |= position != totalCombinations;
+
+    printf("%s[ %s ]%s %s: %s\n",
+           (!error) ? GREEN : RED,
+           (!error) ? "PASSED" : "FAILED",
+           RESET,
+           "Permutation Iterator Test",
+           exampleLetters);
 }
 
 void validateCombinations(char exampleLetters[], char *combinations[MAX_TOTAL_COMBINATIONS], int totalCombinations)
 {
     bool error = false;
     char filePath[256];
-    snprintf(filePath, sizeof(filePath), "Testers/solverTests/%s/%sCombinations.txt", exampleLetters, exampleLetters);
+    char lowerExampleLetters[BOARD_SIZE + 1];
+
+    strToLower(exampleLetters, lowerExampleLetters);
+    snprintf(filePath, sizeof(filePath), "Testers/solverTests/%s/%sCombinations.txt", lowerExampleLetters, lowerExampleLetters);
     FILE *file = fopen(filePath, "r");
     if (file == NULL)
     {
@@ -117,11 +256,14 @@ void validateCombinations(char exampleLetters[], char *combinations[MAX_TOTAL_CO
     fclose(file);
 }
 
-void validateSolver(Move foundMoves[], int totalMovesFound, char exampleLetters[])
+void validateSolver(Move foundMoves[], int totalMovesFound, char exampleLetters[], const char *testName)
 {
     bool error = false;
     char filePath[256];
-    snprintf(filePath, sizeof(filePath), "Testers/solverTests/%s/%sOutput.txt", exampleLetters, exampleLetters);
+    char lowerExampleLetters[BOARD_SIZE + 1];
+
+    strToLower(exampleLetters, lowerExampleLetters);
+    snprintf(filePath, sizeof(filePath), "Testers/solverTests/%s/%sOutput.txt", lowerExampleLetters, lowerExampleLetters);
     FILE *file = fopen(filePath, "r");
     if (file == NULL)
     {
@@ -153,17 +295,27 @@ void validateSolver(Move foundMoves[], int totalMovesFound, char exampleLetters[
             error = true;
         }
     }
-    printf("%s[ %s ]%s Valid Move Test: %s\n",
+
+    // Any move left in the file was not found
+    if (fgets(line, sizeof(line), file) != NULL && strncmp(line, "Row: ", 5) == 0 && strstr(line, "Direction:") != NULL)
+    {
+        printf("Expected more moves than the %i found\n", totalMovesFound);
+        error = true;
+    }
+
+    printf("%s[ %s ]%s %s: %s\n",
            (!error) ? GREEN : RED,
            (!error) ? "PASSED" : "FAILED",
            RESET,
+           testName,
            exampleLetters);
 
     fclose(file);
 }
 
-void testSolver(char exampleLetters[], TrieNode *root)
+void testSolver(char exampleLetters[], const Dictionary *dictionary, const Dictionary *reverseDictionary)
 {
+    TrieNode *root = dictionary->trie;
     char *combinations[MAX_TOTAL_COMBINATIONS];
     unsigned int totalCombinations = 0;
 
@@ -178,22 +330,128 @@ void testSolver(char exampleLetters[], TrieNode *root)
 
     int foundCount = 0;
 
-    Square board[BOARD_SIZE][BOARD_SIZE];
-    initBoard(board);
+    Board board;
+    initBoard(&board);
 
     char filePath[256];
-    char lowerExampleLetters[7];
+    char lowerExampleLetters[BOARD_SIZE + 1];
 
     strToLower(exampleLetters, lowerExampleLetters);
     snprintf(filePath, sizeof(filePath), "Testers/solverTests/%s/%sBoard.txt", lowerExampleLetters, lowerExampleLetters);
 
-    loadBoard(board, filePath);
+    loadBoard(&board, filePath);
+
+    findMoves(root, foundMoves, &foundCount, board.squares, combinations, totalCombinations);
+
+    validateSolver(foundMoves, foundCount, exampleLetters, "Valid Move Test");
+
+    // Walking UP/LEFT placements through the reverse Trie must not change them
+    foundCount = 0;
+    findMoves(reverseDictionary->trie, foundMoves, &foundCount, board.squares, combinations, totalCombinations);
+
+    validateSolver(foundMoves, foundCount, exampleLetters, "Reverse Trie Move Test");
+
+    // The anchor-based generator must find exactly the same moves
+    foundCount = 0;
+    generateMoves(root, &board, exampleLetters, foundMoves, &foundCount, 100000);
+
+    validateSolver(foundMoves, foundCount, exampleLetters, "Anchor Generator Test");
+
+    // The GADDAG walk also finds the words running through an anchor, so it
+    // finds every move above, once each, and more
+    Move *gaddagMoves = malloc(100000 * sizeof(Move));
+    int gaddagCount = 0;
+    if (gaddagMoves == NULL)
+    {
+        fprintf(stderr, "Memory allocation failed\n");
+        exit(1);
+    }
+    generateMovesWithGaddag(dictionary->gaddag, &board, exampleLetters, gaddagMoves, &gaddagCount, 100000);
+    bool gaddagError = !coversMoves(gaddagMoves, gaddagCount, foundMoves, foundCount);
+    int throughAnchor = 0;
+    for (int i = 0; i < gaddagCount; i++)
+    {
+        gaddagError |= findMoveIndex(gaddagMoves, i, &gaddagMoves[i]) >= 0;
+        throughAnchor += findMoveIndex(foundMoves, foundCount, &gaddagMoves[i]) < 0;
+    }
+
+    printf("%s[ %s ]%s %s: %s (%d moves, %d the anchor generator misses)\n",
+           (!gaddagError) ? GREEN : RED,
+           (!gaddagError) ? "PASSED" : "FAILED",
+           RESET,
+           "GADDAG Generator Test",
+           exampleLetters,
+           gaddagCount,
+           throughAnchor);
+
+    // And the anchor generator running on the DAWG instead of the Trie
+    Dictionary dawgOnly = {NULL, NULL, dictionary->dawg, NULL};
+    foundCount = 0;
+    generateMovesInDictionary(&dawgOnly, &board, exampleLetters, foundMoves, &foundCount, 100000);
+
+    validateSolver(foundMoves, foundCount, exampleLetters, "DAWG Generator Test");
 
-    findMoves(root, foundMoves, &foundCount, board, combinations, totalCombinations);
+    // And on the compact Trie
+    Dictionary compactOnly = {NULL, NULL, NULL, dictionary->compactTrie};
+    foundCount = 0;
+    generateMovesInDictionary(&compactOnly, &board, exampleLetters, foundMoves, &foundCount, 100000);
 
-    validateSolver(foundMoves, foundCount, exampleLetters);
+    validateSolver(foundMoves, foundCount, exampleLetters, "Compact Trie Generator Test");
 
+    // The solve entry points compute the cross-checks on a copy of the board,
+    // so given the unchecked board they must rank the legal moves only
+    Board checkedBoard;
+    Move *legalMoves = malloc(100000 * sizeof(Move));
+    int legalCount = 0;
+    if (legalMoves == NULL)
+    {
+        fprintf(stderr, "Memory allocation failed\n");
+        exit(1);
+    }
+    checkedBoard = board;
+    computeCrossChecks(checkedBoard.squares, dictionary);
+    generateMovesInDictionary(dictionary, &checkedBoard, exampleLetters, legalMoves, &legalCount, 100000);
+
+    testTopMoves(exampleLetters, dictionary, &board, legalMoves, legalCount);
+    testAnytimeSearch(exampleLetters, dictionary, &board, legalMoves, legalCount);
+    free(legalMoves);
+    testSolveAllocations(exampleLetters, dictionary, &board);
+    testSolverContext(exampleLetters, dictionary, &board);
+    testBatch(exampleLetters, dictionary, &board, filePath);
+    testServer(exampleLetters, dictionary, &board);
+    testGameState(exampleLetters, dictionary, &board);
+
+    // Sharing the anchors between threads must not change the moves or their order
+    MoveSink sink;
+    initMoveSink(&sink, MOVE_SINK_ALL);
+    generateMovesIntoSink(&dawgOnly, &board, exampleLetters, &sink, 3);
+    foundCount = copyMoveSink(&sink, foundMoves, 100000);
+    freeMoveSink(&sink);
+
+    validateSolver(foundMoves, foundCount, exampleLetters, "Parallel Generator Test");
+
+    // Nor with the GADDAG
+    initMoveSink(&sink, MOVE_SINK_ALL);
+    generateMovesIntoSink(dictionary, &board, exampleLetters, &sink, 3);
+    foundCount = copyMoveSink(&sink, foundMoves, 100000);
+    freeMoveSink(&sink);
+    gaddagError = !sameMoves(gaddagMoves, gaddagCount, foundMoves, foundCount);
+
+    printf("%s[ %s ]%s %s: %s\n",
+           (!gaddagError) ? GREEN : RED,
+           (!gaddagError) ? "PASSED" : "FAILED",
+           RESET,
+           "Parallel GADDAG Generator Test",
+           exampleLetters);
+
+    testCrossChecks(exampleLetters, dictionary, &board, combinations, totalCombinations);
+
+    free(gaddagMoves);
     free(foundMoves);
+    for (unsigned int i = 0; i < totalCombinations; i++)
+    {
+        free(combinations[i]);
+    }
 }
 
 void strToLower(const char *src, char *dst)
@@ -246,4 +504,770 @@ void checkValidPlacements(Square board[BOARD_SIZE][BOARD_SIZE])
             }
         }
     }
-}
\ No newline at end of file
+}
+void testCrossChecks(char exampleLetters[], const Dictionary *dictionary, Board *board, char *combinations[], int totalCombinations)
+{
+    Board checkedBoard;
+    Board gaddagBoard;
+    Dictionary gaddagOnly = {NULL, dictionary->gaddag, NULL, NULL};
+    bool error = false;
+
+    checkedBoard = *board;
+    gaddagBoard = *board;
+    computeCrossChecks(checkedBoard.squares, dictionary);
+    computeCrossChecks(gaddagBoard.squares, &gaddagOnly);
+
+    // Every mask must match a brute-force search of the perpendicular word
+    for (int row = 0; row < BOARD_SIZE; row++)
+    {
+        for (int col = 0; col < BOARD_SIZE; col++)
+        {
+            if (board->squares[row][col].letter != ' ')
+            {
+                continue;
+            }
+            for (int orientation = 0; orientation < 2; orientation++)
+            {
+                int rowStep = orientation == 0 ? 0 : 1;
+                int colStep = orientation == 0 ? 1 : 0;
+                int startRow = row;
+                int startCol = col;
+                while (startRow - rowStep >= 0 && startCol - colStep >= 0 && board->squares[startRow - rowStep][startCol - colStep].letter != ' ')
+                {
+                    startRow -= rowStep;
+                    startCol -= colStep;
+                }
+
+                uint32_t expected = 0;
+                for (int letter = 0; letter < MAX_CHARACTERS; letter++)
+                {
+                    char word[BOARD_SIZE + 1];
+                    int length = 0;
+                    int r = startRow;
+                    int c = startCol;
+                    while (r < BOARD_SIZE && c < BOARD_SIZE && (board->squares[r][c].letter != ' ' || (r == row && c == col)))
+                    {
+                        word[length++] = (r == row && c == col) ? 'A' + letter : board->squares[r][c].letter;
+                        r += rowStep;
+                        c += colStep;
+                    }
+                    word[length] = '\0';
+                    if (length == 1 || searchWord(dictionary->trie, word))
+                    {
+                        expected |= 1u << letter;
+                    }
+                }
+
+                if (checkedBoard.squares[row][col].crossCheck[orientation] != expected || gaddagBoard.squares[row][col].crossCheck[orientation] != expected)
+                {
+                    printf("Cross-check mismatch at row %d col %d orientation %d\n", row, col, orientation);
+                    error = true;
+                }
+            }
+        }
+    }
+
+    printf("%s[ %s ]%s %s: %s\n",
+           (!error) ? GREEN : RED,
+           (!error) ? "PASSED" : "FAILED",
+           RESET,
+           "Cross-Check Mask Test",
+           exampleLetters);
+
+    // With the masks in place every generator must still agree, and only drop moves
+    Move *uncheckedMoves = malloc(100000 * sizeof(Move));
+    Move *checkedMoves = malloc(100000 * sizeof(Move));
+    Move *generatedMoves = malloc(100000 * sizeof(Move));
+    if (uncheckedMoves == NULL || checkedMoves == NULL || generatedMoves == NULL)
+    {
+        fprintf(stderr, "Memory allocation failed\n");
+        exit(1);
+    }
+    int uncheckedCount = 0;
+    int checkedCount = 0;
+    int generatedCount = 0;
+
+    error = false;
+    findMoves(dictionary->trie, uncheckedMoves, &uncheckedCount, board->squares, combinations, totalCombinations);
+    findMoves(dictionary->trie, checkedMoves, &checkedCount, checkedBoard.squares, combinations, totalCombinations);
+
+    generateMoves(dictionary->trie, &checkedBoard, exampleLetters, generatedMoves, &generatedCount, 100000);
+    error |= !sameMoves(checkedMoves, checkedCount, generatedMoves, generatedCount);
+
+    Dictionary dawgOnly = {NULL, NULL, dictionary->dawg, NULL};
+    generatedCount = 0;
+    generateMovesInDictionary(&dawgOnly, &checkedBoard, exampleLetters, generatedMoves, &generatedCount, 100000);
+    error |= !sameMoves(checkedMoves, checkedCount, generatedMoves, generatedCount);
+
+    generatedCount = 0;
+    generateMovesWithGaddag(dictionary->gaddag, &checkedBoard, exampleLetters, generatedMoves, &generatedCount, 100000);
+    error |= !coversMoves(generatedMoves, generatedCount, checkedMoves, checkedCount);
+
+    // Legal moves keep their placement; their score only gains the perpendicular words
+    int next = 0;
+    for (int i = 0; i < uncheckedCount && next < checkedCount; i++)
+    {
+        Move placement = checkedMoves[next];
+        placement.score = uncheckedMoves[i].score;
+        if (sameMoves(&uncheckedMoves[i], 1, &placement, 1))
+        {
+            error |= checkedMoves[next].score < uncheckedMoves[i].score;
+            next++;
+        }
+    }
+    error |= next != checkedCount;
+
+    printf("%s[ %s ]%s %s: %s (%d of %d moves legal)\n",
+           (!error) ? GREEN : RED,
+           (!error) ? "PASSED" : "FAILED",
+           RESET,
+           "Cross-Check Generator Test",
+           exampleLetters,
+           checkedCount,
+           uncheckedCount);
+
+    free(uncheckedMoves);
+    free(checkedMoves);
+    free(generatedMoves);
+}
+
+bool sameMoves(const Move first[], int firstCount, const Move second[], int secondCount)
+{
+    if (firstCount != secondCount)
+    {
+        return false;
+    }
+    for (int i = 0; i < firstCount; i++)
+    {
+        if (strcmp(first[i].word, second[i].word) != 0 || first[i].row != second[i].row || first[i].col != second[i].col ||
+            first[i].direction != second[i].direction || first[i].score != second[i].score)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void testTopMoves(char exampleLetters[], const Dictionary *dictionary, Board *board, const Move allMoves[], int totalMoves)
+{
+    bool error = false;
+
+    // Expected ranking: score descending, ties in the order the moves were found
+    Move *ranked = malloc((totalMoves + 1) * sizeof(Move));
+    Move *topMoves = malloc((totalMoves + 5) * sizeof(Move));
+    if (ranked == NULL || topMoves == NULL)
+    {
+        fprintf(stderr, "Memory allocation failed\n");
+        exit(1);
+    }
+    for (int i = 0; i < totalMoves; i++)
+    {
+        int j = i;
+        while (j > 0 && ranked[j - 1].score < allMoves[i].score)
+        {
+            ranked[j] = ranked[j - 1];
+            j--;
+        }
+        ranked[j] = allMoves[i];
+    }
+
+    // Every thread count must rank the same moves
+    int limits[] = {1, 10, totalMoves + 5};
+    int threadCounts[] = {1, 4};
+    for (int t = 0; t < 2; t++)
+    {
+        for (int i = 0; i < 3; i++)
+        {
+            int expected = limits[i] < totalMoves ? limits[i] : totalMoves;
+            int found = findTopMoves(dictionary, board, exampleLetters, topMoves, limits[i], threadCounts[t]);
+            if (!sameMoves(ranked, expected, topMoves, found))
+            {
+                printf("Top %d moves on %d threads differ from the ranked move list\n", limits[i], threadCounts[t]);
+                error = true;
+            }
+        }
+    }
+
+    Move bestMove = findBestMoveInDictionary(dictionary, board, exampleLetters);
+    Move expectedBest = pickBestMove((Move *)allMoves, totalMoves);
+    error |= !sameMoves(&expectedBest, 1, &bestMove, 1);
+
+    printf("%s[ %s ]%s %s: %s\n",
+           (!error) ? GREEN : RED,
+           (!error) ? "PASSED" : "FAILED",
+           RESET,
+           "Top-K Move Test",
+           exampleLetters);
+
+    free(ranked);
+    free(topMoves);
+}
+
+void testAnytimeSearch(char exampleLetters[], const Dictionary *dictionary, Board *board, const Move allMoves[], int totalMoves)
+{
+    Move expected[10];
+    Move topMoves[10];
+    bool complete;
+    bool error = false;
+
+    int expectedCount = findTopMoves(dictionary, board, exampleLetters, expected, 10, 1);
+
+    int threadCounts[] = {1, 3};
+    for (int t = 0; t < 2; t++)
+    {
+        // A budget the search never reaches must not change the result
+        SearchBudget generous = {60.0, 1000000000L};
+        int found = findTopMovesWithin(dictionary, board, exampleLetters, topMoves, 10, threadCounts[t], generous, &complete);
+        error |= !complete || !sameMoves(expected, expectedCount, topMoves, found);
+
+        // A deadline that has passed before the first anchor leaves nothing searched
+        SearchBudget expired = {1e-9, 0};
+        found = findTopMovesWithin(dictionary, board, exampleLetters, topMoves, 10, threadCounts[t], expired, &complete);
+        error |= complete || found != 0;
+
+        // A search stopped by a tiny move budget still returns real moves, no better than the best
+        SearchBudget tiny = {0, 1};
+        found = findTopMovesWithin(dictionary, board, exampleLetters, topMoves, 10, threadCounts[t], tiny, &complete);
+        if (complete)
+        {
+            error |= !sameMoves(expected, expectedCount, topMoves, found);
+        }
+        for (int i = 0; i < found; i++)
+        {
+            bool known = false;
+            for (int j = 0; j < totalMoves && !known; j++)
+            {
+                known = sameMoves(&allMoves[j], 1, &topMoves[i], 1);
+            }
+            error |= !known || (expectedCount > 0 && topMoves[i].score > expected[0].score);
+            error |= i > 0 && topMoves[i].score > topMoves[i - 1].score;
+        }
+    }
+
+    // The best-move variant reports the same flag
+    Move bestMove = findBestMoveWithin(dictionary, board, exampleLetters, SEARCH_EXHAUSTIVE, &complete);
+    error |= !complete || (expectedCount > 0 && !sameMoves(expected, 1, &bestMove, 1));
+
+    printf("%s[ %s ]%s %s: %s\n",
+           (!error) ? GREEN : RED,
+           (!error) ? "PASSED" : "FAILED",
+           RESET,
+           "Anytime Search Test",
+           exampleLetters);
+}
+
+void testSolveAllocations(char exampleLetters[], const Dictionary *dictionary, Board *board)
+{
+    Move topMoves[TOP_MOVES_ON_STACK];
+
+    if (!allocationCountingEnabled())
+    {
+        printf("Zero Allocation Test skipped: built without allocation counting\n");
+        return;
+    }
+
+    // Once the dictionary is loaded, a solve on one thread must not allocate,
+    // cross-checks of the unchecked board included
+    resetAllocationCounts();
+    findBestMoveInDictionary(dictionary, board, exampleLetters);
+    findBestMove(dictionary->trie, board, exampleLetters);
+    findTopMoves(dictionary, board, exampleLetters, topMoves, TOP_MOVES_ON_STACK, 1);
+    AllocationCounts counts = allocationCounts();
+    bool error = counts.allocations != 0;
+
+    if (error)
+    {
+        printf("Solving allocated %ld times (%ld bytes)\n", counts.allocations, counts.bytes);
+    }
+
+    printf("%s[ %s ]%s %s: %s\n",
+           (!error) ? GREEN : RED,
+           (!error) ? "PASSED" : "FAILED",
+           RESET,
+           "Zero Allocation Test",
+           exampleLetters);
+}
+
+void testSolverContext(char exampleLetters[], const Dictionary *dictionary, Board *board)
+{
+    Board original;
+    Move expected[10];
+    Move topMoves[10];
+    bool error = false;
+
+    original = *board;
+    int expectedCount = findTopMoves(dictionary, board, exampleLetters, expected, 10, 1);
+
+    // Repeated solves on one and several threads must match findTopMoves and leave the board alone
+    int threadCounts[] = {1, 3};
+    for (int t = 0; t < 2; t++)
+    {
+        SolverContext *context = createSolverContextForDictionary(dictionary, threadCounts[t]);
+        for (int solve = 0; solve < 3; solve++)
+        {
+            resetAllocationCounts();
+            int found = solveTopMoves(context, board, exampleLetters, topMoves, 10);
+            AllocationCounts counts = allocationCounts();
+            if (!sameMoves(expected, expectedCount, topMoves, found))
+            {
+                printf("Solve %d on %d threads differs from findTopMoves\n", solve, threadCounts[t]);
+                error = true;
+            }
+            if (solve > 0 && counts.allocations != 0)
+            {
+                printf("Solve %d on %d threads allocated %ld times\n", solve, threadCounts[t], counts.allocations);
+                error = true;
+            }
+        }
+        Move bestMove = solveBestMove(context, board, exampleLetters);
+        if (expectedCount > 0)
+        {
+            error |= !sameMoves(expected, 1, &bestMove, 1);
+        }
+        freeSolverContext(context);
+    }
+    error |= memcmp(&original, board, sizeof(original)) != 0;
+
+    printf("%s[ %s ]%s %s: %s\n",
+           (!error) ? GREEN : RED,
+           (!error) ? "PASSED" : "FAILED",
+           RESET,
+           "Solver Context Test",
+           exampleLetters);
+}
+
+void testBatch(char exampleLetters[], const Dictionary *dictionary, Board *board, const char *boardFile)
+{
+    static const char *directionNames[4] = {"UP", "DOWN", "LEFT", "RIGHT"};
+    Move expected[5];
+    char lowerLetters[BOARD_SIZE + 1];
+    bool error = false;
+
+    int expectedCount = findTopMoves(dictionary, board, exampleLetters, expected, 5, 1);
+    strToLower(exampleLetters, lowerLetters);
+
+    // The same position as a board file and in the compact form, then a board that is not connected
+    FILE *jobs = tmpfile();
+    FILE *boardRows = fopen(boardFile, "r");
+    if (jobs == NULL || boardRows == NULL)
+    {
+        fprintf(stderr, "Failed to set up the batch test\n");
+        exit(1);
+    }
+    fprintf(jobs, "# batch test\n%s\n", lowerLetters);
+    int character;
+    while ((character = fgetc(boardRows)) != EOF)
+    {
+        fputc(character, jobs);
+    }
+    fclose(boardRows);
+    fprintf(jobs, "\n%s ", exampleLetters);
+    for (int row = 0; row < BOARD_SIZE; row++)
+    {
+        for (int col = 0; col < BOARD_SIZE; col++)
+        {
+            fputc(board->squares[row][col].letter == ' ' ? '_' : board->squares[row][col].letter, jobs);
+        }
+    }
+    fprintf(jobs, "\n%s ", exampleLetters);
+    for (int i = 0; i < BOARD_SQUARES; i++)
+    {
+        fputc(i == CENTER * BOARD_SIZE + CENTER || i == 0 ? 'A' : '_', jobs);
+    }
+    fputc('\n', jobs);
+
+    int threadCounts[] = {1, 3};
+    for (int t = 0; t < 2; t++)
+    {
+        FILE *output = tmpfile();
+        BatchStats stats;
+        rewind(jobs);
+        error |= !runBatch(dictionary, jobs, output, threadCounts[t], 5, SEARCH_EXHAUSTIVE, &stats);
+        error |= stats.jobs != 3 || stats.failedJobs != 1 || stats.partialJobs != 0;
+
+        // Each position must list the findTopMoves moves, best first, then the error
+        char line[256];
+        int lines = 0;
+        rewind(output);
+        while (fgets(line, sizeof(line), output) != NULL)
+        {
+            long job;
+            int rank, score, row, col;
+            char word[BOARD_SIZE + 1], direction[8];
+            int fields = sscanf(line, "%ld\t%d\t%d\t%15s\t%d\t%d\t%7s", &job, &rank, &score, word, &row, &col, direction);
+            int expectedJob = lines < 2 * expectedCount ? lines / expectedCount + 1 : 3;
+            if (lines >= 2 * expectedCount)
+            {
+                error |= expectedCount == 0 ? job != lines + 1 : job != 3;
+                error |= rank != 0 || strstr(line, expectedCount == 0 && lines < 2 ? "none" : "error") == NULL;
+            }
+            else
+            {
+                const Move *move = &expected[lines % expectedCount];
+                error |= fields != 7 || job != expectedJob || rank != lines % expectedCount + 1;
+                error |= score != move->score || strcmp(word, move->word) != 0 || row != move->row + 1 || col != move->col + 1;
+                error |= strcmp(direction, directionNames[move->direction & 3]) != 0;
+
+                // The word reads down or right from its first square and agrees with the tiles it covers
+                bool down = strcmp(direction, "DOWN") == 0;
+                error |= !down && strcmp(direction, "RIGHT") != 0;
+                for (int i = 0; word[i] != '\0' && !error; i++)
+                {
+                    int wordRow = row - 1 + (down ? i : 0);
+                    int wordCol = col - 1 + (down ? 0 : i);
+                    error |= wordRow < 0 || wordRow >= BOARD_SIZE || wordCol < 0 || wordCol >= BOARD_SIZE;
+                    error |= !error && board->squares[wordRow][wordCol].letter != ' ' && board->squares[wordRow][wordCol].letter != word[i];
+                }
+            }
+            lines++;
+        }
+        error |= lines != (expectedCount == 0 ? 3 : 2 * expectedCount + 1);
+        fclose(output);
+    }
+    fclose(jobs);
+
+    printf("%s[ %s ]%s %s: %s\n",
+           (!error) ? GREEN : RED,
+           (!error) ? "PASSED" : "FAILED",
+           RESET,
+           "Batch Test",
+           exampleLetters);
+}
+
+void *runTestServer(void *server)
+{
+    runServer((Server *)server);
+    return NULL;
+}
+
+int readReplies(int fd, char *reply, int size, int totalReplies)
+{
+    int used = 0;
+    int replies = 0;
+
+    // Every reply ends with an empty line
+    while (replies < totalReplies && used < size - 1)
+    {
+        ssize_t received = recv(fd, reply + used, size - 1 - used, 0);
+        if (received <= 0)
+        {
+            break;
+        }
+        used += received;
+        reply[used] = '\0';
+        replies = 0;
+        for (char *end = strstr(reply, "\n\n"); end != NULL; end = strstr(end + 2, "\n\n"))
+        {
+            replies++;
+        }
+    }
+    reply[used] = '\0';
+    return used;
+}
+
+void testServer(char exampleLetters[], const Dictionary *dictionary, Board *board)
+{
+    static char expected[4096];
+    static char reply[4096];
+    char request[3 * (BOARD_SQUARES + BOARD_SIZE + 2) + 8];
+    char squares[BOARD_SQUARES + 1];
+    char socketPath[64];
+    Move topMoves[5];
+    bool error = false;
+
+    for (int i = 0; i < BOARD_SQUARES; i++)
+    {
+        char letter = board->squares[i / BOARD_SIZE][i % BOARD_SIZE].letter;
+        squares[i] = letter == ' ' ? '_' : letter;
+    }
+    squares[BOARD_SQUARES] = '\0';
+    int totalMoves = findTopMoves(dictionary, board, exampleLetters, topMoves, 5, 1);
+
+    // A job, a request without a board and the job again, sent together on one connection
+    snprintf(request, sizeof(request), "%s %s\n%s\r\n%s %s\n", exampleLetters, squares, exampleLetters, exampleLetters, squares);
+    size_t length = formatJobResult(expected, sizeof(expected), 1, exampleLetters, NULL, topMoves, totalMoves, true);
+    length += snprintf(expected + length, sizeof(expected) - length, "\n2\t0\terror\trequest must hold the rack and 225 squares\n\n");
+    length += formatJobResult(expected + length, sizeof(expected) - length, 3, exampleLetters, NULL, topMoves, totalMoves, true);
+    strcpy(expected + length, "\n");
+
+    snprintf(socketPath, sizeof(socketPath), "/tmp/solverTester%d.sock", (int)getpid());
+    Server *server = createServer(dictionary, socketPath, 2, 5, SEARCH_EXHAUSTIVE);
+    if (server == NULL)
+    {
+        fprintf(stderr, "Failed to start the test server\n");
+        exit(1);
+    }
+    pthread_t serverThread;
+    pthread_create(&serverThread, NULL, runTestServer, server);
+
+    // Three clients at once must each get their replies in request order
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, socketPath);
+    int clients[3];
+    for (int i = 0; i < 3; i++)
+    {
+        clients[i] = socket(AF_UNIX, SOCK_STREAM, 0);
+        error |= connect(clients[i], (struct sockaddr *)&address, sizeof(address)) != 0;
+        error |= send(clients[i], request, strlen(request), MSG_NOSIGNAL) != (ssize_t)strlen(request);
+    }
+    for (int i = 0; i < 3; i++)
+    {
+        readReplies(clients[i], reply, sizeof(reply), 3);
+        if (strcmp(reply, expected) != 0)
+        {
+            printf("Client %d got:\n%s", i, reply);
+            error = true;
+        }
+    }
+
+    // Nine requests, three of them failed, were answered before the counters were asked for
+    long requests = 0;
+    long failedRequests = 0;
+    send(clients[0], "STATS\n", 6, MSG_NOSIGNAL);
+    readReplies(clients[0], reply, sizeof(reply), 1);
+    error |= sscanf(reply, "requests=%ld\tfailed=%ld", &requests, &failedRequests) != 2;
+    error |= requests != 9 || failedRequests != 3;
+
+    for (int i = 0; i < 3; i++)
+    {
+        close(clients[i]);
+    }
+    stopServer(server);
+    pthread_join(serverThread, NULL);
+    freeServer(server);
+    error |= access(socketPath, F_OK) == 0;
+
+    printf("%s[ %s ]%s %s: %s\n",
+           (!error) ? GREEN : RED,
+           (!error) ? "PASSED" : "FAILED",
+           RESET,
+           "Server Test",
+           exampleLetters);
+}
+
+bool sameGameState(const GameState *first, const GameState *second)
+{
+    if (memcmp(&first->board.occupied, &second->board.occupied, sizeof(BoardBits)) != 0 ||
+        memcmp(&first->anchors, &second->anchors, sizeof(BoardBits)) != 0)
+    {
+        return false;
+    }
+    for (int row = 0; row < BOARD_SIZE; row++)
+    {
+        for (int col = 0; col < BOARD_SIZE; col++)
+        {
+            const Square *a = &first->board.squares[row][col];
+            const Square *b = &second->board.squares[row][col];
+            if (a->letter != b->letter || a->bonus != b->bonus ||
+                a->validPlacement != b->validPlacement || a->usedBonus != b->usedBonus ||
+                a->crossCheck[0] != b->crossCheck[0] || a->crossCheck[1] != b->crossCheck[1] ||
+                a->crossScore[0] != b->crossScore[0] || a->crossScore[1] != b->crossScore[1])
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void testGameState(char exampleLetters[], const Dictionary *dictionary, Board *board)
+{
+    static GameState state;
+    static GameState start;
+    static MoveUndo undo;
+    Board emptyBoard;
+    bool error = false;
+
+    // The test boards hold runs that are not words (QU, TER), so only the
+    // words through the new tiles are checked there; a game played from an
+    // empty board must keep every run a word
+    error |= !playGame(exampleLetters, dictionary, board, false);
+    initBoard(&emptyBoard);
+    error |= !playGame(exampleLetters, dictionary, &emptyBoard, true);
+
+    // A move that does not fit the board is refused without a change
+    initGameState(&state, dictionary, board);
+    start = state;
+    Move offBoard = {0, BOARD_SIZE - 2, RIGHT, "ABC", 0};
+    error |= applyMove(&state, &offBoard, &undo) || !sameGameState(&state, &start);
+
+    printf("%s[ %s ]%s %s: %s\n",
+           (!error) ? GREEN : RED,
+           (!error) ? "PASSED" : "FAILED",
+           RESET,
+           "Game State Test",
+           exampleLetters);
+}
+
+bool playGame(char exampleLetters[], const Dictionary *dictionary, Board *board, bool checkEveryRun)
+{
+    static GameState state;
+    static GameState start;
+    static GameState rebuilt;
+    static MoveUndo undo[4];
+    static TilePlacement placements[BOARD_SIZE];
+    int turns = 0;
+    bool error = false;
+
+    initGameState(&state, dictionary, board);
+    start = state;
+
+    for (int turn = 0; turn < 4; turn++)
+    {
+        // Every move must lie on the squares the generator walked for it
+        MoveSink allMoves;
+        initMoveSink(&allMoves, MOVE_SINK_ALL);
+        generateMovesIntoSink(dictionary, &state.board, exampleLetters, &allMoves, 1);
+        for (int i = 0; i < allMoves.totalMoves; i++)
+        {
+            int totalPlacements = findMovePlacements(state.board.squares, &allMoves.moves[i].move, placements);
+            error |= !placedWalkedSquares(state.board.squares, &allMoves.moves[i], placements, totalPlacements);
+        }
+        freeMoveSink(&allMoves);
+
+        // The best move must be played, on the walked squares, forming only words
+        GeneratedMove best;
+        MoveSink bestMove;
+        initMoveSinkInBuffer(&bestMove, 1, &best, 1);
+        generateMovesIntoSink(dictionary, &state.board, exampleLetters, &bestMove, 1);
+        if (bestMove.totalMoves == 0)
+        {
+            break;
+        }
+        int totalPlacements = findMovePlacements(state.board.squares, &best.move, placements);
+        error |= !placedWalkedSquares(state.board.squares, &best, placements, totalPlacements);
+        if (!applyMove(&state, &best.move, &undo[turns]))
+        {
+            error = true;
+            break;
+        }
+        error |= undo[turns].totalPlacements != totalPlacements;
+        for (int i = 0; i < undo[turns].totalPlacements; i++)
+        {
+            const TilePlacement *placement = &undo[turns].placements[i];
+            error |= state.board.squares[placement->row][placement->col].letter != placement->letter;
+        }
+        error |= !runsAreWords(state.board.squares, dictionary, checkEveryRun ? NULL : &undo[turns]);
+        turns++;
+
+        // The state updated around the move must be what a full rebuild of the new board gives
+        Board fresh;
+        char letters[BOARD_SQUARES];
+        for (int row = 0; row < BOARD_SIZE; row++)
+        {
+            for (int col = 0; col < BOARD_SIZE; col++)
+            {
+                char letter = state.board.squares[row][col].letter;
+                letters[row * BOARD_SIZE + col] = letter == ' ' ? '_' : letter;
+            }
+        }
+        initBoard(&fresh);
+        setBoardLetters(&fresh, letters);
+        initGameState(&rebuilt, dictionary, &fresh);
+        error |= !sameGameState(&state, &rebuilt);
+    }
+    error |= turns == 0;
+
+    // Undone in reverse, the moves must leave the starting state
+    while (turns > 0)
+    {
+        undoMove(&state, &undo[--turns]);
+    }
+    error |= !sameGameState(&state, &start);
+    return !error;
+}
+
+bool placedWalkedSquares(Square board[BOARD_SIZE][BOARD_SIZE], const GeneratedMove *generatedMove, const TilePlacement placements[], int totalPlacements)
+{
+    static const int rowStep[4] = {-1, 1, 0, 0};
+    static const int colStep[4] = {0, 0, -1, 1};
+    const Move *move = &generatedMove->move;
+    int direction = generatedMove->origin % 4;
+    int anchorRow = generatedMove->origin / 4 % BOARD_SIZE;
+    int anchorCol = generatedMove->origin / 4 / BOARD_SIZE;
+    int length = (int)strlen(move->word);
+    int tile = 0;
+
+    if (totalPlacements != (int)strlen(generatedMove->tiles))
+    {
+        return false;
+    }
+
+    // The generator lays its tiles on the empty squares of the word from the anchor on, in its
+    // search direction; the GADDAG then goes on with the squares after the anchor
+    for (int pass = 0; pass < 2; pass++)
+    {
+        int row = anchorRow + (pass == 0 ? 0 : -rowStep[direction]);
+        int col = anchorCol + (pass == 0 ? 0 : -colStep[direction]);
+        int side = pass == 0 ? direction : direction ^ 1;
+        for (;; row += rowStep[side], col += colStep[side])
+        {
+            int offset = row - move->row + col - move->col;
+            if (row < move->row || col < move->col || offset >= length || (move->direction == DOWN ? col != move->col : row != move->row))
+            {
+                break; // Off the word
+            }
+            if (board[row][col].letter != ' ')
+            {
+                continue;
+            }
+
+            bool placed = false;
+            for (int i = 0; i < totalPlacements; i++)
+            {
+                placed |= placements[i].row == row && placements[i].col == col && placements[i].letter == generatedMove->tiles[tile];
+            }
+            if (!placed)
+            {
+                return false;
+            }
+            tile++;
+        }
+    }
+    return tile == totalPlacements;
+}
+
+bool runsAreWords(Square board[BOARD_SIZE][BOARD_SIZE], const Dictionary *dictionary, const MoveUndo *undo)
+{
+    bool placed[BOARD_SIZE][BOARD_SIZE] = {{false}};
+
+    for (int i = 0; undo != NULL && i < undo->totalPlacements; i++)
+    {
+        placed[undo->placements[i].row][undo->placements[i].col] = true;
+    }
+
+    // Read every run of tiles along the rows, then along the columns
+    for (int orientation = 0; orientation < 2; orientation++)
+    {
+        for (int line = 0; line < BOARD_SIZE; line++)
+        {
+            char word[BOARD_SIZE + 1];
+            int length = 0;
+            bool hasNewTile = undo == NULL;
+
+            for (int i = 0; i <= BOARD_SIZE; i++)
+            {
+                int row = orientation == 0 ? line : i;
+                int col = orientation == 0 ? i : line;
+                if (i < BOARD_SIZE && board[row][col].letter != ' ')
+                {
+                    word[length++] = board[row][col].letter;
+                    hasNewTile |= placed[row][col];
+                    continue;
+                }
+
+                word[length] = '\0';
+                if (length >= 2 && hasNewTile && !dictionarySearchWord(dictionary, word))
+                {
+                    printf("Game State Test: %s is not a word\n", word);
+                    return false;
+                }
+                length = 0;
+                hasNewTile = undo == NULL;
+            }
+        }
+    }
+    return true;
+}
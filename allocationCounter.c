@@ -0,0 +1,115 @@
+/*---------- ID HEADER -------------------------------------
+/   Author(s):    Aidan Andrews, Kyle Scidmore
+/   File Name:    allocationCounter.c
+/
+/   File Description:
+/     This file implements the allocation counter. With COUNT_ALLOCATIONS
+/     defined the program is linked with --wrap for malloc, calloc and
+/     realloc, so calls to them from the solver's own code land in the
+/     __wrap_ functions below, which count the call and pass it on to the
+/     C library. Allocations the C library makes internally are not seen.
+/
+/---------------------------------------------------------*/
+#include "allocationCounter.h"
+
+static long totalAllocations = 0;
+static long totalBytes = 0;
+
+#ifdef COUNT_ALLOCATIONS
+
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *pointer, size_t size);
+void *__wrap_malloc(size_t size);
+void *__wrap_calloc(size_t count, size_t size);
+void *__wrap_realloc(void *pointer, size_t size);
+
+/*---------- FUNCTION: countAllocation -----------------------------------
+/   Function Description:
+/     Counts one allocation.
+/   Caller Input:
+/     - size_t size: Bytes asked for.
+/   Caller Output:
+/     - void: No return value.
+/   Assumptions, Limitations, Known Bugs:
+/     - Safe to call from several threads.
+/---------------------------------------------------------*/
+static void countAllocation(size_t size)
+{
+    __atomic_fetch_add(&totalAllocations, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&totalBytes, (long)size, __ATOMIC_RELAXED);
+}
+
+void *__wrap_malloc(size_t size)
+{
+    countAllocation(size);
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t count, size_t size)
+{
+    countAllocation(count * size);
+    return __real_calloc(count, size);
+}
+
+void *__wrap_realloc(void *pointer, size_t size)
+{
+    countAllocation(size);
+    return __real_realloc(pointer, size);
+}
+
+#endif
+
+/*---------- FUNCTION: allocationCountingEnabled -----------------------------------
+/   Function Description:
+/     Checks if the program was built with allocation counting.
+/   Caller Input:
+/     - None.
+/   Caller Output:
+/     - bool: True if allocations are counted.
+/   Assumptions, Limitations, Known Bugs:
+/     - N/A
+/---------------------------------------------------------*/
+bool allocationCountingEnabled(void)
+{
+#ifdef COUNT_ALLOCATIONS
+    return true;
+#else
+    return false;
+#endif
+}
+
+/*---------- FUNCTION: resetAllocationCounts -----------------------------------
+/   Function Description:
+/     Sets the allocation counts back to zero, typically before a solve.
+/   Caller Input:
+/     - None.
+/   Caller Output:
+/     - void: No return value.
+/   Assumptions, Limitations, Known Bugs:
+/     - Allocations made by other threads while resetting may be lost.
+/---------------------------------------------------------*/
+void resetAllocationCounts(void)
+{
+    __atomic_store_n(&totalAllocations, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&totalBytes, 0, __ATOMIC_RELAXED);
+}
+
+/*---------- FUNCTION: allocationCounts -----------------------------------
+/   Function Description:
+/     Returns the allocations counted since the last reset.
+/   Caller Input:
+/     - None.
+/   Caller Output:
+/     - AllocationCounts: Number of allocations and bytes asked for.
+/   Assumptions, Limitations, Known Bugs:
+/     - Always zero without COUNT_ALLOCATIONS.
+/---------------------------------------------------------*/
+AllocationCounts allocationCounts(void)
+{
+    AllocationCounts counts;
+
+    counts.allocations = __atomic_load_n(&totalAllocations, __ATOMIC_RELAXED);
+    counts.bytes = __atomic_load_n(&totalBytes, __ATOMIC_RELAXED);
+    return counts;
+}
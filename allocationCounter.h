@@ -0,0 +1,31 @@
+/*---------- ID HEADER -------------------------------------
+/   Author(s):    Aidan Andrews, Kyle Scidmore
+/   File Name:    allocationCounter.h
+/
+/   File Description:
+/     This header file declares the allocation counter, a debug aid that
+/     counts every malloc, calloc and realloc made by the solver and the
+/     bytes they ask for. In the testers and the debug build of main (see
+/     the makefile) the linker routes those calls through counting
+/     wrappers; otherwise the counts stay zero.
+/
+/---------------------------------------------------------*/
+#ifndef ALLOCATIONCOUNTER_H
+#define ALLOCATIONCOUNTER_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+// Allocations counted since the last reset
+typedef struct AllocationCounts {
+    long allocations; // Calls to malloc, calloc and realloc.
+    long bytes;       // Bytes those calls asked for.
+} AllocationCounts;
+
+// Function prototypes
+bool allocationCountingEnabled(void);
+void resetAllocationCounts(void);
+AllocationCounts allocationCounts(void);
+
+#endif
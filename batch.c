@@ -0,0 +1,485 @@
+/*---------- ID HEADER -------------------------------------
+/   Author(s):    Aidan Andrews, Kyle Scidmore
+/   File Name:    batch.c
+/
+/   File Description:
+/     This file implements the batch solver. The calling thread reads jobs
+/     into a ring of BATCH_QUEUE_JOBS slots and writes finished slots out in
+/     input order; worker threads take the next unsolved slot, solve it with
+/     their own SolverContext and mark it done. The ring bounds memory and
+/     keeps the output order independent of which worker finishes first.
+/
+/---------------------------------------------------------*/
+#include "batch.h"
+#include "io.h"
+
+#define BATCH_LINE_LENGTH 512
+
+// One job and, once solved, its result
+typedef struct BatchJob
+{
+    char rack[BOARD_SIZE + 1];
+    char letters[BOARD_SQUARES]; // Board squares, row by row, '_' for empty.
+    const char *error;           // Why the job cannot be solved, NULL if it can.
+    Move *moves;                 // Best moves, best first.
+    int totalMoves;
+    bool complete;               // False if the search stopped at the budget.
+    bool done;
+} BatchJob;
+
+// Ring of jobs shared by the reader and the workers
+typedef struct BatchQueue
+{
+    BatchJob jobs[BATCH_QUEUE_JOBS];
+    int topMoves;
+    SearchBudget budget;
+    long nextRead;  // Number of jobs read; job n lives in slot n % BATCH_QUEUE_JOBS.
+    long nextSolve; // Next job a worker takes.
+    bool inputDone;
+    pthread_mutex_t lock;
+    pthread_cond_t workAvailable; // Signalled when a job is read or the input ends.
+    pthread_cond_t progress;      // Signalled when a job is solved.
+} BatchQueue;
+
+// One worker thread with its own solver state
+typedef struct BatchWorker
+{
+    BatchQueue *queue;
+    SolverContext *context;
+    pthread_t thread;
+} BatchWorker;
+
+static const char *directionNames[4] = {"UP", "DOWN", "LEFT", "RIGHT"};
+
+/* FUNCTION PROTOTYPES*/
+static bool readLine(FILE *input, char line[BATCH_LINE_LENGTH], bool *tooLong);
+static bool readBatchJob(FILE *input, BatchJob *job);
+static void *runBatchWorker(void *argument);
+static double now(void);
+
+/*---------- FUNCTION: readLine -----------------------------------
+/   Function Description:
+/     Reads one line without its line ending.
+/   Caller Input:
+/     - FILE *input: The stream.
+/     - char line[BATCH_LINE_LENGTH]: Receives the line.
+/     - bool *tooLong: Set if the line did not fit; the rest is skipped.
+/   Caller Output:
+/     - bool: False at the end of the stream.
+/   Assumptions, Limitations, Known Bugs:
+/     - Accepts both "\n" and "\r\n" line endings.
+/---------------------------------------------------------*/
+static bool readLine(FILE *input, char line[BATCH_LINE_LENGTH], bool *tooLong)
+{
+    *tooLong = false;
+    if (fgets(line, BATCH_LINE_LENGTH, input) == NULL)
+    {
+        return false;
+    }
+
+    size_t length = strcspn(line, "\r\n");
+    if (line[length] == '\0' && !feof(input))
+    {
+        int character;
+        while ((character = fgetc(input)) != EOF && character != '\n')
+        {
+        }
+        *tooLong = true;
+    }
+    line[length] = '\0';
+    return true;
+}
+
+/*---------- FUNCTION: readBatchJob -----------------------------------
+/   Function Description:
+/     Reads the next job: a rack line followed by 15 board rows, or a rack
+/     and the whole board on one line (see batch.h).
+/   Caller Input:
+/     - FILE *input: The job stream.
+/     - BatchJob *job: Receives the job.
+/   Caller Output:
+/     - bool: False if the stream ended before another job started.
+/   Assumptions, Limitations, Known Bugs:
+/     - A job that cannot be read is still returned, with its error set,
+/       so the job numbers of the output stay in step with the input.
+/---------------------------------------------------------*/
+static bool readBatchJob(FILE *input, BatchJob *job)
+{
+    char line[BATCH_LINE_LENGTH];
+    bool tooLong;
+
+    job->error = NULL;
+    job->totalMoves = 0;
+    job->complete = true;
+    memset(job->letters, '_', BOARD_SQUARES);
+
+    do
+    {
+        if (!readLine(input, line, &tooLong))
+        {
+            return false;
+        }
+    } while (line[strspn(line, " \t")] == '\0' || line[0] == '#');
+
+    bool hasBoard;
+    job->error = parseJobLine(line, job->rack, job->letters, &hasBoard);
+    if (tooLong)
+    {
+        job->error = "line too long";
+    }
+    if (hasBoard)
+    {
+        return true;
+    }
+
+    for (int row = 0; row < BOARD_SIZE; row++)
+    {
+        if (!readLine(input, line, &tooLong))
+        {
+            job->error = "unexpected end of board";
+            return true;
+        }
+        if (strlen(line) < BOARD_SIZE)
+        {
+            job->error = job->error != NULL ? job->error : "board row too short";
+            continue;
+        }
+        memcpy(job->letters + row * BOARD_SIZE, line, BOARD_SIZE);
+    }
+    return true;
+}
+
+/*---------- FUNCTION: runBatchWorker -----------------------------------
+/   Function Description:
+/     Solves jobs in the order they were read until the input has ended
+/     and every job is taken.
+/   Caller Input:
+/     - void *argument: The BatchWorker.
+/   Caller Output:
+/     - void *: Always NULL.
+/   Assumptions, Limitations, Known Bugs:
+/     - N/A
+/---------------------------------------------------------*/
+static void *runBatchWorker(void *argument)
+{
+    BatchWorker *worker = (BatchWorker *)argument;
+    BatchQueue *queue = worker->queue;
+
+    pthread_mutex_lock(&queue->lock);
+    while (true)
+    {
+        while (queue->nextSolve == queue->nextRead && !queue->inputDone)
+        {
+            pthread_cond_wait(&queue->workAvailable, &queue->lock);
+        }
+        if (queue->nextSolve == queue->nextRead)
+        {
+            break;
+        }
+        BatchJob *job = &queue->jobs[queue->nextSolve++ % BATCH_QUEUE_JOBS];
+        pthread_mutex_unlock(&queue->lock);
+
+        if (job->error == NULL)
+        {
+            job->error = solveJob(worker->context, job->rack, job->letters, job->moves, queue->topMoves, queue->budget,
+                                  &job->totalMoves, &job->complete);
+        }
+
+        pthread_mutex_lock(&queue->lock);
+        job->done = true;
+        pthread_cond_signal(&queue->progress);
+    }
+    pthread_mutex_unlock(&queue->lock);
+    return NULL;
+}
+
+/*---------- FUNCTION: now -----------------------------------
+/   Function Description:
+/     Returns a monotonic time stamp.
+/   Caller Input:
+/     - None.
+/   Caller Output:
+/     - double: Seconds since an arbitrary point.
+/   Assumptions, Limitations, Known Bugs:
+/     - N/A
+/---------------------------------------------------------*/
+static double now(void)
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec + time.tv_nsec / 1e9;
+}
+
+/*---------- FUNCTION: runBatch -----------------------------------
+/   Function Description:
+/     Reads, solves and writes every job of a stream (see batch.h).
+/   Caller Input:
+/     - const Dictionary *dictionary: The loaded dictionary.
+/     - FILE *input: The job stream.
+/     - FILE *output: Stream the result lines are written to.
+/     - int threads: Number of worker threads (values below 1 mean 1).
+/     - int topMoves: Moves reported per job (values below 1 mean 1).
+/     - SearchBudget budget: Limits of each job's search.
+/     - BatchStats *stats: Receives the totals of the run.
+/   Caller Output:
+/     - bool: False if the workers could not be set up.
+/   Assumptions, Limitations, Known Bugs:
+/     - The calling thread only reads and writes; the workers solve.
+/---------------------------------------------------------*/
+bool runBatch(const Dictionary *dictionary, FILE *input, FILE *output, int threads, int topMoves, SearchBudget budget, BatchStats *stats)
+{
+    threads = threads < 1 ? 1 : threads;
+    topMoves = topMoves < 1 ? 1 : topMoves;
+    stats->jobs = 0;
+    stats->failedJobs = 0;
+    stats->partialJobs = 0;
+    stats->seconds = 0;
+
+    BatchQueue *queue = (BatchQueue *)malloc(sizeof(BatchQueue));
+    Move *moves = (Move *)malloc((size_t)BATCH_QUEUE_JOBS * topMoves * sizeof(Move));
+    BatchWorker *workers = (BatchWorker *)calloc(threads, sizeof(BatchWorker));
+    size_t resultSize = (size_t)topMoves * BATCH_RESULT_LINE_LENGTH;
+    char *result = (char *)malloc(resultSize);
+    if (queue == NULL || moves == NULL || workers == NULL || result == NULL)
+    {
+        perror("Failed to allocate memory");
+        free(queue);
+        free(moves);
+        free(workers);
+        free(result);
+        return false;
+    }
+
+    queue->topMoves = topMoves;
+    queue->budget = budget;
+    queue->nextRead = 0;
+    queue->nextSolve = 0;
+    queue->inputDone = false;
+    for (int i = 0; i < BATCH_QUEUE_JOBS; i++)
+    {
+        queue->jobs[i].moves = moves + (size_t)i * topMoves;
+    }
+    pthread_mutex_init(&queue->lock, NULL);
+    pthread_cond_init(&queue->workAvailable, NULL);
+    pthread_cond_init(&queue->progress, NULL);
+
+    int started = 0;
+    for (int i = 0; i < threads; i++)
+    {
+        workers[i].queue = queue;
+        workers[i].context = createSolverContextForDictionary(dictionary, 1);
+        if (workers[i].context == NULL || pthread_create(&workers[i].thread, NULL, runBatchWorker, &workers[i]) != 0)
+        {
+            freeSolverContext(workers[i].context);
+            break;
+        }
+        started++;
+    }
+
+    double start = now();
+    long nextWrite = 0;
+    pthread_mutex_lock(&queue->lock);
+    while (started > 0)
+    {
+        BatchJob *oldest = &queue->jobs[nextWrite % BATCH_QUEUE_JOBS];
+        if (nextWrite < queue->nextRead && oldest->done)
+        {
+            pthread_mutex_unlock(&queue->lock);
+            size_t length = formatJobResult(result, resultSize, nextWrite + 1, oldest->rack, oldest->error, oldest->moves,
+                                            oldest->totalMoves, oldest->complete);
+            fwrite(result, 1, length, output);
+            stats->failedJobs += oldest->error != NULL;
+            stats->partialJobs += !oldest->complete;
+            pthread_mutex_lock(&queue->lock);
+            nextWrite++;
+            continue;
+        }
+        if (queue->inputDone && nextWrite == queue->nextRead)
+        {
+            break;
+        }
+        if (!queue->inputDone && queue->nextRead - nextWrite < BATCH_QUEUE_JOBS)
+        {
+            // The slot is free: no worker looks at jobs that were not read yet
+            BatchJob *job = &queue->jobs[queue->nextRead % BATCH_QUEUE_JOBS];
+            pthread_mutex_unlock(&queue->lock);
+            bool read = readBatchJob(input, job);
+            pthread_mutex_lock(&queue->lock);
+            if (read)
+            {
+                job->done = false;
+                queue->nextRead++;
+            }
+            else
+            {
+                queue->inputDone = true;
+            }
+            pthread_cond_broadcast(&queue->workAvailable);
+            continue;
+        }
+        pthread_cond_wait(&queue->progress, &queue->lock);
+    }
+    queue->inputDone = true;
+    pthread_cond_broadcast(&queue->workAvailable);
+    pthread_mutex_unlock(&queue->lock);
+    fflush(output);
+
+    for (int i = 0; i < started; i++)
+    {
+        pthread_join(workers[i].thread, NULL);
+        freeSolverContext(workers[i].context);
+    }
+    stats->jobs = nextWrite;
+    stats->seconds = now() - start;
+
+    pthread_cond_destroy(&queue->progress);
+    pthread_cond_destroy(&queue->workAvailable);
+    pthread_mutex_destroy(&queue->lock);
+    free(result);
+    free(workers);
+    free(moves);
+    free(queue);
+    return started > 0;
+}
+
+/*---------- FUNCTION: parseJobLine -----------------------------------
+/   Function Description:
+/     Reads the first line of a job (see batch.h).
+/   Caller Input:
+/     - char *line: The line, without its line ending; it is modified.
+/     - char rack[BOARD_SIZE + 1]: Receives the rack in uppercase.
+/     - char letters[BOARD_SQUARES]: Receives the squares of a compact job.
+/     - bool *hasBoard: Set if the line held the board as well.
+/   Caller Output:
+/     - const char *: Why the line is not a job, NULL if it is one.
+/   Assumptions, Limitations, Known Bugs:
+/     - A rack that is too long is cut to BOARD_SIZE letters and reported.
+/---------------------------------------------------------*/
+const char *parseJobLine(char *line, char rack[BOARD_SIZE + 1], char letters[BOARD_SQUARES], bool *hasBoard)
+{
+    char *save;
+    char *rackWord = strtok_r(line, " \t", &save);
+    char *squares = strtok_r(NULL, " \t", &save);
+
+    rack[0] = '\0';
+    *hasBoard = squares != NULL;
+    if (rackWord == NULL)
+    {
+        return "missing rack";
+    }
+    for (int i = 0; i < BOARD_SIZE && rackWord[i] != '\0'; i++)
+    {
+        rack[i] = (char)toupper((unsigned char)rackWord[i]);
+        rack[i + 1] = '\0';
+    }
+    if (strlen(rackWord) > BOARD_SIZE)
+    {
+        return "rack too long";
+    }
+    if (squares == NULL)
+    {
+        return NULL;
+    }
+    if (strlen(squares) != BOARD_SQUARES)
+    {
+        return "compact board must have 225 squares";
+    }
+    memcpy(letters, squares, BOARD_SQUARES);
+    return NULL;
+}
+
+/*---------- FUNCTION: solveJob -----------------------------------
+/   Function Description:
+/     Builds the board of a job, checks it and finds its best moves.
+/   Caller Input:
+/     - SolverContext *context: The solver state to search with.
+/     - const char *rack: The rack.
+/     - const char letters[BOARD_SQUARES]: The board squares, '_' for empty.
+/     - Move moves[]: Receives the best moves, best first.
+/     - int topMoves: Capacity of moves.
+/     - SearchBudget budget: Limits of the search.
+/     - int *totalMoves: Receives the number of moves found.
+/     - bool *complete: Set to false if the search stopped at the budget.
+/   Caller Output:
+/     - const char *: Why the board is invalid, NULL if it was solved.
+/   Assumptions, Limitations, Known Bugs:
+/     - Does not allocate once the context has grown to fit (see solveTopMoves).
+/---------------------------------------------------------*/
+const char *solveJob(SolverContext *context, const char *rack, const char letters[BOARD_SQUARES], Move moves[], int topMoves, SearchBudget budget, int *totalMoves, bool *complete)
+{
+    Board board;
+
+    *totalMoves = 0;
+    *complete = true;
+    initBoard(&board);
+    setBoardLetters(&board, letters);
+    const char *problem = findBoardProblem(&board);
+    if (problem == NULL)
+    {
+        *totalMoves = solveTopMovesWithin(context, &board, rack, moves, topMoves, budget, complete);
+    }
+    return problem;
+}
+
+/*---------- FUNCTION: formatJobResult -----------------------------------
+/   Function Description:
+/     Writes the result lines of a job (see batch.h for the format).
+/   Caller Input:
+/     - char *output: Receives the lines.
+/     - size_t size: Size of output.
+/     - long number: Job number.
+/     - const char *rack: The rack of the job.
+/     - const char *error: Why the job failed, NULL if it was solved.
+/     - const Move moves[]: The moves found, best first.
+/     - int totalMoves: Number of moves found.
+/     - bool complete: False to mark the moves as partial.
+/   Caller Output:
+/     - size_t: Length of the lines written.
+/   Assumptions, Limitations, Known Bugs:
+/     - The rack letters used are matched the same way as in printBestMove.
+/---------------------------------------------------------*/
+size_t formatJobResult(char *output, size_t size, long number, const char *rack, const char *error, const Move moves[], int totalMoves, bool complete)
+{
+    const char *partial = complete ? "" : "\tpartial";
+    char line[BATCH_RESULT_LINE_LENGTH];
+    size_t length = 0;
+
+    if (error != NULL)
+    {
+        snprintf(line, sizeof(line), "%ld\t0\terror\t%s\n", number, error);
+    }
+    else if (totalMoves == 0)
+    {
+        snprintf(line, sizeof(line), "%ld\t0\tnone%s\n", number, partial);
+    }
+    if (error != NULL || totalMoves == 0)
+    {
+        length = strlen(line);
+        if (length >= size)
+        {
+            return 0;
+        }
+        memcpy(output, line, length + 1);
+        return length;
+    }
+
+    for (int rank = 0; rank < totalMoves; rank++)
+    {
+        const Move *move = &moves[rank];
+        char rackCopy[BOARD_SIZE + 1];
+        char usedLetters[BOARD_SIZE + 1];
+
+        strcpy(rackCopy, rack);
+        findUsedLetters(usedLetters, move->word, rackCopy);
+        int lineLength = snprintf(line, sizeof(line), "%ld\t%d\t%d\t%s\t%d\t%d\t%s\t%s%s\n",
+                                  number, rank + 1, move->score, move->word, move->row + 1, move->col + 1,
+                                  directionNames[move->direction & 3], usedLetters, partial);
+        if (lineLength < 0 || length + lineLength >= size)
+        {
+            break;
+        }
+        memcpy(output + length, line, lineLength + 1);
+        length += lineLength;
+    }
+    return length;
+}
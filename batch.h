@@ -0,0 +1,130 @@
+/*---------- ID HEADER -------------------------------------
+/   Author(s):    Aidan Andrews, Kyle Scidmore
+/   File Name:    batch.h
+/
+/   File Description:
+/     This header file declares the batch solver, which streams many
+/     board/rack jobs from one input against one loaded dictionary and
+/     solves them on a pool of worker threads. Results are written in input
+/     order as tab-separated lines.
+/
+/     Job format (blank lines and lines starting with '#' between jobs are
+/     skipped):
+/       - a line holding the rack followed by 15 board rows, as in a board
+/         file, or
+/       - a single line holding the rack, a space and all 225 squares of the
+/         board, row by row ('_' for an empty square).
+/
+/     Output, one line per move, best first:
+/       job  rank  score  word  row  col  direction  rackLettersUsed
+/     or "job 0 none" when the rack has no move and "job 0 error reason"
+/     for a job that could not be read or whose board is invalid. Jobs are
+/     numbered from 1; row and column are 1-based like the solver's output
+/     and give the square of the first letter, and direction is DOWN or
+/     RIGHT, the way the word reads from there.
+/     When the search of a job ran out of its time budget, "partial" is
+/     added as a last field to each of its lines: the moves are the best
+/     found in time and may not be the best there are.
+/
+/---------------------------------------------------------*/
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+
+#include "dataStruct.h"
+#include "dictionary.h"
+#include "solverContext.h"
+
+#define BATCH_QUEUE_JOBS 256 // Jobs read ahead of the oldest job not yet written
+#define BATCH_RESULT_LINE_LENGTH 96 // Longest result line, line ending included
+
+// Totals of one batch run
+typedef struct BatchStats {
+    long jobs;       // Jobs read.
+    long failedJobs; // Jobs reported as errors.
+    long partialJobs; // Jobs whose search stopped at the budget.
+    double seconds;  // Wall time from the first read to the last write.
+} BatchStats;
+
+/*---------- FUNCTION: runBatch -----------------------------------
+/   Function Description:
+/     Reads jobs from a stream until it ends, solves them on worker threads
+/     that each keep a SolverContext on the shared dictionary, and writes
+/     the top moves of every job in input order.
+/   Caller Input:
+/     - const Dictionary *dictionary: The loaded dictionary.
+/     - FILE *input: The job stream.
+/     - FILE *output: Stream the result lines are written to.
+/     - int threads: Number of worker threads (values below 1 mean 1).
+/     - int topMoves: Moves reported per job (values below 1 mean 1).
+/     - SearchBudget budget: Limits of each job's search, SEARCH_EXHAUSTIVE for none.
+/     - BatchStats *stats: Receives the totals of the run.
+/   Caller Output:
+/     - bool: False if the workers could not be set up.
+/   Assumptions, Limitations, Known Bugs:
+/     - At most BATCH_QUEUE_JOBS jobs are held in memory, so a slow job
+/       holds up the output but the input can be of any length.
+/---------------------------------------------------------*/
+bool runBatch(const Dictionary *dictionary, FILE *input, FILE *output, int threads, int topMoves, SearchBudget budget, BatchStats *stats);
+
+/*---------- FUNCTION: parseJobLine -----------------------------------
+/   Function Description:
+/     Reads the first line of a job: the rack and, in the compact form, the
+/     board squares.
+/   Caller Input:
+/     - char *line: The line, without its line ending; it is modified.
+/     - char rack[BOARD_SIZE + 1]: Receives the rack in uppercase.
+/     - char letters[BOARD_SQUARES]: Receives the squares of a compact job.
+/     - bool *hasBoard: Set if the line held the board as well.
+/   Caller Output:
+/     - const char *: Why the line is not a job, NULL if it is one.
+/   Assumptions, Limitations, Known Bugs:
+/     - A blank line is reported as a missing rack.
+/---------------------------------------------------------*/
+const char *parseJobLine(char *line, char rack[BOARD_SIZE + 1], char letters[BOARD_SQUARES], bool *hasBoard);
+
+/*---------- FUNCTION: solveJob -----------------------------------
+/   Function Description:
+/     Builds the board of a job, checks it and finds its best moves.
+/   Caller Input:
+/     - SolverContext *context: The solver state to search with.
+/     - const char *rack: The rack.
+/     - const char letters[BOARD_SQUARES]: The board squares, '_' for empty.
+/     - Move moves[]: Receives the best moves, best first.
+/     - int topMoves: Capacity of moves.
+/     - SearchBudget budget: Limits of the search, SEARCH_EXHAUSTIVE for none.
+/     - int *totalMoves: Receives the number of moves found.
+/     - bool *complete: Set to false if the search stopped at the budget.
+/   Caller Output:
+/     - const char *: Why the board is invalid, NULL if it was solved.
+/   Assumptions, Limitations, Known Bugs:
+/     - N/A
+/---------------------------------------------------------*/
+const char *solveJob(SolverContext *context, const char *rack, const char letters[BOARD_SQUARES], Move moves[], int topMoves, SearchBudget budget, int *totalMoves, bool *complete);
+
+/*---------- FUNCTION: formatJobResult -----------------------------------
+/   Function Description:
+/     Writes the result lines of a job in the output format above.
+/   Caller Input:
+/     - char *output: Receives the lines.
+/     - size_t size: Size of output, BATCH_RESULT_LINE_LENGTH per move is enough.
+/     - long number: Job number.
+/     - const char *rack: The rack of the job.
+/     - const char *error: Why the job failed, NULL if it was solved.
+/     - const Move moves[]: The moves found, best first.
+/     - int totalMoves: Number of moves found.
+/     - bool complete: False to mark the moves as partial.
+/   Caller Output:
+/     - size_t: Length of the lines written.
+/   Assumptions, Limitations, Known Bugs:
+/     - Lines that do not fit are left out whole.
+/---------------------------------------------------------*/
+size_t formatJobResult(char *output, size_t size, long number, const char *rack, const char *error, const Move moves[], int totalMoves, bool complete);
+
+#endif
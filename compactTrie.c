@@ -0,0 +1,202 @@
+/*---------- ID HEADER -------------------------------------
+/   Author(s):    Aidan Andrews, Kyle Scidmore
+/   File Name:    compactTrie.c
+/
+/   File Description:
+/     This file builds, searches and frees the compact Trie. It is built in
+/     one breadth-first pass over the sorted word list: the words below a
+/     node form one contiguous range of the list, so the children of a node
+/     are found by splitting its range on the next letter and are appended
+/     to the node array together.
+/
+/---------------------------------------------------------*/
+#include "compactTrie.h"
+
+// Range of the sorted word list that shares the prefix of a node
+typedef struct WordRange {
+    uint32_t first;         // Index of the first word with the prefix.
+    uint32_t last;          // One past the last word with the prefix.
+} WordRange;
+
+/*---------- FUNCTION: createCompactTrie -----------------------------------
+/   Function Description:
+/     Builds a compact Trie holding every word of a sorted word list.
+/
+/   Caller Input:
+/     - char (*words)[BOARD_SIZE + 1]: The words, uppercase A-Z, in strcmp order.
+/     - size_t totalWords: Number of words.
+/
+/   Caller Output:
+/     - CompactTrie *: The compact Trie. Release with freeCompactTrie.
+/
+/   Assumptions, Limitations, Known Bugs:
+/     - Exits the program on allocation failure.
+/     - Duplicate words are stored once; the caller must have removed words
+/       with characters other than A-Z.
+/---------------------------------------------------------*/
+CompactTrie *createCompactTrie(char (*words)[BOARD_SIZE + 1], size_t totalWords)
+{
+    CompactTrie *trie = malloc(sizeof(CompactTrie));
+    uint32_t capacity = 1024;
+    CompactTrieNode *nodes = malloc(capacity * sizeof(CompactTrieNode));
+    WordRange *ranges = malloc(capacity * sizeof(WordRange));
+    if (trie == NULL || nodes == NULL || ranges == NULL)
+    {
+        perror("Failed to allocate memory");
+        exit(1);
+    }
+
+    // Node 0 is the sentinel that COMPACT_TRIE_NONE refers to
+    nodes[0].info = 0;
+    nodes[0].firstChild = 0;
+    nodes[COMPACT_TRIE_ROOT].info = 0;
+    nodes[COMPACT_TRIE_ROOT].firstChild = 0;
+    ranges[COMPACT_TRIE_ROOT].first = 0;
+    ranges[COMPACT_TRIE_ROOT].last = (uint32_t)totalWords;
+    uint32_t totalNodes = 2;
+    uint32_t distinctWords = 0;
+
+    // Nodes are visited in index order, which is breadth-first order; depth
+    // only grows, so the depth of the node being visited is tracked alongside
+    uint32_t depthEnd = COMPACT_TRIE_ROOT + 1;
+    int depth = 0;
+
+    for (uint32_t node = COMPACT_TRIE_ROOT; node < totalNodes; node++)
+    {
+        if (node == depthEnd)
+        {
+            depthEnd = totalNodes;
+            depth++;
+        }
+
+        uint32_t first = ranges[node].first;
+        uint32_t last = ranges[node].last;
+
+        // Words ending here sort before every longer word with the prefix
+        if (first < last && words[first][depth] == '\0')
+        {
+            nodes[node].info |= COMPACT_TRIE_WORD_FLAG;
+            distinctWords++;
+            while (first < last && words[first][depth] == '\0')
+            {
+                first++;
+            }
+        }
+
+        nodes[node].firstChild = totalNodes;
+        while (first < last)
+        {
+            char letter = words[first][depth];
+            uint32_t end = first + 1;
+            while (end < last && words[end][depth] == letter)
+            {
+                end++;
+            }
+
+            if (totalNodes == capacity)
+            {
+                capacity *= 2;
+                nodes = realloc(nodes, capacity * sizeof(CompactTrieNode));
+                ranges = realloc(ranges, capacity * sizeof(WordRange));
+                if (nodes == NULL || ranges == NULL)
+                {
+                    perror("Failed to allocate memory");
+                    exit(1);
+                }
+            }
+
+            int letterIndex = letter - 'A';
+            nodes[node].info |= 1u << letterIndex;
+            nodes[totalNodes].info = (uint32_t)letterIndex << COMPACT_TRIE_LETTER_SHIFT;
+            nodes[totalNodes].firstChild = 0;
+            ranges[totalNodes].first = first;
+            ranges[totalNodes].last = end;
+            totalNodes++;
+            first = end;
+        }
+    }
+
+    free(ranges);
+    CompactTrieNode *trimmed = realloc(nodes, totalNodes * sizeof(CompactTrieNode));
+    trie->nodes = trimmed != NULL ? trimmed : nodes;
+    trie->totalNodes = totalNodes;
+    trie->totalWords = distinctWords;
+    return trie;
+}
+
+/*---------- FUNCTION: freeCompactTrie -----------------------------------
+/   Function Description:
+/     Frees the memory allocated for the compact Trie.
+/
+/   Caller Input:
+/     - CompactTrie *trie: The compact Trie to free.
+/
+/   Caller Output:
+/     - void: No return value.
+/
+/   Assumptions, Limitations, Known Bugs:
+/     - N/A
+/---------------------------------------------------------*/
+void freeCompactTrie(CompactTrie *trie)
+{
+    if (trie == NULL)
+    {
+        return;
+    }
+    free(trie->nodes);
+    free(trie);
+}
+
+/*---------- FUNCTION: searchCompactTrie -----------------------------------
+/   Function Description:
+/     Searches for a word in the compact Trie.
+/
+/   Caller Input:
+/     - const CompactTrie *trie: The compact Trie.
+/     - const char *word: The word to be searched for.
+/
+/   Caller Output:
+/     - int: 1 if the word is found, 0 otherwise.
+/
+/   Assumptions, Limitations, Known Bugs:
+/     - Assumes the word consists of uppercase letters.
+/---------------------------------------------------------*/
+int searchCompactTrie(const CompactTrie *trie, const char *word)
+{
+    uint32_t current = COMPACT_TRIE_ROOT;
+
+    while (*word)
+    {
+        int index = *word - 'A';
+        if (index < 0 || index >= MAX_CHARACTERS)
+        {
+            return 0;
+        }
+        current = compactTrieChild(trie, current, index);
+        if (current == COMPACT_TRIE_NONE)
+        {
+            return 0;
+        }
+        word++;
+    }
+
+    return (trie->nodes[current].info & COMPACT_TRIE_WORD_FLAG) != 0;
+}
+
+/*---------- FUNCTION: compactTrieMemoryUsage -----------------------------------
+/   Function Description:
+/     Reports how many bytes the compact Trie occupies.
+/
+/   Caller Input:
+/     - const CompactTrie *trie: The compact Trie.
+/
+/   Caller Output:
+/     - size_t: Size of the node array plus the header.
+/
+/   Assumptions, Limitations, Known Bugs:
+/     - N/A
+/---------------------------------------------------------*/
+size_t compactTrieMemoryUsage(const CompactTrie *trie)
+{
+    return sizeof(CompactTrie) + (size_t)trie->totalNodes * sizeof(CompactTrieNode);
+}
@@ -0,0 +1,75 @@
+/*---------- ID HEADER -------------------------------------
+/   Author(s):    Aidan Andrews, Kyle Scidmore
+/   File Name:    compactTrie.h
+/
+/   File Description:
+/     This header file defines the compact Trie, an alternative to the
+/     pointer-based TrieNode that stores the same tree in 8-byte nodes. Each
+/     node packs its child-presence mask, its letter and the word flag into
+/     one 32-bit word, plus the index of its first child. The children of a
+/     node are stored next to each other in letter order, so the child for a
+/     letter is found by counting the mask bits below it and "which children
+/     exist" is a single mask.
+/
+/---------------------------------------------------------*/
+#ifndef COMPACTTRIE_H
+#define COMPACTTRIE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "dataStruct.h"
+
+#define COMPACT_TRIE_NONE 0                 // Node index meaning "no node" (node 0 is an unused sentinel)
+#define COMPACT_TRIE_ROOT 1                 // Index of the root node
+#define COMPACT_TRIE_CHILD_BITS 0x03FFFFFFu // The 26 child-presence bits of info
+#define COMPACT_TRIE_LETTER_SHIFT 26        // info bits 26-30 hold the letter index (0 for the root)
+#define COMPACT_TRIE_WORD_FLAG 0x80000000u  // Set in info when a complete word ends at the node
+
+// Compact Trie Node Structure (8 bytes)
+typedef struct CompactTrieNode {
+    uint32_t info;          // Child mask, letter index and word flag.
+    uint32_t firstChild;    // Index of the child for the lowest letter in the mask.
+} CompactTrieNode;
+
+// Compact Trie Structure
+typedef struct CompactTrie {
+    CompactTrieNode *nodes; // Nodes in breadth-first order.
+    uint32_t totalNodes;
+    uint32_t totalWords;
+} CompactTrie;
+
+// Function prototypes
+CompactTrie *createCompactTrie(char (*words)[BOARD_SIZE + 1], size_t totalWords);
+void freeCompactTrie(CompactTrie *trie);
+int searchCompactTrie(const CompactTrie *trie, const char *word);
+size_t compactTrieMemoryUsage(const CompactTrie *trie);
+
+/*---------- FUNCTION: compactTrieChild -----------------------------------
+/   Function Description:
+/     Returns the child of a compact Trie node for a letter.
+/   Caller Input:
+/     - const CompactTrie *trie: The compact Trie.
+/     - uint32_t node: Index of the current node.
+/     - int letterIndex: The letter as an index from 0 ('A') to 25 ('Z').
+/   Caller Output:
+/     - uint32_t: Index of the child, COMPACT_TRIE_NONE if there is none.
+/   Assumptions, Limitations, Known Bugs:
+/     - letterIndex must be in range.
+/---------------------------------------------------------*/
+static inline uint32_t compactTrieChild(const CompactTrie *trie, uint32_t node, int letterIndex)
+{
+    uint32_t bit = 1u << letterIndex;
+    uint32_t mask = trie->nodes[node].info & COMPACT_TRIE_CHILD_BITS;
+
+    if (!(mask & bit))
+    {
+        return COMPACT_TRIE_NONE;
+    }
+    return trie->nodes[node].firstChild + __builtin_popcount(mask & (bit - 1));
+}
+
+#endif
@@ -7,46 +7,134 @@
 /     used in the Scrabble solver, including the Trie for word validation and the 
 /     game board representation. Functions include Trie node creation, word insertion,
 /     Trie freeing, board initialization, loading, validation, and valid placement 
-/     management.
+/     management. Trie nodes are allocated from an arena of large slabs owned
+/     by the root, so building a Trie costs a handful of allocations and
+/     freeing it releases the slabs without walking the nodes. The arena can
+/     also hold a second Trie of the reversed words, so UP/LEFT placements
+/     can be walked letter by letter as well.
 /
 /---------------------------------------------------------*/
 #include "dataStruct.h"
 
+#define TRIE_FIRST_SLAB_NODES 64     // Nodes in the first slab of an arena
+#define TRIE_MAX_SLAB_NODES 65536    // Slabs stop doubling at this many nodes (about 14 MB)
+
+// Block of Trie nodes handed out in order by allocateTrieNode
+typedef struct TrieSlab {
+    struct TrieSlab *next;  // Previously filled slab.
+    size_t capacity;        // Number of nodes in this slab.
+    size_t used;            // Number of nodes handed out so far.
+    TrieNode nodes[];
+} TrieSlab;
+
+// Storage for one Trie. The root comes first so the arena can be found from it.
+typedef struct TrieArena {
+    TrieNode root;          // Root node returned by createTrieNode.
+    TrieSlab *slabs;        // Slab currently being filled, linked to the older ones.
+    size_t nextCapacity;    // Size of the next slab.
+    struct TrieArena *adopted; // Arenas of parallel build workers whose nodes hang below this root.
+    TrieNode *reverse;      // Root of the Trie of reversed words, NULL until one is inserted.
+    size_t reverseNodes;    // Nodes of this arena that belong to the reverse Trie.
+} TrieArena;
+
+// Words of one parallel build job: every word with the same first two letters
+typedef struct TrieBuildJob {
+    TrieNode *parent;       // Shared node for the first letter; the job owns one of its child slots.
+    const uint32_t *order;  // Indices of the job's words, in word list order.
+    size_t totalWords;
+} TrieBuildJob;
+
+// State shared by the workers of one parallel build
+typedef struct TrieBuild {
+    char (*words)[BOARD_SIZE + 1];
+    TrieBuildJob *jobs;     // Largest job first.
+    int totalJobs;
+    int nextJob;            // Next job to hand out, taken atomically.
+} TrieBuild;
+
+// One worker thread of a parallel build and the arena it allocates from
+typedef struct TrieBuildWorker {
+    TrieBuild *build;
+    TrieNode *arenaRoot;    // Root of a private, otherwise empty Trie that owns the worker's nodes.
+    pthread_t thread;
+} TrieBuildWorker;
+
 //Prototypes
-static void changeValidPlacement(Square board[BOARD_SIZE][BOARD_SIZE], int row, int col);
-static void checkValidPlacements(Square board[BOARD_SIZE][BOARD_SIZE]);
-bool isValidPosition(int row, int col);
-void boardDFS(Square board[BOARD_SIZE][BOARD_SIZE], int row, int col, bool **visited);
-bool isBoardConnected(Square board[BOARD_SIZE][BOARD_SIZE]);
-bool isBoardEmpty(Square board[BOARD_SIZE][BOARD_SIZE]);
+static TrieNode *allocateTrieNode(TrieArena *arena, char letter);
+static void *runTrieBuildWorker(void *argument);
+static int compareTrieBuildJobs(const void *a, const void *b);
+static void checkValidPlacements(Board *board);
+bool isBoardConnected(Board *board);
+bool isBoardEmpty(Board *board);
 
 /*---------- FUNCTION: createTrieNode -----------------------------------
 /   Function Description:
-/     Creates a new TrieNode with the given letter and initializes its children.
+/     Creates the root node of a new, empty Trie. The root is the first
+/     member of the Trie's arena, so every node later inserted below it is
+/     carved out of the arena's slabs instead of being allocated on its own.
 /
 /   Caller Input:
 /     - char letter: The character to be stored in the TrieNode.
 /
 /   Caller Output:
-/     - TrieNode *: Pointer to the newly created TrieNode.
+/     - TrieNode *: Pointer to the newly created root node.
 /       Exits the program if memory allocation fails.
 /
 /   Assumptions, Limitations, Known Bugs:
 /     - Exits the program on allocation failure.
+/     - The returned node must only be released with freeTrie, never free.
 /---------------------------------------------------------*/
 TrieNode *createTrieNode(char letter){
 
-    TrieNode *node = (TrieNode *)malloc(sizeof(TrieNode));
+    TrieArena *arena = (TrieArena *)calloc(1, sizeof(TrieArena));
 
-    if (node == NULL) {
+    if (arena == NULL) {
         perror("Failed to allocate memory");
         exit(1);
     }
-    node->letter = letter;
-    node->isWord = 0;
-    for (int i = 0; i < MAX_CHARACTERS; i++){
-        node->children[i] = NULL;
+    arena->root.letter = letter;
+    arena->nextCapacity = TRIE_FIRST_SLAB_NODES;
+    return &arena->root;
+
+}
+
+/*---------- FUNCTION: allocateTrieNode -----------------------------------
+/   Function Description:
+/     Takes the next free node from the arena, starting a new slab when the
+/     current one is full. Each slab is twice the size of the previous one
+/     (up to TRIE_MAX_SLAB_NODES), so nodes are laid out contiguously in
+/     insertion order.
+/
+/   Caller Input:
+/     - TrieArena *arena: The arena of the Trie the node belongs to.
+/     - char letter: The character to be stored in the TrieNode.
+/
+/   Caller Output:
+/     - TrieNode *: Pointer to a zeroed node holding the letter.
+/
+/   Assumptions, Limitations, Known Bugs:
+/     - Exits the program on allocation failure.
+/---------------------------------------------------------*/
+static TrieNode *allocateTrieNode(TrieArena *arena, char letter){
+
+    TrieSlab *slab = arena->slabs;
+
+    if (slab == NULL || slab->used == slab->capacity){
+        slab = (TrieSlab *)calloc(1, sizeof(TrieSlab) + arena->nextCapacity * sizeof(TrieNode));
+        if (slab == NULL) {
+            perror("Failed to allocate memory");
+            exit(1);
+        }
+        slab->capacity = arena->nextCapacity;
+        slab->next = arena->slabs;
+        arena->slabs = slab;
+        if (arena->nextCapacity < TRIE_MAX_SLAB_NODES){
+            arena->nextCapacity *= 2;
+        }
     }
+
+    TrieNode *node = &slab->nodes[slab->used++];
+    node->letter = letter;
     return node;
 
 }
@@ -64,46 +152,383 @@ TrieNode *createTrieNode(char letter){
 /
 /   Assumptions, Limitations, Known Bugs:
 /     - Assumes the word consists of uppercase letters.
+/     - root must have been returned by createTrieNode.
 /---------------------------------------------------------*/
 void insertWord(TrieNode *root, const char *word){
 
+    TrieArena *arena = (TrieArena *)root;
     TrieNode *current = root;
 
-    int len = strlen(word);
+    for (; *word; word++){
+        int index = *word - 'A';
+        if (current->children[index] == NULL){
+            current->children[index] = allocateTrieNode(arena, *word);
+        }
+        current = current->children[index];
+    }
+    current->isWord = 1;
+
+}
+
+/*---------- FUNCTION: insertWordAlongPath -----------------------------------
+/   Function Description:
+/     Inserts a word that shares its first letters with the previously
+/     inserted one. The descent starts from the node the two words share
+/     instead of the root, and the path array is updated for the next word.
+/     With a sorted word list most words share a long prefix with the one
+/     before them.
+/
+/   Caller Input:
+/     - TrieNode *root: Pointer to the root of the Trie.
+/     - TrieNode *path[]: path[i] is the node reached by the first i letters
+/       of the previous word; path[0] must be root. Needs length + 1 entries.
+/     - const char *word: The word to be inserted.
+/     - int length: Length of the word.
+/     - int sharedLength: Number of leading letters shared with the previous word.
+/
+/   Caller Output:
+/     - void: No return value. path[0..length] describes the new word.
+/
+/   Assumptions, Limitations, Known Bugs:
+/     - Assumes the word consists of uppercase letters.
+/     - sharedLength must not exceed the length of either word.
+/---------------------------------------------------------*/
+void insertWordAlongPath(TrieNode *root, TrieNode *path[], const char *word, int length, int sharedLength){
+
+    TrieArena *arena = (TrieArena *)root;
+    TrieNode *current = path[sharedLength];
 
-    for (int i = 0; i < len; i++){
+    for (int i = sharedLength; i < length; i++){
         int index = word[i] - 'A';
         if (current->children[index] == NULL){
-            current->children[index] = createTrieNode(word[i]);
+            current->children[index] = allocateTrieNode(arena, word[i]);
         }
         current = current->children[index];
+        path[i + 1] = current;
     }
     current->isWord = 1;
 
 }
 
-/*---------- FUNCTION: freeTrie -----------------------------------
+/*---------- FUNCTION: insertReversedWord -----------------------------------
 /   Function Description:
-/     Recursively frees the memory allocated for the Trie data structure.
+/     Inserts a word back to front into the reverse Trie that belongs to a
+/     Trie, creating the reverse root on first use. The reverse Trie takes
+/     its nodes from the same arena as the forward one, so both are built
+/     without extra allocations and released together by freeTrie.
 /
 /   Caller Input:
-/     - TrieNode *node: Pointer to the current node in the Trie.
+/     - TrieNode *root: Pointer to the root of the forward Trie.
+/     - const char *word: The word to be inserted.
 /
 /   Caller Output:
 /     - void: No return value.
 /
 /   Assumptions, Limitations, Known Bugs:
+/     - Assumes the word consists of uppercase letters.
+/     - root must have been returned by createTrieNode.
+/---------------------------------------------------------*/
+void insertReversedWord(TrieNode *root, const char *word){
+
+    TrieArena *arena = (TrieArena *)root;
+
+    if (arena->reverse == NULL){
+        arena->reverse = allocateTrieNode(arena, '\0');
+        arena->reverseNodes++;
+    }
+
+    TrieNode *current = arena->reverse;
+    for (int i = (int)strlen(word) - 1; i >= 0; i--){
+        int index = word[i] - 'A';
+        if (current->children[index] == NULL){
+            current->children[index] = allocateTrieNode(arena, word[i]);
+            arena->reverseNodes++;
+        }
+        current = current->children[index];
+    }
+    current->isWord = 1;
+
+}
+
+/*---------- FUNCTION: reverseTrieRoot -----------------------------------
+/   Function Description:
+/     Returns the root of the Trie of reversed words that belongs to a Trie.
+/     Walking it with trieChild over the letters of a word from last to
+/     first reaches a node with isWord set exactly when the word is in the
+/     dictionary.
+/
+/   Caller Input:
+/     - TrieNode *root: Pointer to the root of the forward Trie.
+/
+/   Caller Output:
+/     - TrieNode *: The reverse root, or NULL if no reversed word was inserted.
+/
+/   Assumptions, Limitations, Known Bugs:
+/     - root must have been returned by createTrieNode.
+/---------------------------------------------------------*/
+TrieNode *reverseTrieRoot(TrieNode *root){
+
+    return ((TrieArena *)root)->reverse;
+
+}
+
+/*---------- FUNCTION: trieMemoryUsage -----------------------------------
+/   Function Description:
+/     Reports the memory held by a Trie: its arena, every slab and the
+/     arenas it adopted from a parallel build.
+/
+/   Caller Input:
+/     - TrieNode *root: Pointer to the root of the Trie.
+/     - size_t *reverseBytes: Receives the part used by the nodes of the
+/       reverse Trie (may be NULL).
+/
+/   Caller Output:
+/     - size_t: Bytes allocated for the forward and reverse Trie together,
+/       including the unused tail of the last slab.
+/
+/   Assumptions, Limitations, Known Bugs:
+/     - root must have been returned by createTrieNode.
+/---------------------------------------------------------*/
+size_t trieMemoryUsage(TrieNode *root, size_t *reverseBytes){
+
+    size_t bytes = 0;
+
+    if (reverseBytes != NULL){
+        *reverseBytes = ((TrieArena *)root)->reverseNodes * sizeof(TrieNode);
+    }
+    for (TrieArena *arena = (TrieArena *)root; arena != NULL; arena = arena->adopted){
+        bytes += sizeof(TrieArena);
+        for (TrieSlab *slab = arena->slabs; slab != NULL; slab = slab->next){
+            bytes += sizeof(TrieSlab) + slab->capacity * sizeof(TrieNode);
+        }
+    }
+    return bytes;
+
+}
+
+/*---------- FUNCTION: buildTrieParallel -----------------------------------
+/   Function Description:
+/     Builds a Trie from a word list on several threads. The words are
+/     grouped by their first two letters. The main thread creates the
+/     first-letter nodes, then each group is an independent subtree that a
+/     worker builds in its own arena and links into the child slot it owns.
+/     Groups are handed out largest first so the workers finish together.
+/     Afterwards the root adopts the worker arenas so freeTrie releases them.
+/
+/   Caller Input:
+/     - char (*words)[BOARD_SIZE + 1]: The words, uppercase A-Z, in any order.
+/     - size_t totalWords: Number of words.
+/     - int threads: Number of threads to build with, including the caller.
+/
+/   Caller Output:
+/     - TrieNode *: Pointer to the root of the Trie. Release with freeTrie.
+/
+/   Assumptions, Limitations, Known Bugs:
+/     - Exits the program on allocation failure.
+/     - If a thread cannot be started its work is done by the others.
+/     - Words are inserted along the previous word's path, so sorted input
+/       builds fastest.
+/---------------------------------------------------------*/
+TrieNode *buildTrieParallel(char (*words)[BOARD_SIZE + 1], size_t totalWords, int threads){
+
+    TrieNode *root = createTrieNode('\0');
+    TrieArena *arena = (TrieArena *)root;
+    size_t pairStart[MAX_CHARACTERS * MAX_CHARACTERS + 1] = {0};
+    uint32_t *order = (uint32_t *)malloc((totalWords + 1) * sizeof(uint32_t));
+    TrieBuildJob *jobs = (TrieBuildJob *)malloc(MAX_CHARACTERS * MAX_CHARACTERS * sizeof(TrieBuildJob));
+
+    if (order == NULL || jobs == NULL) {
+        perror("Failed to allocate memory");
+        exit(1);
+    }
+
+    // One-letter words end on the shared first-letter nodes; count the rest by letter pair
+    for (size_t i = 0; i < totalWords; i++){
+        int first = words[i][0] - 'A';
+        if (root->children[first] == NULL){
+            root->children[first] = allocateTrieNode(arena, words[i][0]);
+        }
+        if (words[i][1] == '\0'){
+            root->children[first]->isWord = 1;
+        }
+        else {
+            pairStart[first * MAX_CHARACTERS + (words[i][1] - 'A') + 1]++;
+        }
+    }
+    for (int pair = 0; pair < MAX_CHARACTERS * MAX_CHARACTERS; pair++){
+        pairStart[pair + 1] += pairStart[pair];
+    }
+
+    // Stable counting sort of the word indices by letter pair
+    size_t pairFill[MAX_CHARACTERS * MAX_CHARACTERS];
+    memcpy(pairFill, pairStart, sizeof(pairFill));
+    for (size_t i = 0; i < totalWords; i++){
+        if (words[i][1] != '\0'){
+            order[pairFill[(words[i][0] - 'A') * MAX_CHARACTERS + (words[i][1] - 'A')]++] = (uint32_t)i;
+        }
+    }
+
+    TrieBuild build = {words, jobs, 0, 0};
+    for (int pair = 0; pair < MAX_CHARACTERS * MAX_CHARACTERS; pair++){
+        size_t count = pairStart[pair + 1] - pairStart[pair];
+        if (count > 0){
+            jobs[build.totalJobs].parent = root->children[pair / MAX_CHARACTERS];
+            jobs[build.totalJobs].order = order + pairStart[pair];
+            jobs[build.totalJobs].totalWords = count;
+            build.totalJobs++;
+        }
+    }
+    qsort(jobs, build.totalJobs, sizeof(TrieBuildJob), compareTrieBuildJobs);
+
+    if (threads < 1){
+        threads = 1;
+    }
+    if (threads > build.totalJobs && build.totalJobs > 0){
+        threads = build.totalJobs;
+    }
+
+    TrieBuildWorker *workers = (TrieBuildWorker *)malloc(threads * sizeof(TrieBuildWorker));
+    if (workers == NULL) {
+        perror("Failed to allocate memory");
+        exit(1);
+    }
+
+    // The calling thread is worker 0; the others run alongside it
+    int started = 1;
+    for (int i = 0; i < threads; i++){
+        workers[i].build = &build;
+        workers[i].arenaRoot = createTrieNode('\0');
+    }
+    for (int i = 1; i < threads; i++){
+        if (pthread_create(&workers[i].thread, NULL, runTrieBuildWorker, &workers[i]) != 0){
+            break;
+        }
+        started++;
+    }
+    runTrieBuildWorker(&workers[0]);
+    for (int i = 1; i < started; i++){
+        pthread_join(workers[i].thread, NULL);
+    }
+
+    for (int i = 0; i < threads; i++){
+        TrieArena *workerArena = (TrieArena *)workers[i].arenaRoot;
+        workerArena->adopted = arena->adopted;
+        arena->adopted = workerArena;
+    }
+
+    free(workers);
+    free(jobs);
+    free(order);
+    return root;
+
+}
+
+/*---------- FUNCTION: runTrieBuildWorker -----------------------------------
+/   Function Description:
+/     Takes jobs from a parallel build until none are left and inserts their
+/     words into the worker's arena, below the job's shared first-letter node.
+/
+/   Caller Input:
+/     - void *argument: The TrieBuildWorker.
+/
+/   Caller Output:
+/     - void *: Always NULL.
+/
+/   Assumptions, Limitations, Known Bugs:
+/     - Each job only writes the one child slot of its parent that belongs to
+/       its second letter, so jobs never touch the same memory.
+/---------------------------------------------------------*/
+static void *runTrieBuildWorker(void *argument){
+
+    TrieBuildWorker *worker = (TrieBuildWorker *)argument;
+    TrieBuild *build = worker->build;
+    TrieNode *path[BOARD_SIZE + 1];
+
+    for (;;){
+        int next = __atomic_fetch_add(&build->nextJob, 1, __ATOMIC_RELAXED);
+        if (next >= build->totalJobs){
+            break;
+        }
+
+        TrieBuildJob *job = &build->jobs[next];
+        const char *previousWord = NULL;
+        int previousLength = 1;
+        path[1] = job->parent;
+
+        // Every word of the job shares its first letter; only path[1] is valid at the start
+        for (size_t i = 0; i < job->totalWords; i++){
+            const char *word = build->words[job->order[i]];
+            int length = (int)strlen(word);
+            int shared = 1;
+            while (shared < previousLength && shared < length && word[shared] == previousWord[shared]){
+                shared++;
+            }
+            insertWordAlongPath(worker->arenaRoot, path, word, length, shared);
+            previousWord = word;
+            previousLength = length;
+        }
+    }
+    return NULL;
+
+}
+
+/*---------- FUNCTION: compareTrieBuildJobs -----------------------------------
+/   Function Description:
+/     qsort comparator ordering parallel build jobs from most to fewest words.
+/
+/   Caller Input:
+/     - const void *a: First TrieBuildJob.
+/     - const void *b: Second TrieBuildJob.
+/
+/   Caller Output:
+/     - int: Negative, zero or positive like strcmp.
+/
+/   Assumptions, Limitations, Known Bugs:
 /     - N/A
 /---------------------------------------------------------*/
+static int compareTrieBuildJobs(const void *a, const void *b){
+
+    const TrieBuildJob *first = (const TrieBuildJob *)a;
+    const TrieBuildJob *second = (const TrieBuildJob *)b;
+
+    return (first->totalWords < second->totalWords) - (first->totalWords > second->totalWords);
+
+}
+
+/*---------- FUNCTION: freeTrie -----------------------------------
+/   Function Description:
+/     Frees the memory allocated for the Trie data structure by releasing
+/     its slabs, and those of any worker arenas it adopted, without visiting
+/     the individual nodes.
+/
+/   Caller Input:
+/     - TrieNode *node: Pointer to the root of the Trie.
+/
+/   Caller Output:
+/     - void: No return value.
+/
+/   Assumptions, Limitations, Known Bugs:
+/     - Must be given the root returned by createTrieNode; every node of the
+/       Trie becomes invalid.
+/---------------------------------------------------------*/
 void freeTrie(TrieNode *node){
 
     if (node == NULL){
         return;
     }
-    for (int i = 0; i < MAX_CHARACTERS; i++){
-        freeTrie(node->children[i]);
+
+    TrieArena *arena = (TrieArena *)node;
+    while (arena != NULL){
+        TrieSlab *slab = arena->slabs;
+        while (slab != NULL){
+            TrieSlab *next = slab->next;
+            free(slab);
+            slab = next;
+        }
+        TrieArena *adopted = arena->adopted;
+        free(arena);
+        arena = adopted;
     }
-    free(node);
 
 }
 
@@ -137,13 +562,49 @@ int searchWord(TrieNode *root, const char *word) {
     return current->isWord; // Return 1 if the current node completes a word
 }
 
+/*---------- FUNCTION: searchReversedWord -----------------------------------
+/   Function Description:
+/     Checks if a run of letters read from last to first is a word, without
+/     copying it. The letters are walked in the order given through the
+/     reverse Trie when one was built, otherwise the forward Trie is walked
+/     from the last letter back.
+/
+/   Caller Input:
+/     - TrieNode *root: Pointer to the root of the forward Trie.
+/     - const char *letters: The word written back to front.
+/
+/   Caller Output:
+/     - int: 1 if the reversed letters form a word, 0 otherwise.
+/
+/   Assumptions, Limitations, Known Bugs:
+/     - root must have been returned by createTrieNode.
+/---------------------------------------------------------*/
+int searchReversedWord(TrieNode *root, const char *letters) {
+
+    TrieNode *current = reverseTrieRoot(root);
+
+    if (current != NULL) {
+        for (; *letters && current != NULL; letters++) {
+            current = trieChild(current, *letters);
+        }
+    } else {
+        current = root;
+        for (int i = (int)strlen(letters) - 1; i >= 0 && current != NULL; i--) {
+            current = trieChild(current, letters[i]);
+        }
+    }
+
+    return current != NULL && current->isWord;
+}
+
+
 
 /*---------- FUNCTION: initBoard -----------------------------------
 /   Function Description:
 /     Initializes the game board with empty squares and assigns bonus values.
 /
 /   Caller Input:
-/     - Square board[BOARD_SIZE][BOARD_SIZE]: The game board to be initialized.
+/     - Board *board: The game board to be initialized.
 /
 /   Caller Output:
 /     - void: No return value.
@@ -151,7 +612,7 @@ int searchWord(TrieNode *root, const char *word) {
 /   Assumptions, Limitations, Known Bugs:
 /     - Uses hardcoded bonus positions.
 /---------------------------------------------------------*/
-void initBoard(Square board[BOARD_SIZE][BOARD_SIZE]) {
+void initBoard(Board *board) {
 
     // Hardcoded bonus values
     int doubleLetter[24][2] = {{0,3}, {0,11}, {2,6}, {2,8}, {3,0}, {3,7}, {3,14}, {6,2}, {6,6}, {6,8}, {6,12}, {7,3}, {7,11}, {8,2}, {8,6}, {8,8}, {8,12}, {11,0}, {11,7}, {11,14}, {12,6}, {12,8}, {14,3}, {14,11}};
@@ -164,30 +625,36 @@ void initBoard(Square board[BOARD_SIZE][BOARD_SIZE]) {
 
 
     // Initialize all squares to empty
+    Square (*squares)[BOARD_SIZE] = board->squares;
     for(int row = 0; row < BOARD_SIZE; row++){
         for(int col = 0; col < BOARD_SIZE; col++){
-            board[row][col].letter = ' ';
-            board[row][col].bonus = 0;
-            board[row][col].validPlacement = false;
-            board[row][col].usedBonus = false;
+            squares[row][col].letter = ' ';
+            squares[row][col].bonus = 0;
+            squares[row][col].validPlacement = false;
+            squares[row][col].usedBonus = false;
+            squares[row][col].crossCheck[0] = CROSS_CHECK_ALL;
+            squares[row][col].crossCheck[1] = CROSS_CHECK_ALL;
+            squares[row][col].crossScore[0] = 0;
+            squares[row][col].crossScore[1] = 0;
         }
     }
+    memset(&board->occupied, 0, sizeof(board->occupied));
 
     //Assign bonus values to squares
     for(int i = 0; i < 24; i++){
-        board[doubleLetter[i][0]][doubleLetter[i][1]].bonus = 1;
+        squares[doubleLetter[i][0]][doubleLetter[i][1]].bonus = 1;
     }
 
     for(int i = 0; i < 12; i++){
-        board[tripleLetter[i][0]][tripleLetter[i][1]].bonus = 2;
+        squares[tripleLetter[i][0]][tripleLetter[i][1]].bonus = 2;
     }
 
     for(int i = 0; i < 16; i++){
-        board[doubleWord[i][0]][doubleWord[i][1]].bonus = 3;
+        squares[doubleWord[i][0]][doubleWord[i][1]].bonus = 3;
     }
 
     for(int i = 0; i < 8; i++){
-        board[tripleWord[i][0]][tripleWord[i][1]].bonus = 4;
+        squares[tripleWord[i][0]][tripleWord[i][1]].bonus = 4;
     }
 }
 
@@ -196,7 +663,7 @@ void initBoard(Square board[BOARD_SIZE][BOARD_SIZE]) {
 /     Loads the game board from a file.
 /
 /   Caller Input:
-/     - Square board[BOARD_SIZE][BOARD_SIZE]: The game board to be loaded.
+/     - Board *board: The game board to be loaded.
 /     - const char *filename: The path to the file containing the board layout.
 /
 /   Caller Output:
@@ -207,8 +674,10 @@ void initBoard(Square board[BOARD_SIZE][BOARD_SIZE]) {
 /     - Treats '_' in the file as an empty space.
 /     - Exits the program if the file cannot be opened or if the file format is incorrect.
 /     - Calls checkValidPlacements at the end to set valid placement flags.
+/     - Every letter passes the cross-checks until computeCrossChecks is
+/       called with a dictionary.
 /---------------------------------------------------------*/
-void loadBoard(Square board[BOARD_SIZE][BOARD_SIZE], const char *filename) {
+void loadBoard(Board *board, const char *filename) {
 
     FILE *file = fopen(filename, "r");
     if (file == NULL) {
@@ -217,144 +686,198 @@ void loadBoard(Square board[BOARD_SIZE][BOARD_SIZE], const char *filename) {
     }
 
     char line[BOARD_SIZE + 2]; // +2 to account for newline and null terminator
+    char letters[BOARD_SQUARES];
     for (int row = 0; row < BOARD_SIZE; row++) {
         if (fgets(line, sizeof(line), file) == NULL) {
             fprintf(stderr, "Error: Unexpected end of board at row %d\n", row);
             exit(1);
         }
+        memcpy(letters + row * BOARD_SIZE, line, BOARD_SIZE);
+    }
+    setBoardLetters(board, letters);
+
+    fclose(file);
+}
 
+/*---------- FUNCTION: setBoardLetters -----------------------------------
+/   Function Description:
+/     Fills in the letters of the game board from text, one character per
+/     square in row-major order, as loadBoard reads them from a file.
+/
+/   Caller Input:
+/     - Board *board: The game board, set up by initBoard.
+/     - const char *letters: BOARD_SQUARES characters, '_' for an empty square.
+/
+/   Caller Output:
+/     - void: No return value.
+/
+/   Assumptions, Limitations, Known Bugs:
+/     - The letters go through setBoardTile, so the occupancy follows them.
+/     - Calls checkValidPlacements at the end to set valid placement flags.
+/---------------------------------------------------------*/
+void setBoardLetters(Board *board, const char *letters) {
+
+    for (int row = 0; row < BOARD_SIZE; row++) {
         for (int col = 0; col < BOARD_SIZE; col++) {
-            if (line[col] == '_') {
-                board[row][col].letter = ' '; // Treat '_' as an empty space
-            } else {
-                board[row][col].letter = line[col]; // Copy the character from the file
-            }
+            char letter = letters[row * BOARD_SIZE + col];
+            setBoardTile(board, row, col, letter == '_' ? ' ' : letter); // Treat '_' as an empty space
         }
     }
     checkValidPlacements(board);
-
-    fclose(file);
 }
 
-
-/*---------- FUNCTION: isValidPosition -----------------------------------
+/*---------- FUNCTION: setBoardTile -----------------------------------
 /   Function Description:
-/     Checks if a given row and column are within the bounds of the game board.
+/     Puts a letter on a square (or empties it with ' ') and updates the
+/     occupancy of the board to match, so both views stay in sync.
 /
 /   Caller Input:
-/     - int row: The row index.
-/     - int col: The column index.
+/     - Board *board: The game board.
+/     - int row: Row index of the square.
+/     - int col: Column index of the square.
+/     - char letter: The letter, or ' ' to empty the square.
 /
 /   Caller Output:
-/     - bool: True if the position is valid, false otherwise.
+/     - void: No return value.
 /
 /   Assumptions, Limitations, Known Bugs:
-/     - N/A
+/     - The square must be on the board.
+/     - Valid placements and cross-checks are not updated.
 /---------------------------------------------------------*/
-bool isValidPosition(int row, int col) {
+void setBoardTile(Board *board, int row, int col, char letter) {
 
-    // Check if the position is within the board bounds
-    return (row >= 0 && row < BOARD_SIZE && col >= 0 && col < BOARD_SIZE);
+    BoardBits *bits = &board->occupied;
+    uint16_t occupied = letter != ' ';
 
+    board->squares[row][col].letter = letter;
+    bits->rows[row] = (bits->rows[row] & ~(1u << col)) | (occupied << col);
+    bits->columns[col] = (bits->columns[col] & ~(1u << row)) | (occupied << row);
 }
 
-/*---------- FUNCTION: boardDFS -----------------------------------
+/*---------- FUNCTION: findAnchors -----------------------------------
 /   Function Description:
-/     Performs Depth-First Search on the game board to check connectivity.
+/     Computes the valid placement squares from the occupancy: every tile,
+/     every square next to a tile and the center square if it is empty.
+/     Neighbours are found by shifting each row mask left and right and
+/     OR-ing in the rows above and below.
 /
 /   Caller Input:
-/     - Square board[BOARD_SIZE][BOARD_SIZE]: The game board.
-/     - int row: The starting row index.
-/     - int col: The starting column index.
-/     - bool **visited: A 2D array to track visited squares.
+/     - const BoardBits *occupied: The occupancy of the board.
+/     - BoardBits *anchors: Receives the valid placement squares.
 /
 /   Caller Output:
 /     - void: No return value.
 /
 /   Assumptions, Limitations, Known Bugs:
-/     - N/A
+/     - Squares on the board edges have no neighbours beyond it.
 /---------------------------------------------------------*/
-void boardDFS(Square board[BOARD_SIZE][BOARD_SIZE], int row, int col, bool **visited) {
+void findAnchors(const BoardBits *occupied, BoardBits *anchors) {
 
-    // Base cases: out of bounds, already visited, or empty square
-    if (row < 0 || row >= BOARD_SIZE || col < 0 || col >= BOARD_SIZE || visited[row][col] || board[row][col].letter == ' ') {
-        return;
+    for (int row = 0; row < BOARD_SIZE; row++) {
+        uint16_t above = row > 0 ? occupied->rows[row - 1] : 0;
+        uint16_t below = row < BOARD_SIZE - 1 ? occupied->rows[row + 1] : 0;
+        uint16_t tiles = occupied->rows[row];
+        anchors->rows[row] = (tiles | (tiles << 1) | (tiles >> 1) | above | below) & BOARD_ROW_BITS;
     }
+    anchors->rows[CENTER] |= 1u << CENTER;
 
-    visited[row][col] = true; // Mark the current square as visited
-
-    // Recursively visit adjacent squares
-    boardDFS(board, row - 1, col, visited); // Up
-    boardDFS(board, row + 1, col, visited); // Down
-    boardDFS(board, row, col - 1, visited); // Left
-    boardDFS(board, row, col + 1, visited); // Right
+    memset(anchors->columns, 0, sizeof(anchors->columns));
+    for (int row = 0; row < BOARD_SIZE; row++) {
+        for (uint32_t cols = anchors->rows[row]; cols != 0; cols &= cols - 1) {
+            anchors->columns[__builtin_ctz(cols)] |= 1u << row;
+        }
+    }
 }
 
-/*---------- FUNCTION: isBoardConnected -----------------------------------
+/*---------- FUNCTION: packBoard -----------------------------------
 /   Function Description:
-/     Checks if all non-empty squares on the board are connected.
+/     Copies a board into the padded plane layout the move generator walks.
+/     The row-major and transposed planes each get the letters, the letter
+/     and word multipliers and the cross-check masks and scores of the plays
+/     that run along them, surrounded by a border of sentinel squares.
 /
 /   Caller Input:
 /     - Square board[BOARD_SIZE][BOARD_SIZE]: The game board.
+/     - PackedBoard *packed: Receives the packed copy.
 /
 /   Caller Output:
-/     - bool: True if the board is connected, false otherwise.
+/     - void: No return value.
 /
 /   Assumptions, Limitations, Known Bugs:
-/     - N/A
+/     - Square (row, col) is at (row + 1) * PADDED_SIZE + col + 1 in plane 1
+/       and at (col + 1) * PADDED_SIZE + row + 1 in plane 0.
 /---------------------------------------------------------*/
-bool isBoardConnected(Square board[BOARD_SIZE][BOARD_SIZE]) {
-
-    // Find the first non-empty square to start DFS
-    int startRow = -1, startCol = -1;
-    for (int i = 0; i < BOARD_SIZE; ++i) {
-        for (int j = 0; j < BOARD_SIZE; ++j) {
-            if (board[i][j].letter != ' ') {
-                startRow = i;
-                startCol = j;
-                break; // Found the start, exit inner loop
-            }
-        }
-        if (startRow != -1) {
-            break; // Found the start, exit outer loop
-        }
-    }
-
-    // If the board is empty, it's considered connected
-    if (startRow == -1) {
-        return true;
-    }
+void packBoard(Square board[BOARD_SIZE][BOARD_SIZE], PackedBoard *packed) {
 
-    // Allocate memory for the visited array
-    bool **visited = (bool **)malloc(BOARD_SIZE * sizeof(bool *));
-    for (int i = 0; i < BOARD_SIZE; ++i) {
-        visited[i] = (bool *)malloc(BOARD_SIZE * sizeof(bool));
-        memset(visited[i], false, BOARD_SIZE * sizeof(bool)); // Initialize to false
-    }
+    static const uint8_t letterMultipliers[5] = {1, 2, 3, 1, 1};
+    static const uint8_t wordMultipliers[5] = {1, 1, 1, 2, 3};
 
-    boardDFS(board, startRow, startCol, visited); // Start DFS from the first non-empty square
+    memset(packed->letter, BORDER_LETTER, sizeof(packed->letter));
+    memset(packed->letterMultiplier, 1, sizeof(packed->letterMultiplier));
+    memset(packed->wordMultiplier, 1, sizeof(packed->wordMultiplier));
+    memset(packed->crossCheck, 0, sizeof(packed->crossCheck));
+    memset(packed->crossScore, 0, sizeof(packed->crossScore));
 
-    // Check if all non-empty squares were visited
-    for (int i = 0; i < BOARD_SIZE; ++i) {
-        for (int j = 0; j < BOARD_SIZE; ++j) {
-            if (board[i][j].letter != ' ' && !visited[i][j]) {
-                // Free memory
-                for (int k = 0; k < BOARD_SIZE; k++) {
-                  free(visited[k]);
-                }
-                free(visited);
-                return false; // Found a disconnected square
+    for (int row = 0; row < BOARD_SIZE; row++) {
+        for (int col = 0; col < BOARD_SIZE; col++) {
+            const Square *square = &board[row][col];
+            int bonus = square->usedBonus ? 0 : square->bonus;
+            int index[2] = {(col + 1) * PADDED_SIZE + row + 1, (row + 1) * PADDED_SIZE + col + 1};
+
+            for (int plane = 0; plane < 2; plane++) {
+                packed->letter[plane][index[plane]] = square->letter;
+                packed->letterMultiplier[plane][index[plane]] = letterMultipliers[bonus];
+                packed->wordMultiplier[plane][index[plane]] = wordMultipliers[bonus];
+                packed->crossCheck[plane][index[plane]] = square->crossCheck[plane];
+                packed->crossScore[plane][index[plane]] = (uint16_t)square->crossScore[plane];
             }
         }
     }
+}
+
+/*---------- FUNCTION: isBoardConnected -----------------------------------
+/   Function Description:
+/     Checks if all non-empty squares on the board are connected. Starting
+/     from the first tile, the reached set is grown by its row and column
+/     neighbours, restricted to tiles, until it stops changing.
+/
+/   Caller Input:
+/     - Board *board: The game board.
+/
+/   Caller Output:
+/     - bool: True if the board is connected, false otherwise.
+/
+/   Assumptions, Limitations, Known Bugs:
+/     - An empty board is considered connected.
+/---------------------------------------------------------*/
+bool isBoardConnected(Board *board) {
+
+    const BoardBits *occupied = &board->occupied;
+    uint16_t reached[BOARD_SIZE] = {0};
 
-    // Free the memory.
-    for (int i = 0; i < BOARD_SIZE; i++) {
-        free(visited[i]);
+    // Seed the fill with the first tile
+    int startRow = 0;
+    while (startRow < BOARD_SIZE && occupied->rows[startRow] == 0) {
+        startRow++;
+    }
+    if (startRow == BOARD_SIZE) {
+        return true;
+    }
+    reached[startRow] = occupied->rows[startRow] & -occupied->rows[startRow];
+
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (int row = 0; row < BOARD_SIZE; row++) {
+            uint16_t above = row > 0 ? reached[row - 1] : 0;
+            uint16_t below = row < BOARD_SIZE - 1 ? reached[row + 1] : 0;
+            uint16_t grown = (reached[row] | (reached[row] << 1) | (reached[row] >> 1) | above | below) & occupied->rows[row];
+            changed |= grown != reached[row];
+            reached[row] = grown;
+        }
     }
-    free(visited);
 
-    return true; // All non-empty squares are connected
+    return memcmp(reached, occupied->rows, sizeof(reached)) == 0; // Every tile was reached
 }
 
 /*---------- FUNCTION: isBoardEmpty -----------------------------------
@@ -362,7 +885,7 @@ bool isBoardConnected(Square board[BOARD_SIZE][BOARD_SIZE]) {
 /     Checks if the game board is completely empty.
 /
 /   Caller Input:
-/     - Square board[BOARD_SIZE][BOARD_SIZE]: The game board.
+/     - Board *board: The game board.
 /
 /   Caller Output:
 /     - bool: True if the board is empty, false otherwise.
@@ -370,44 +893,64 @@ bool isBoardConnected(Square board[BOARD_SIZE][BOARD_SIZE]) {
 /   Assumptions, Limitations, Known Bugs:
 /     - N/A
 /---------------------------------------------------------*/
-bool isBoardEmpty(Square board[BOARD_SIZE][BOARD_SIZE]) {
+bool isBoardEmpty(Board *board) {
+
+    uint16_t any = 0;
 
     for (int row = 0; row < BOARD_SIZE; row++) {
-        for (int col = 0; col < BOARD_SIZE; col++) {
-            if (board[row][col].letter != ' ') {
-                return false;
-            }
-        }
+        any |= board->occupied.rows[row];
     }
-    return true;
+    return any == 0;
 }
 
-/*---------- FUNCTION: validateBoard -----------------------------------
+/*---------- FUNCTION: findBoardProblem -----------------------------------
 /   Function Description:
-/     Validates the game board, checking for emptiness, center square usage, and connectivity.
+/     Checks the game board for emptiness, center square usage, and connectivity.
 /
 /   Caller Input:
-/     - Square board[BOARD_SIZE][BOARD_SIZE]: The game board.
+/     - Board *board: The game board.
 /
 /   Caller Output:
-/     - bool: True if the board is valid, false otherwise.
+/     - const char *: Why the board is invalid, NULL if it is valid.
 /
 /   Assumptions, Limitations, Known Bugs:
-/     - N/A
+/     - Prints nothing, so it can be used where stdout carries other output.
 /---------------------------------------------------------*/
-bool validateBoard(Square board[BOARD_SIZE][BOARD_SIZE]) {
+const char *findBoardProblem(Board *board) {
 
     if (isBoardEmpty(board)) {
-        return true;
+        return NULL;
     }
 
-    if (board[CENTER][CENTER].letter == ' ' && !isBoardEmpty(board)) {
-        printf("Center square is not used!\n");
-        return false;
+    if (board->squares[CENTER][CENTER].letter == ' ') {
+        return "Center square is not used!";
     }
 
     if (!isBoardConnected(board)) {
-        printf("Board is not connected!\n");
+        return "Board is not connected!";
+    }
+
+    return NULL;
+}
+
+/*---------- FUNCTION: validateBoard -----------------------------------
+/   Function Description:
+/     Validates the game board, checking for emptiness, center square usage, and connectivity.
+/
+/   Caller Input:
+/     - Board *board: The game board.
+/
+/   Caller Output:
+/     - bool: True if the board is valid, false otherwise.
+/
+/   Assumptions, Limitations, Known Bugs:
+/     - Prints the problem of an invalid board (see findBoardProblem).
+/---------------------------------------------------------*/
+bool validateBoard(Board *board) {
+
+    const char *problem = findBoardProblem(board);
+    if (problem != NULL) {
+        printf("%s\n", problem);
         return false;
     }
 
@@ -442,62 +985,26 @@ void printBoard(Square board[BOARD_SIZE][BOARD_SIZE]) {
 /*---------- FUNCTION: checkValidPlacements -----------------------------------
 /   Function Description:
 /     Determines and marks valid placement positions on the board. 
-/     Valid placements are adjacent to existing tiles or the center square
-/     if the board is empty.
+/     Valid placements are the tiles, the squares adjacent to them and the
+/     center square if it is empty (see findAnchors).
 /
 /   Caller Input:
-/     - Square board[BOARD_SIZE][BOARD_SIZE]: The game board.
+/     - Board *board: The game board.
 /
 /   Caller Output:
 /     - void: No return value. Modifies the 'validPlacement' field of the board's squares.
 /
 /   Assumptions, Limitations, Known Bugs:
-/     - Uses changeValidPlacement to set individual valid placement flags.
+/     - N/A
 /---------------------------------------------------------*/
-static void checkValidPlacements(Square board[BOARD_SIZE][BOARD_SIZE]){
+static void checkValidPlacements(Board *board){
+
+    BoardBits anchors;
 
+    findAnchors(&board->occupied, &anchors);
     for(int row = 0; row < BOARD_SIZE; row++){
         for(int col = 0; col < BOARD_SIZE; col++){
-            if(board[row][col].letter != ' '){
-                changeValidPlacement(board, row, col);
-                board[row][col].validPlacement = true;
-            }
+            board->squares[row][col].validPlacement = (anchors.rows[row] >> col) & 1;
         }
     }
-
-    //If board is empty, center square is valid
-    if(board[BOARD_SIZE/2][BOARD_SIZE/2].letter == ' '){
-        board[BOARD_SIZE/2][BOARD_SIZE/2].validPlacement = true;
-    }
 }
-
-/*---------- FUNCTION: changeValidPlacement -----------------------------------
-/   Function Description:
-/     Marks adjacent empty squares as valid placement positions,
-/     relative to a given tile on the board.
-/
-/   Caller Input:
-/     - Square board[BOARD_SIZE][BOARD_SIZE]: The game board.
-/     - int row: Row index of the tile.
-/     - int col: Column index of the tile.
-/
-/   Caller Output:
-/     - void: No return value. Modifies the 'validPlacement' field of the board's squares.
-/
-/   Assumptions, Limitations, Known Bugs:
-/     - N/A
-/---------------------------------------------------------*/
-static void changeValidPlacement(Square board[BOARD_SIZE][BOARD_SIZE], int row, int col){
-    if(row + 1 < BOARD_SIZE && board[row+1][col].letter == ' '){
-        board[row +1][col].validPlacement = true;
-    }
-    if(row - 1 < BOARD_SIZE && board[row-1][col].letter == ' '){
-        board[row -1][col].validPlacement = true;
-    }
-    if(col + 1 < BOARD_SIZE && board[row][col+1].letter == ' '){
-        board[row][col +1].validPlacement = true;
-    }
-    if(col - 1 < BOARD_SIZE && board[row][col-1].letter == ' '){
-        board[row][col -1].validPlacement = true;
-    }
-}
\ No newline at end of file
@@ -5,7 +5,10 @@
 /   File Description:
 /     This header file defines data structures and function prototypes used in the
 /     Scrabble solver. It includes definitions for the TrieNode (for
-/     word validation), Square (for board representation), and Move (for storing
+/     word validation), Square (for board representation), BoardBits (an
+/     occupancy bitboard), Board (the squares with their occupancy),
+/     PackedBoard (the padded
+/     layout the move generator walks), and Move (for storing
 /     potential plays). It also declares constants for board dimensions,
 /     directions, and maximum characters.
 /
@@ -18,6 +21,8 @@
 #include <string.h>
 #include <ctype.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <pthread.h>
 
 #define MAX_CHARACTERS 26 //For our use case with the Trie this represents all letters A-Z
 #define BOARD_SIZE 15
@@ -28,6 +33,9 @@
 #define LEFT 2
 #define RIGHT 3
 
+#define CROSS_CHECK_ALL 0x03FFFFFFu // Every letter allowed (no perpendicular word is formed)
+#define CROSS_CHECK_INDEX(direction) ((direction) >> 1) // crossCheck entry for a play: 0 for UP/DOWN, 1 for LEFT/RIGHT
+
 // Trie Node Structure
 typedef struct TrieNode {
     char letter;             // The character stored in the node.
@@ -42,28 +50,95 @@ typedef struct Square {
     int bonus;             // Bonus type for this square (0: None, 1: Double Letter, 2: Triple Letter, 3: Double Word, 4: Triple Word).
     bool validPlacement;   // Flag indicating if a letter can be placed on this square.
     bool usedBonus;        // Flag indicating if the bonus has been used. (Used to remove squares used by the input board)
+    uint32_t crossCheck[2]; // Letters (bit i for 'A' + i) that form a word with the perpendicular neighbours, per play orientation.
+    int crossScore[2];     // Sum of the letter values of those perpendicular neighbours (0 if there are none).
 
 } Square;
 
+// Occupancy bitboard of a board
+typedef struct BoardBits {
+    uint16_t rows[BOARD_SIZE];    // Bit col of rows[row] is set if square (row, col) holds a tile.
+    uint16_t columns[BOARD_SIZE]; // Transposed copy: bit row of columns[col].
+} BoardBits;
+
+#define BOARD_ROW_BITS 0x7FFFu // The BOARD_SIZE bits of one row mask
+
+// Game board: the squares and their occupancy, which the board functions
+// (initBoard, setBoardLetters, setBoardTile) keep in sync
+typedef struct Board {
+    Square squares[BOARD_SIZE][BOARD_SIZE]; // Letters, bonuses, valid placements and cross-checks.
+    BoardBits occupied;                     // The squares holding a tile.
+} Board;
+
+#define BOARD_SQUARES (BOARD_SIZE * BOARD_SIZE)
+#define PADDED_SIZE (BOARD_SIZE + 2)              // Board width plus a sentinel square on each side
+#define PADDED_SQUARES (PADDED_SIZE * PADDED_SIZE)
+#define BORDER_LETTER '#'                         // Letter of the sentinel squares around the board
+#define PACKED_PLANE(direction) ((direction) >> 1) // Plane of a play: 0 (transposed) for UP/DOWN, 1 (row-major) for LEFT/RIGHT
+#define PACKED_STEP(direction) (((direction) & 1) ? 1 : -1) // Index step of a play inside its plane
+
+// Generator-facing copy of a board. Each plane stores the squares with a
+// sentinel border, row-major in plane 1 and transposed in plane 0, so a play
+// in any direction moves by +-1 inside its plane and stops at the border.
+typedef struct PackedBoard {
+    char letter[2][PADDED_SQUARES];               // ' ' empty, 'A'-'Z' tile, BORDER_LETTER outside the board.
+    uint8_t letterMultiplier[2][PADDED_SQUARES];  // 1, 2 or 3; 1 once the bonus is used and on the border.
+    uint8_t wordMultiplier[2][PADDED_SQUARES];    // 1, 2 or 3; 1 once the bonus is used and on the border.
+    uint32_t crossCheck[2][PADDED_SQUARES];       // Square crossCheck for plays in the plane; 0 on the border.
+    uint16_t crossScore[2][PADDED_SQUARES];       // Square crossScore for plays in the plane; 0 on the border.
+} PackedBoard;
+
 // Move Structure to store potential plays
 typedef struct Move {
     int row;                // Row where the word starts.
     int col;                // Column where the word starts.
-    int direction;          // Direction of the word (0: Horizontal, 1: Vertical).
+    int direction;          // Direction the word reads in from its first square (DOWN or RIGHT).
     char word[BOARD_SIZE+1];// The word being played. (Extra space for null terminator)
     int score;              // Score of the play.
-    bool isReversed;        // If the word is a reverse of a combination then this is set to true
 } Move;
 
 // Function prototypes
 TrieNode *createTrieNode(char letter);
 void insertWord(TrieNode *root, const char *word);
+void insertWordAlongPath(TrieNode *root, TrieNode *path[], const char *word, int length, int sharedLength);
+void insertReversedWord(TrieNode *root, const char *word);
+TrieNode *buildTrieParallel(char (*words)[BOARD_SIZE + 1], size_t totalWords, int threads);
 void freeTrie(TrieNode *node);
 int searchWord(TrieNode *root, const char *word);
+int searchReversedWord(TrieNode *root, const char *letters);
+TrieNode *reverseTrieRoot(TrieNode *root);
+size_t trieMemoryUsage(TrieNode *root, size_t *reverseBytes);
 
 void printBoard(Square board[BOARD_SIZE][BOARD_SIZE]);
-void loadBoard(Square board[BOARD_SIZE][BOARD_SIZE], const char *filename);
-void initBoard(Square board[BOARD_SIZE][BOARD_SIZE]);
-bool validateBoard(Square board[BOARD_SIZE][BOARD_SIZE]);
+void loadBoard(Board *board, const char *filename);
+void setBoardLetters(Board *board, const char *letters);
+void initBoard(Board *board);
+bool validateBoard(Board *board);
+const char *findBoardProblem(Board *board);
+void setBoardTile(Board *board, int row, int col, char letter);
+void findAnchors(const BoardBits *occupied, BoardBits *anchors);
+void packBoard(Square board[BOARD_SIZE][BOARD_SIZE], PackedBoard *packed);
+
+/*---------- FUNCTION: trieChild -----------------------------------
+/   Function Description:
+/     Moves a Trie cursor one letter further. Works the same on the forward
+/     Trie and on the reverse Trie returned by reverseTrieRoot.
+/   Caller Input:
+/     - TrieNode *node: The current Trie node.
+/     - char letter: The next letter.
+/   Caller Output:
+/     - TrieNode *: The child node, or NULL if no word continues with the letter.
+/   Assumptions, Limitations, Known Bugs:
+/     - Letters outside A-Z never have a child.
+/---------------------------------------------------------*/
+static inline TrieNode *trieChild(TrieNode *node, char letter)
+{
+    int index = letter - 'A';
+    if (index < 0 || index >= MAX_CHARACTERS)
+    {
+        return NULL;
+    }
+    return node->children[index];
+}
 
 #endif
\ No newline at end of file
@@ -0,0 +1,428 @@
+/*---------- ID HEADER -------------------------------------
+/   Author(s):    Aidan Andrews, Kyle Scidmore
+/   File Name:    dawg.c
+/
+/   File Description:
+/     This file builds, searches and frees the minimised DAWG. Construction
+/     uses incremental minimisation over a sorted word list: only the nodes
+/     of the previous word that are not shared with the current one can
+/     still change, so as soon as a word diverges from the previous one those
+/     nodes are frozen and replaced by an identical node that already exists
+/     (found through a hash table), or registered as a new one.
+/
+/---------------------------------------------------------*/
+#include "dawg.h"
+
+// A node of the previous word that has not been registered yet
+typedef struct PendingNode {
+    uint32_t childMask;                 // Letters with an edge, plus DAWG_WORD_FLAG.
+    uint32_t children[MAX_CHARACTERS];  // Registered child for every letter in childMask.
+} PendingNode;
+
+struct DawgBuilder {
+    Dawg *dawg;                                 // Graph being built.
+    uint32_t nodeCapacity;
+    uint32_t edgeCapacity;
+    uint32_t *table;                            // Hash set of registered node indices (0 = empty slot).
+    uint32_t tableSize;                         // Always a power of two.
+    PendingNode path[BOARD_SIZE + 1];           // path[0] is the root, path[d] follows previousWord[d - 1].
+    char previousWord[BOARD_SIZE + 1];
+    int previousLength;
+};
+
+//Prototypes
+static uint32_t hashNode(uint32_t childMask, const uint32_t *children);
+static void growTable(DawgBuilder *builder);
+static uint32_t registerNode(DawgBuilder *builder, const PendingNode *pending);
+static void minimise(DawgBuilder *builder, int depth);
+
+/*---------- FUNCTION: createDawgBuilder -----------------------------------
+/   Function Description:
+/     Creates a builder for a new, empty DAWG.
+/
+/   Caller Input:
+/     - void
+/
+/   Caller Output:
+/     - DawgBuilder *: The builder. Feed it with addDawgWord, then call finishDawg.
+/
+/   Assumptions, Limitations, Known Bugs:
+/     - Exits the program on allocation failure.
+/---------------------------------------------------------*/
+DawgBuilder *createDawgBuilder(void)
+{
+    DawgBuilder *builder = calloc(1, sizeof(DawgBuilder));
+    Dawg *dawg = calloc(1, sizeof(Dawg));
+    if (builder == NULL || dawg == NULL)
+    {
+        perror("Failed to allocate memory");
+        exit(1);
+    }
+
+    builder->dawg = dawg;
+    builder->nodeCapacity = 1024;
+    builder->edgeCapacity = 1024;
+    builder->tableSize = 2048;
+    dawg->nodes = malloc(builder->nodeCapacity * sizeof(DawgNode));
+    dawg->edges = malloc(builder->edgeCapacity * sizeof(uint32_t));
+    builder->table = calloc(builder->tableSize, sizeof(uint32_t));
+    if (dawg->nodes == NULL || dawg->edges == NULL || builder->table == NULL)
+    {
+        perror("Failed to allocate memory");
+        exit(1);
+    }
+
+    // Node 0 is the sentinel that DAWG_NONE refers to
+    dawg->nodes[0].childMask = 0;
+    dawg->nodes[0].firstEdge = 0;
+    dawg->totalNodes = 1;
+
+    return builder;
+}
+
+/*---------- FUNCTION: hashNode -----------------------------------
+/   Function Description:
+/     Hashes a node by its word flag, letters and children, which is
+/     everything that makes two nodes interchangeable.
+/
+/   Caller Input:
+/     - uint32_t childMask: Letters with an edge, plus DAWG_WORD_FLAG.
+/     - const uint32_t *children: Child indices, in letter order.
+/
+/   Caller Output:
+/     - uint32_t: The hash value.
+/
+/   Assumptions, Limitations, Known Bugs:
+/     - N/A
+/---------------------------------------------------------*/
+static uint32_t hashNode(uint32_t childMask, const uint32_t *children)
+{
+    uint32_t hash = 2166136261u ^ childMask;
+    int totalChildren = __builtin_popcount(childMask & DAWG_LETTER_BITS);
+
+    for (int i = 0; i < totalChildren; i++)
+    {
+        hash = (hash ^ children[i]) * 16777619u;
+    }
+    return hash ^ (hash >> 15);
+}
+
+/*---------- FUNCTION: growTable -----------------------------------
+/   Function Description:
+/     Doubles the hash table of registered nodes and re-inserts every node.
+/
+/   Caller Input:
+/     - DawgBuilder *builder: The builder.
+/
+/   Caller Output:
+/     - void: No return value.
+/
+/   Assumptions, Limitations, Known Bugs:
+/     - Exits the program on allocation failure.
+/---------------------------------------------------------*/
+static void growTable(DawgBuilder *builder)
+{
+    Dawg *dawg = builder->dawg;
+    uint32_t newSize = builder->tableSize * 2;
+    uint32_t *table = calloc(newSize, sizeof(uint32_t));
+    if (table == NULL)
+    {
+        perror("Failed to allocate memory");
+        exit(1);
+    }
+
+    for (uint32_t node = 1; node < dawg->totalNodes; node++)
+    {
+        uint32_t slot = hashNode(dawg->nodes[node].childMask, dawg->edges + dawg->nodes[node].firstEdge) & (newSize - 1);
+        while (table[slot] != 0)
+        {
+            slot = (slot + 1) & (newSize - 1);
+        }
+        table[slot] = node;
+    }
+
+    free(builder->table);
+    builder->table = table;
+    builder->tableSize = newSize;
+}
+
+/*---------- FUNCTION: registerNode -----------------------------------
+/   Function Description:
+/     Returns the index of a registered node identical to a pending one,
+/     registering the pending node first if there is none.
+/
+/   Caller Input:
+/     - DawgBuilder *builder: The builder.
+/     - const PendingNode *pending: The node to register.
+/
+/   Caller Output:
+/     - uint32_t: Index of the equivalent registered node.
+/
+/   Assumptions, Limitations, Known Bugs:
+/     - All children of the pending node must already be registered.
+/     - Exits the program on allocation failure.
+/---------------------------------------------------------*/
+static uint32_t registerNode(DawgBuilder *builder, const PendingNode *pending)
+{
+    Dawg *dawg = builder->dawg;
+    uint32_t children[MAX_CHARACTERS];
+    int totalChildren = 0;
+
+    for (int i = 0; i < MAX_CHARACTERS; i++)
+    {
+        if (pending->childMask & (1u << i))
+        {
+            children[totalChildren++] = pending->children[i];
+        }
+    }
+
+    uint32_t slot = hashNode(pending->childMask, children) & (builder->tableSize - 1);
+    while (builder->table[slot] != 0)
+    {
+        uint32_t candidate = builder->table[slot];
+        if (dawg->nodes[candidate].childMask == pending->childMask &&
+            memcmp(dawg->edges + dawg->nodes[candidate].firstEdge, children, totalChildren * sizeof(uint32_t)) == 0)
+        {
+            return candidate;
+        }
+        slot = (slot + 1) & (builder->tableSize - 1);
+    }
+
+    if (dawg->totalNodes == builder->nodeCapacity)
+    {
+        builder->nodeCapacity *= 2;
+        dawg->nodes = realloc(dawg->nodes, builder->nodeCapacity * sizeof(DawgNode));
+    }
+    if (dawg->totalEdges + totalChildren > builder->edgeCapacity)
+    {
+        builder->edgeCapacity *= 2;
+        dawg->edges = realloc(dawg->edges, builder->edgeCapacity * sizeof(uint32_t));
+    }
+    if (dawg->nodes == NULL || dawg->edges == NULL)
+    {
+        perror("Failed to allocate memory");
+        exit(1);
+    }
+
+    uint32_t node = dawg->totalNodes++;
+    dawg->nodes[node].childMask = pending->childMask;
+    dawg->nodes[node].firstEdge = dawg->totalEdges;
+    memcpy(dawg->edges + dawg->totalEdges, children, totalChildren * sizeof(uint32_t));
+    dawg->totalEdges += totalChildren;
+    builder->table[slot] = node;
+
+    if (dawg->totalNodes * 2 > builder->tableSize)
+    {
+        growTable(builder);
+    }
+    return node;
+}
+
+/*---------- FUNCTION: minimise -----------------------------------
+/   Function Description:
+/     Registers the pending nodes of the previous word deeper than a given
+/     depth, deepest first, and links each one into its parent.
+/
+/   Caller Input:
+/     - DawgBuilder *builder: The builder.
+/     - int depth: Nodes at this depth and above stay pending.
+/
+/   Caller Output:
+/     - void: No return value.
+/
+/   Assumptions, Limitations, Known Bugs:
+/     - N/A
+/---------------------------------------------------------*/
+static void minimise(DawgBuilder *builder, int depth)
+{
+    for (int d = builder->previousLength; d > depth; d--)
+    {
+        int letter = builder->previousWord[d - 1] - 'A';
+        builder->path[d - 1].children[letter] = registerNode(builder, &builder->path[d]);
+    }
+    builder->previousLength = depth;
+}
+
+/*---------- FUNCTION: addDawgWord -----------------------------------
+/   Function Description:
+/     Adds the next word to the DAWG being built.
+/
+/   Caller Input:
+/     - DawgBuilder *builder: The builder.
+/     - const char *word: The word to add.
+/
+/   Caller Output:
+/     - bool: False if the word was rejected because it is not in sorted
+/       order, is longer than BOARD_SIZE or is not made of A-Z; true otherwise.
+/
+/   Assumptions, Limitations, Known Bugs:
+/     - Words must be added in strictly increasing strcmp order; a repeat of
+/       the previous word is ignored.
+/---------------------------------------------------------*/
+bool addDawgWord(DawgBuilder *builder, const char *word)
+{
+    int length = strlen(word);
+    if (length == 0 || length > BOARD_SIZE)
+    {
+        return false;
+    }
+    for (int i = 0; i < length; i++)
+    {
+        if (word[i] < 'A' || word[i] > 'Z')
+        {
+            return false;
+        }
+    }
+
+    builder->previousWord[builder->previousLength] = '\0';
+    int order = strcmp(word, builder->previousWord);
+    if (order == 0 && builder->dawg->totalWords > 0)
+    {
+        return true;
+    }
+    if (order < 0)
+    {
+        return false;
+    }
+
+    int common = 0;
+    while (common < builder->previousLength && word[common] == builder->previousWord[common])
+    {
+        common++;
+    }
+    minimise(builder, common);
+
+    for (int d = common + 1; d <= length; d++)
+    {
+        builder->path[d].childMask = 0;
+        builder->path[d - 1].childMask |= 1u << (word[d - 1] - 'A');
+    }
+    builder->path[length].childMask |= DAWG_WORD_FLAG;
+
+    memcpy(builder->previousWord, word, length);
+    builder->previousLength = length;
+    builder->dawg->totalWords++;
+    return true;
+}
+
+/*---------- FUNCTION: finishDawg -----------------------------------
+/   Function Description:
+/     Registers the remaining nodes, frees the builder and returns the DAWG.
+/
+/   Caller Input:
+/     - DawgBuilder *builder: The builder; it must not be used afterwards.
+/
+/   Caller Output:
+/     - Dawg *: The finished DAWG. Release with freeDawg.
+/
+/   Assumptions, Limitations, Known Bugs:
+/     - The node and edge arrays are trimmed to their final size.
+/---------------------------------------------------------*/
+Dawg *finishDawg(DawgBuilder *builder)
+{
+    Dawg *dawg = builder->dawg;
+
+    minimise(builder, 0);
+    dawg->root = registerNode(builder, &builder->path[0]);
+
+    DawgNode *nodes = realloc(dawg->nodes, dawg->totalNodes * sizeof(DawgNode));
+    uint32_t *edges = realloc(dawg->edges, (dawg->totalEdges + 1) * sizeof(uint32_t));
+    if (nodes != NULL)
+    {
+        dawg->nodes = nodes;
+    }
+    if (edges != NULL)
+    {
+        dawg->edges = edges;
+    }
+
+    free(builder->table);
+    free(builder);
+    return dawg;
+}
+
+/*---------- FUNCTION: freeDawg -----------------------------------
+/   Function Description:
+/     Frees the memory allocated for the DAWG, or unmaps the image it was
+/     loaded from.
+/
+/   Caller Input:
+/     - Dawg *dawg: The DAWG to free.
+/
+/   Caller Output:
+/     - void: No return value.
+/
+/   Assumptions, Limitations, Known Bugs:
+/     - N/A
+/---------------------------------------------------------*/
+void freeDawg(Dawg *dawg)
+{
+    if (dawg == NULL)
+    {
+        return;
+    }
+    if (dawg->mapping != NULL)
+    {
+        munmap(dawg->mapping, dawg->mappingSize);
+    }
+    else
+    {
+        free(dawg->nodes);
+        free(dawg->edges);
+    }
+    free(dawg);
+}
+
+/*---------- FUNCTION: searchDawg -----------------------------------
+/   Function Description:
+/     Searches for a word in the DAWG.
+/
+/   Caller Input:
+/     - const Dawg *dawg: The DAWG.
+/     - const char *word: The word to be searched for.
+/
+/   Caller Output:
+/     - int: 1 if the word is found, 0 otherwise.
+/
+/   Assumptions, Limitations, Known Bugs:
+/     - Assumes the word consists of uppercase letters.
+/---------------------------------------------------------*/
+int searchDawg(const Dawg *dawg, const char *word)
+{
+    uint32_t current = dawg->root;
+
+    while (*word)
+    {
+        int index = *word - 'A';
+        if (index < 0 || index >= MAX_CHARACTERS)
+        {
+            return 0;
+        }
+        current = dawgChild(dawg, current, index);
+        if (current == DAWG_NONE)
+        {
+            return 0;
+        }
+        word++;
+    }
+
+    return (dawg->nodes[current].childMask & DAWG_WORD_FLAG) != 0;
+}
+
+/*---------- FUNCTION: dawgMemoryUsage -----------------------------------
+/   Function Description:
+/     Reports how many bytes the DAWG occupies.
+/
+/   Caller Input:
+/     - const Dawg *dawg: The DAWG.
+/
+/   Caller Output:
+/     - size_t: Size of the node and edge arrays plus the header.
+/
+/   Assumptions, Limitations, Known Bugs:
+/     - N/A
+/---------------------------------------------------------*/
+size_t dawgMemoryUsage(const Dawg *dawg)
+{
+    return sizeof(Dawg) + dawg->totalNodes * sizeof(DawgNode) + dawg->totalEdges * sizeof(uint32_t);
+}
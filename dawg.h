@@ -0,0 +1,84 @@
+/*---------- ID HEADER -------------------------------------
+/   Author(s):    Aidan Andrews, Kyle Scidmore
+/   File Name:    dawg.h
+/
+/   File Description:
+/     This header file defines the minimised DAWG (directed acyclic word
+/     graph) dictionary backend. Words that share a suffix share the nodes
+/     for it, so the graph is a small fraction of the size of the Trie.
+/     Nodes and edges are stored in two flat arrays addressed with 32-bit
+/     indices: each node holds a bitmask of the letters it has edges for and
+/     the position of its first edge, and the edge for a letter is found by
+/     counting the mask bits below it.
+/
+/---------------------------------------------------------*/
+#ifndef DAWG_H
+#define DAWG_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#include "dataStruct.h"
+
+#define DAWG_NONE 0                 // Node index meaning "no node" (node 0 is an unused sentinel)
+#define DAWG_WORD_FLAG 0x80000000u  // Set in childMask when a complete word ends at the node
+#define DAWG_LETTER_BITS 0x03FFFFFFu // The 26 letter bits of childMask
+
+// DAWG Node Structure (8 bytes)
+typedef struct DawgNode {
+    uint32_t childMask;     // Bit i set if an edge for letter 'A' + i leaves this node, plus DAWG_WORD_FLAG.
+    uint32_t firstEdge;     // Index in the edge array of the edge for the lowest letter in childMask.
+} DawgNode;
+
+// DAWG Structure
+typedef struct Dawg {
+    DawgNode *nodes;        // Node array.
+    uint32_t *edges;        // Target node of every edge, grouped by source node and ordered by letter.
+    uint32_t totalNodes;
+    uint32_t totalEdges;
+    uint32_t totalWords;
+    uint32_t root;          // Index of the root node.
+    void *mapping;          // Mapped image backing nodes and edges, NULL if they were allocated.
+    size_t mappingSize;     // Length of the mapping.
+} Dawg;
+
+// Incremental builder state (opaque outside dawg.c)
+typedef struct DawgBuilder DawgBuilder;
+
+// Function prototypes
+DawgBuilder *createDawgBuilder(void);
+bool addDawgWord(DawgBuilder *builder, const char *word);
+Dawg *finishDawg(DawgBuilder *builder);
+void freeDawg(Dawg *dawg);
+int searchDawg(const Dawg *dawg, const char *word);
+size_t dawgMemoryUsage(const Dawg *dawg);
+
+/*---------- FUNCTION: dawgChild -----------------------------------
+/   Function Description:
+/     Returns the node reached from a DAWG node by a letter.
+/   Caller Input:
+/     - const Dawg *dawg: The DAWG.
+/     - uint32_t node: Index of the current node.
+/     - int letterIndex: The letter as an index from 0 ('A') to 25 ('Z').
+/   Caller Output:
+/     - uint32_t: Index of the child, DAWG_NONE if there is no edge.
+/   Assumptions, Limitations, Known Bugs:
+/     - letterIndex must be in range.
+/---------------------------------------------------------*/
+static inline uint32_t dawgChild(const Dawg *dawg, uint32_t node, int letterIndex)
+{
+    uint32_t bit = 1u << letterIndex;
+    uint32_t mask = dawg->nodes[node].childMask;
+
+    if (!(mask & bit))
+    {
+        return DAWG_NONE;
+    }
+    return dawg->edges[dawg->nodes[node].firstEdge + __builtin_popcount(mask & (bit - 1))];
+}
+
+#endif
@@ -0,0 +1,306 @@
+/*---------- ID HEADER -------------------------------------
+/   Author(s):    Aidan Andrews, Kyle Scidmore
+/   File Name:    dawgImage.c
+/
+/   File Description:
+/     This file writes a DAWG to a binary image and maps such an image back
+/     read-only. Mapping only checks the header and the checksum; no node is
+/     copied or rebuilt, so a mapped dictionary is ready to use as soon as
+/     the call returns.
+/
+/---------------------------------------------------------*/
+#include "dawgImage.h"
+
+//Prototypes
+static uint32_t updateChecksum(uint32_t hash, const void *data, size_t size);
+static bool rejectImage(const char *filename, const char *reason);
+static bool writeAll(FILE *file, const void *data, size_t size);
+
+/*---------- FUNCTION: updateChecksum -----------------------------------
+/   Function Description:
+/     Feeds a block of bytes into an FNV-1a checksum, four bytes at a time.
+/
+/   Caller Input:
+/     - uint32_t hash: The checksum so far.
+/     - const void *data: The bytes to add.
+/     - size_t size: Number of bytes.
+/
+/   Caller Output:
+/     - uint32_t: The updated checksum.
+/
+/   Assumptions, Limitations, Known Bugs:
+/     - Blocks must be a multiple of four bytes long, except for the last one,
+/       for the result not to depend on how the data was split.
+/---------------------------------------------------------*/
+static uint32_t updateChecksum(uint32_t hash, const void *data, size_t size)
+{
+    const unsigned char *bytes = data;
+    size_t i = 0;
+
+    for (; i + 4 <= size; i += 4)
+    {
+        uint32_t word;
+        memcpy(&word, bytes + i, sizeof(word));
+        hash = (hash ^ word) * 16777619u;
+    }
+    for (; i < size; i++)
+    {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+/*---------- FUNCTION: dawgImageChecksum -----------------------------------
+/   Function Description:
+/     Computes the checksum used to detect damaged or partially written
+/     images.
+/
+/   Caller Input:
+/     - const void *data: The bytes to checksum.
+/     - size_t size: Number of bytes.
+/
+/   Caller Output:
+/     - uint32_t: The checksum.
+/
+/   Assumptions, Limitations, Known Bugs:
+/     - Detects accidental damage only, not deliberate tampering.
+/---------------------------------------------------------*/
+uint32_t dawgImageChecksum(const void *data, size_t size)
+{
+    return updateChecksum(DAWG_IMAGE_CHECKSUM_SEED, data, size);
+}
+
+/*---------- FUNCTION: writeAll -----------------------------------
+/   Function Description:
+/     Writes a block of bytes to a file.
+/
+/   Caller Input:
+/     - FILE *file: The open file.
+/     - const void *data: The bytes to write.
+/     - size_t size: Number of bytes.
+/
+/   Caller Output:
+/     - bool: True if every byte was written.
+/
+/   Assumptions, Limitations, Known Bugs:
+/     - N/A
+/---------------------------------------------------------*/
+static bool writeAll(FILE *file, const void *data, size_t size)
+{
+    return size == 0 || fwrite(data, 1, size, file) == size;
+}
+
+/*---------- FUNCTION: saveDawgImage -----------------------------------
+/   Function Description:
+/     Writes a DAWG to an image file. The image is written to a temporary
+/     file first and then renamed over the target, so processes that still
+/     have the old image mapped keep a consistent copy.
+/
+/   Caller Input:
+/     - const Dawg *dawg: The DAWG to write.
+/     - const char *filename: Path of the image to create or replace.
+/
+/   Caller Output:
+/     - bool: True if the image was written.
+/
+/   Assumptions, Limitations, Known Bugs:
+/     - Prints the reason to stderr on failure.
+/---------------------------------------------------------*/
+bool saveDawgImage(const Dawg *dawg, const char *filename)
+{
+    DawgImageHeader header;
+    size_t nodesSize = (size_t)dawg->totalNodes * sizeof(DawgNode);
+    size_t edgesSize = (size_t)dawg->totalEdges * sizeof(uint32_t);
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, DAWG_IMAGE_MAGIC, sizeof(header.magic));
+    header.version = DAWG_IMAGE_VERSION;
+    header.byteOrder = DAWG_IMAGE_BYTE_ORDER;
+    memcpy(header.alphabet, DAWG_IMAGE_ALPHABET, strlen(DAWG_IMAGE_ALPHABET));
+    header.totalWords = dawg->totalWords;
+    header.totalNodes = dawg->totalNodes;
+    header.totalEdges = dawg->totalEdges;
+    header.root = dawg->root;
+    header.nodesOffset = sizeof(DawgImageHeader);
+    header.edgesOffset = header.nodesOffset + nodesSize;
+
+    // Node records are 8 bytes, so checksumming the arrays one after the other
+    // gives the same result as checksumming the payload of the file
+    header.checksum = updateChecksum(updateChecksum(DAWG_IMAGE_CHECKSUM_SEED, dawg->nodes, nodesSize), dawg->edges, edgesSize);
+
+    char temporaryName[4096];
+    snprintf(temporaryName, sizeof(temporaryName), "%s.tmp", filename);
+
+    FILE *file = fopen(temporaryName, "wb");
+    if (file == NULL)
+    {
+        perror("Failed to create dictionary image");
+        return false;
+    }
+
+    bool written = writeAll(file, &header, sizeof(header)) && writeAll(file, dawg->nodes, nodesSize) && writeAll(file, dawg->edges, edgesSize);
+    if (fclose(file) != 0 || !written)
+    {
+        perror("Failed to write dictionary image");
+        remove(temporaryName);
+        return false;
+    }
+
+    if (rename(temporaryName, filename) != 0)
+    {
+        perror("Failed to replace dictionary image");
+        remove(temporaryName);
+        return false;
+    }
+    return true;
+}
+
+/*---------- FUNCTION: rejectImage -----------------------------------
+/   Function Description:
+/     Reports why an image cannot be used.
+/
+/   Caller Input:
+/     - const char *filename: Path of the image.
+/     - const char *reason: Short description of the problem.
+/
+/   Caller Output:
+/     - bool: Always false, so callers can return the result directly.
+/
+/   Assumptions, Limitations, Known Bugs:
+/     - N/A
+/---------------------------------------------------------*/
+static bool rejectImage(const char *filename, const char *reason)
+{
+    fprintf(stderr, "Rejected dictionary image %s: %s, rebuild it with --compile\n", filename, reason);
+    return false;
+}
+
+/*---------- FUNCTION: isDawgImage -----------------------------------
+/   Function Description:
+/     Checks if a file starts with the image magic, as opposed to being a
+/     text word list.
+/
+/   Caller Input:
+/     - const char *filename: Path of the file.
+/
+/   Caller Output:
+/     - bool: True if the file looks like an image (it may still be stale).
+/
+/   Assumptions, Limitations, Known Bugs:
+/     - Returns false for files that cannot be read.
+/---------------------------------------------------------*/
+bool isDawgImage(const char *filename)
+{
+    char magic[sizeof(DAWG_IMAGE_MAGIC) - 1];
+    FILE *file = fopen(filename, "rb");
+    if (file == NULL)
+    {
+        return false;
+    }
+
+    bool matches = fread(magic, 1, sizeof(magic), file) == sizeof(magic) && memcmp(magic, DAWG_IMAGE_MAGIC, sizeof(magic)) == 0;
+    fclose(file);
+    return matches;
+}
+
+/*---------- FUNCTION: mapDawgImage -----------------------------------
+/   Function Description:
+/     Maps an image file read-only and returns a DAWG whose node and edge
+/     arrays point straight into the mapping.
+/
+/   Caller Input:
+/     - const char *filename: Path of the image.
+/
+/   Caller Output:
+/     - Dawg *: The mapped DAWG, or NULL if the image could not be mapped or
+/       was written by another version, byte order or alphabet, or is damaged.
+/       Release with freeDawg, which unmaps the file.
+/
+/   Assumptions, Limitations, Known Bugs:
+/     - The arrays are read-only; writing to them crashes the program.
+/     - Prints the reason to stderr when an image is rejected.
+/---------------------------------------------------------*/
+Dawg *mapDawgImage(const char *filename)
+{
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0)
+    {
+        perror("Failed to open dictionary image");
+        return NULL;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(DawgImageHeader))
+    {
+        close(fd);
+        rejectImage(filename, "file too short");
+        return NULL;
+    }
+
+    size_t size = (size_t)info.st_size;
+    void *mapping = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED)
+    {
+        perror("Failed to map dictionary image");
+        return NULL;
+    }
+
+    const DawgImageHeader *header = mapping;
+    const unsigned char *base = mapping;
+    bool valid = false;
+    size_t nodesSize = (size_t)header->totalNodes * sizeof(DawgNode);
+    size_t edgesSize = (size_t)header->totalEdges * sizeof(uint32_t);
+    char alphabet[sizeof(header->alphabet)] = DAWG_IMAGE_ALPHABET;
+
+    if (memcmp(header->magic, DAWG_IMAGE_MAGIC, sizeof(header->magic)) != 0)
+    {
+        rejectImage(filename, "not a dictionary image");
+    }
+    else if (header->byteOrder != DAWG_IMAGE_BYTE_ORDER)
+    {
+        rejectImage(filename, "written on a machine with a different byte order");
+    }
+    else if (header->version != DAWG_IMAGE_VERSION)
+    {
+        rejectImage(filename, "written by a different version");
+    }
+    else if (memcmp(header->alphabet, alphabet, sizeof(alphabet)) != 0)
+    {
+        rejectImage(filename, "built for a different alphabet");
+    }
+    else if (header->nodesOffset != sizeof(DawgImageHeader) || header->edgesOffset != header->nodesOffset + nodesSize || header->edgesOffset + edgesSize != size || header->totalNodes == 0 || header->root >= header->totalNodes)
+    {
+        rejectImage(filename, "inconsistent sizes");
+    }
+    else if (dawgImageChecksum(base + header->nodesOffset, nodesSize + edgesSize) != header->checksum)
+    {
+        rejectImage(filename, "checksum mismatch");
+    }
+    else
+    {
+        valid = true;
+    }
+
+    if (!valid)
+    {
+        munmap(mapping, size);
+        return NULL;
+    }
+
+    Dawg *dawg = malloc(sizeof(Dawg));
+    if (dawg == NULL)
+    {
+        perror("Failed to allocate memory");
+        exit(1);
+    }
+    dawg->nodes = (DawgNode *)(base + header->nodesOffset);
+    dawg->edges = (uint32_t *)(base + header->edgesOffset);
+    dawg->totalNodes = header->totalNodes;
+    dawg->totalEdges = header->totalEdges;
+    dawg->totalWords = header->totalWords;
+    dawg->root = header->root;
+    dawg->mapping = mapping;
+    dawg->mappingSize = size;
+    return dawg;
+}
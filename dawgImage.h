@@ -0,0 +1,60 @@
+/*---------- ID HEADER -------------------------------------
+/   Author(s):    Aidan Andrews, Kyle Scidmore
+/   File Name:    dawgImage.h
+/
+/   File Description:
+/     This header file defines the precompiled dictionary image: a DAWG
+/     written to disk exactly as it is laid out in memory. The node and edge
+/     arrays only refer to each other by index, so the file can be mapped
+/     read-only and used in place, and every solver process mapping the same
+/     image shares its pages.
+/
+/     Layout: a DawgImageHeader, the node array at nodesOffset and the edge
+/     array at edgesOffset, both 8-byte aligned. All values are stored in the
+/     byte order of the machine that wrote the image; images from a machine
+/     with a different byte order are rejected.
+/
+/---------------------------------------------------------*/
+#ifndef DAWGIMAGE_H
+#define DAWGIMAGE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "dawg.h"
+
+#define DAWG_IMAGE_MAGIC "SCRBDAWG"                     // First 8 bytes of every image
+#define DAWG_IMAGE_VERSION 1                            // Bump whenever the layout changes
+#define DAWG_IMAGE_BYTE_ORDER 0x01020304u               // Reads back differently on a foreign byte order
+#define DAWG_IMAGE_CHECKSUM_SEED 2166136261u            // FNV-1a offset basis
+#define DAWG_IMAGE_ALPHABET "ABCDEFGHIJKLMNOPQRSTUVWXYZ" // Letter i of childMask is DAWG_IMAGE_ALPHABET[i]
+
+// Image Header Structure (72 bytes, so the node array that follows stays 8-byte aligned)
+typedef struct DawgImageHeader {
+    char magic[8];          // DAWG_IMAGE_MAGIC, not null terminated.
+    uint32_t version;       // DAWG_IMAGE_VERSION of the writer.
+    uint32_t byteOrder;     // DAWG_IMAGE_BYTE_ORDER as written by the writer.
+    char alphabet[28];      // DAWG_IMAGE_ALPHABET, null padded.
+    uint32_t totalWords;
+    uint32_t totalNodes;
+    uint32_t totalEdges;
+    uint32_t root;          // Index of the root node.
+    uint32_t nodesOffset;   // Byte offset of the node array from the start of the file.
+    uint32_t edgesOffset;   // Byte offset of the edge array from the start of the file.
+    uint32_t checksum;      // dawgImageChecksum of everything after the header.
+} DawgImageHeader;
+
+// Function prototypes
+bool saveDawgImage(const Dawg *dawg, const char *filename);
+Dawg *mapDawgImage(const char *filename);
+bool isDawgImage(const char *filename);
+uint32_t dawgImageChecksum(const void *data, size_t size);
+
+#endif
@@ -0,0 +1,68 @@
+/*---------- ID HEADER -------------------------------------
+/   Author(s):    Aidan Andrews, Kyle Scidmore
+/   File Name:    dictionary.c
+/
+/   File Description:
+/     This file implements the backend-independent Dictionary functions:
+/     word lookup through the cursor interface and freeing every structure a
+/     Dictionary holds.
+/
+/---------------------------------------------------------*/
+#include "dictionary.h"
+
+/*---------- FUNCTION: dictionarySearchWord -----------------------------------
+/   Function Description:
+/     Searches for a word in the forward structure of the dictionary.
+/
+/   Caller Input:
+/     - const Dictionary *dictionary: The dictionary.
+/     - const char *word: The word to be searched for.
+/
+/   Caller Output:
+/     - int: 1 if the word is found, 0 otherwise.
+/
+/   Assumptions, Limitations, Known Bugs:
+/     - Assumes the word consists of uppercase letters.
+/---------------------------------------------------------*/
+int dictionarySearchWord(const Dictionary *dictionary, const char *word)
+{
+    DictCursor cursor = dictionaryRoot(dictionary);
+
+    while (*word)
+    {
+        cursor = dictionaryChild(dictionary, cursor, *word);
+        if (cursor == DICT_CURSOR_NONE)
+        {
+            return 0;
+        }
+        word++;
+    }
+
+    return dictionaryIsWord(dictionary, cursor);
+}
+
+/*---------- FUNCTION: freeDictionary -----------------------------------
+/   Function Description:
+/     Frees every structure held by a Dictionary and the Dictionary itself.
+/
+/   Caller Input:
+/     - Dictionary *dictionary: The dictionary to free.
+/
+/   Caller Output:
+/     - void: No return value.
+/
+/   Assumptions, Limitations, Known Bugs:
+/     - N/A
+/---------------------------------------------------------*/
+void freeDictionary(Dictionary *dictionary)
+{
+    if (dictionary == NULL)
+    {
+        return;
+    }
+    freeTrie(dictionary->trie);
+    freeGaddag(dictionary->gaddag);
+    freeDawg(dictionary->dawg);
+    freeCompactTrie(dictionary->compactTrie);
+    free(dictionary);
+}
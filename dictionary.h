@@ -0,0 +1,162 @@
+/*---------- ID HEADER -------------------------------------
+/   Author(s):    Aidan Andrews, Kyle Scidmore
+/   File Name:    dictionary.h
+/
+/   File Description:
+/     This header file defines the Dictionary, which holds every word
+/     structure built from one dictionary file, and a small cursor interface
+/     for walking its forward structure (the DAWG when one was built, else the
+/     compact Trie, else the Trie). Word lookups and the move generator only
+/     use this interface, so they run unchanged on any backend.
+/
+/---------------------------------------------------------*/
+#ifndef DICTIONARY_H
+#define DICTIONARY_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "dataStruct.h"
+#include "gaddag.h"
+#include "dawg.h"
+#include "compactTrie.h"
+
+// Structures that loadDictionaryStructures can build (may be combined with |)
+#define DICTIONARY_TRIE 1
+#define DICTIONARY_GADDAG 2
+#define DICTIONARY_DAWG 4
+#define DICTIONARY_COMPACT_TRIE 8
+#define DICTIONARY_PARALLEL 16 // Build the Trie on one thread per core (see buildTrieParallel)
+#define DICTIONARY_REVERSE_TRIE 32 // Also build the reverse Trie in the Trie's arena (see insertReversedWord)
+
+// Word structures built from one dictionary file (unrequested ones are NULL)
+typedef struct Dictionary {
+    TrieNode *trie;         // Forward Trie, used for word lookups.
+    Gaddag *gaddag;         // GADDAG, used for bidirectional move generation.
+    Dawg *dawg;             // Minimised DAWG, a compact replacement for the Trie.
+    CompactTrie *compactTrie; // Trie with 8-byte nodes and contiguous children.
+} Dictionary;
+
+// Position in the forward structure: a TrieNode pointer or a DAWG / compact Trie node index
+typedef uintptr_t DictCursor;
+#define DICT_CURSOR_NONE 0
+
+// Function prototypes
+int dictionarySearchWord(const Dictionary *dictionary, const char *word);
+void freeDictionary(Dictionary *dictionary);
+
+/*---------- FUNCTION: dictionaryRoot -----------------------------------
+/   Function Description:
+/     Returns the cursor for the empty prefix.
+/   Caller Input:
+/     - const Dictionary *dictionary: The dictionary.
+/   Caller Output:
+/     - DictCursor: Cursor at the root of the forward structure.
+/   Assumptions, Limitations, Known Bugs:
+/     - The dictionary must hold a DAWG, a compact Trie or a Trie.
+/---------------------------------------------------------*/
+static inline DictCursor dictionaryRoot(const Dictionary *dictionary)
+{
+    if (dictionary->dawg != NULL)
+    {
+        return dictionary->dawg->root;
+    }
+    if (dictionary->compactTrie != NULL)
+    {
+        return COMPACT_TRIE_ROOT;
+    }
+    return (DictCursor)dictionary->trie;
+}
+
+/*---------- FUNCTION: dictionaryChild -----------------------------------
+/   Function Description:
+/     Moves a cursor one letter further.
+/   Caller Input:
+/     - const Dictionary *dictionary: The dictionary.
+/     - DictCursor cursor: The current cursor.
+/     - char letter: The next letter.
+/   Caller Output:
+/     - DictCursor: The new cursor, DICT_CURSOR_NONE if no word continues with the letter.
+/   Assumptions, Limitations, Known Bugs:
+/     - Letters outside A-Z never continue a word.
+/---------------------------------------------------------*/
+static inline DictCursor dictionaryChild(const Dictionary *dictionary, DictCursor cursor, char letter)
+{
+    int index = letter - 'A';
+    if (index < 0 || index >= MAX_CHARACTERS)
+    {
+        return DICT_CURSOR_NONE;
+    }
+    if (dictionary->dawg != NULL)
+    {
+        return dawgChild(dictionary->dawg, (uint32_t)cursor, index);
+    }
+    if (dictionary->compactTrie != NULL)
+    {
+        return compactTrieChild(dictionary->compactTrie, (uint32_t)cursor, index);
+    }
+    return (DictCursor)((TrieNode *)cursor)->children[index];
+}
+
+/*---------- FUNCTION: dictionaryIsWord -----------------------------------
+/   Function Description:
+/     Checks if the letters followed to reach a cursor form a word.
+/   Caller Input:
+/     - const Dictionary *dictionary: The dictionary.
+/     - DictCursor cursor: A valid cursor.
+/   Caller Output:
+/     - bool: True if a word ends at the cursor.
+/   Assumptions, Limitations, Known Bugs:
+/     - N/A
+/---------------------------------------------------------*/
+static inline bool dictionaryIsWord(const Dictionary *dictionary, DictCursor cursor)
+{
+    if (dictionary->dawg != NULL)
+    {
+        return (dictionary->dawg->nodes[cursor].childMask & DAWG_WORD_FLAG) != 0;
+    }
+    if (dictionary->compactTrie != NULL)
+    {
+        return (dictionary->compactTrie->nodes[cursor].info & COMPACT_TRIE_WORD_FLAG) != 0;
+    }
+    return ((TrieNode *)cursor)->isWord;
+}
+
+/*---------- FUNCTION: dictionaryChildMask -----------------------------------
+/   Function Description:
+/     Returns the letters that can follow a cursor as a bitmask.
+/   Caller Input:
+/     - const Dictionary *dictionary: The dictionary.
+/     - DictCursor cursor: A valid cursor.
+/   Caller Output:
+/     - uint32_t: Bit i is set if letter 'A' + i has a child.
+/   Assumptions, Limitations, Known Bugs:
+/     - A single load for the DAWG and compact Trie; the Trie has to test
+/       its 26 pointers.
+/---------------------------------------------------------*/
+static inline uint32_t dictionaryChildMask(const Dictionary *dictionary, DictCursor cursor)
+{
+    if (dictionary->dawg != NULL)
+    {
+        return dictionary->dawg->nodes[cursor].childMask & DAWG_LETTER_BITS;
+    }
+    if (dictionary->compactTrie != NULL)
+    {
+        return dictionary->compactTrie->nodes[cursor].info & COMPACT_TRIE_CHILD_BITS;
+    }
+
+    uint32_t mask = 0;
+    TrieNode *node = (TrieNode *)cursor;
+    for (int i = 0; i < MAX_CHARACTERS; i++)
+    {
+        if (node->children[i] != NULL)
+        {
+            mask |= 1u << i;
+        }
+    }
+    return mask;
+}
+
+#endif
@@ -0,0 +1,230 @@
+/*---------- ID HEADER -------------------------------------
+/   Author(s):    Aidan Andrews, Kyle Scidmore
+/   File Name:    gaddag.c
+/
+/   File Description:
+/     This file implements the GADDAG: creation, word insertion, lookup and
+/     freeing. Nodes are stored in a single growable array and linked by
+/     index through sorted child/sibling lists, which keeps each node to
+/     12 bytes even though a GADDAG holds roughly ten times as many nodes as
+/     the plain Trie.
+/
+/---------------------------------------------------------*/
+#include "gaddag.h"
+
+//Prototypes
+static uint32_t createGaddagNode(Gaddag *gaddag, char letter);
+static uint32_t findOrCreateChild(Gaddag *gaddag, uint32_t node, char letter);
+
+/*---------- FUNCTION: createGaddag -----------------------------------
+/   Function Description:
+/     Creates an empty GADDAG containing only the root node.
+/
+/   Caller Input:
+/     - void
+/
+/   Caller Output:
+/     - Gaddag *: Pointer to the new GADDAG.
+/
+/   Assumptions, Limitations, Known Bugs:
+/     - Exits the program on allocation failure.
+/---------------------------------------------------------*/
+Gaddag *createGaddag(void)
+{
+    Gaddag *gaddag = malloc(sizeof(Gaddag));
+    if (gaddag == NULL)
+    {
+        perror("Failed to allocate memory");
+        exit(1);
+    }
+
+    gaddag->capacity = 1024;
+    gaddag->totalNodes = 0;
+    gaddag->nodes = malloc(gaddag->capacity * sizeof(GaddagNode));
+    if (gaddag->nodes == NULL)
+    {
+        perror("Failed to allocate memory");
+        exit(1);
+    }
+
+    createGaddagNode(gaddag, '\0');
+    return gaddag;
+}
+
+/*---------- FUNCTION: createGaddagNode -----------------------------------
+/   Function Description:
+/     Appends a new node with no children to the node array.
+/
+/   Caller Input:
+/     - Gaddag *gaddag: The GADDAG to grow.
+/     - char letter: The letter stored in the node.
+/
+/   Caller Output:
+/     - uint32_t: Index of the new node.
+/
+/   Assumptions, Limitations, Known Bugs:
+/     - May move the node array; callers must not hold node pointers across it.
+/     - Exits the program on allocation failure.
+/---------------------------------------------------------*/
+static uint32_t createGaddagNode(Gaddag *gaddag, char letter)
+{
+    if (gaddag->totalNodes == gaddag->capacity)
+    {
+        uint32_t newCapacity = gaddag->capacity * 2;
+        GaddagNode *nodes = realloc(gaddag->nodes, newCapacity * sizeof(GaddagNode));
+        if (nodes == NULL)
+        {
+            perror("Failed to allocate memory");
+            exit(1);
+        }
+        gaddag->nodes = nodes;
+        gaddag->capacity = newCapacity;
+    }
+
+    uint32_t index = gaddag->totalNodes++;
+    gaddag->nodes[index].firstChild = GADDAG_NONE;
+    gaddag->nodes[index].nextSibling = GADDAG_NONE;
+    gaddag->nodes[index].letter = letter;
+    gaddag->nodes[index].isWord = false;
+    return index;
+}
+
+/*---------- FUNCTION: findOrCreateChild -----------------------------------
+/   Function Description:
+/     Returns the child of a node for a letter, inserting it into the sorted
+/     child list if it does not exist yet.
+/
+/   Caller Input:
+/     - Gaddag *gaddag: The GADDAG.
+/     - uint32_t node: Index of the parent node.
+/     - char letter: The letter of the child.
+/
+/   Caller Output:
+/     - uint32_t: Index of the child node.
+/
+/   Assumptions, Limitations, Known Bugs:
+/     - N/A
+/---------------------------------------------------------*/
+static uint32_t findOrCreateChild(Gaddag *gaddag, uint32_t node, char letter)
+{
+    uint32_t previous = GADDAG_NONE;
+    uint32_t child = gaddag->nodes[node].firstChild;
+
+    while (child != GADDAG_NONE && gaddag->nodes[child].letter < letter)
+    {
+        previous = child;
+        child = gaddag->nodes[child].nextSibling;
+    }
+    if (child != GADDAG_NONE && gaddag->nodes[child].letter == letter)
+    {
+        return child;
+    }
+
+    uint32_t newChild = createGaddagNode(gaddag, letter);
+    gaddag->nodes[newChild].nextSibling = child;
+    if (previous == GADDAG_NONE)
+    {
+        gaddag->nodes[node].firstChild = newChild;
+    }
+    else
+    {
+        gaddag->nodes[previous].nextSibling = newChild;
+    }
+    return newChild;
+}
+
+/*---------- FUNCTION: insertGaddagWord -----------------------------------
+/   Function Description:
+/     Inserts a word into the GADDAG. For a word of length n, n paths are
+/     added: for every split point i the reversed first i letters, the
+/     separator, then the remaining n - i letters.
+/
+/   Caller Input:
+/     - Gaddag *gaddag: The GADDAG.
+/     - const char *word: The word to be inserted.
+/
+/   Caller Output:
+/     - void: No return value.
+/
+/   Assumptions, Limitations, Known Bugs:
+/     - Assumes the word consists of uppercase letters.
+/---------------------------------------------------------*/
+void insertGaddagWord(Gaddag *gaddag, const char *word)
+{
+    int length = strlen(word);
+
+    for (int split = 1; split <= length; split++)
+    {
+        uint32_t current = 0;
+
+        for (int i = split - 1; i >= 0; i--)
+        {
+            current = findOrCreateChild(gaddag, current, word[i]);
+        }
+        current = findOrCreateChild(gaddag, current, GADDAG_SEPARATOR);
+        for (int i = split; i < length; i++)
+        {
+            current = findOrCreateChild(gaddag, current, word[i]);
+        }
+        gaddag->nodes[current].isWord = true;
+    }
+}
+
+/*---------- FUNCTION: freeGaddag -----------------------------------
+/   Function Description:
+/     Frees the memory allocated for the GADDAG.
+/
+/   Caller Input:
+/     - Gaddag *gaddag: The GADDAG to free.
+/
+/   Caller Output:
+/     - void: No return value.
+/
+/   Assumptions, Limitations, Known Bugs:
+/     - N/A
+/---------------------------------------------------------*/
+void freeGaddag(Gaddag *gaddag)
+{
+    if (gaddag == NULL)
+    {
+        return;
+    }
+    free(gaddag->nodes);
+    free(gaddag);
+}
+
+/*---------- FUNCTION: searchGaddag -----------------------------------
+/   Function Description:
+/     Searches for a word in the GADDAG by following its full reversal and
+/     then the separator.
+/
+/   Caller Input:
+/     - const Gaddag *gaddag: The GADDAG.
+/     - const char *word: The word to be searched for.
+/
+/   Caller Output:
+/     - int: 1 if the word is found, 0 otherwise.
+/
+/   Assumptions, Limitations, Known Bugs:
+/     - Assumes the word consists of uppercase letters.
+/---------------------------------------------------------*/
+int searchGaddag(const Gaddag *gaddag, const char *word)
+{
+    uint32_t current = 0;
+
+    for (int i = strlen(word) - 1; i >= 0; i--)
+    {
+        if (word[i] < 'A' || word[i] > 'Z')
+        {
+            return 0;
+        }
+        current = gaddagChild(gaddag, current, word[i]);
+        if (current == GADDAG_NONE)
+        {
+            return 0;
+        }
+    }
+
+    current = gaddagChild(gaddag, current, GADDAG_SEPARATOR);
+    return current != GADDAG_NONE && gaddag->nodes[current].isWord;
+}
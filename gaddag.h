@@ -0,0 +1,73 @@
+/*---------- ID HEADER -------------------------------------
+/   Author(s):    Aidan Andrews, Kyle Scidmore
+/   File Name:    gaddag.h
+/
+/   File Description:
+/     This header file defines the GADDAG used for bidirectional move
+/     generation. Every word is stored once for each of its letters as the
+/     reversed prefix up to that letter, a separator, and the remaining
+/     suffix. Starting from any letter of a word the generator can therefore
+/     walk backwards, cross the separator and continue forwards in a single
+/     traversal.
+/
+/---------------------------------------------------------*/
+#ifndef GADDAG_H
+#define GADDAG_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#define GADDAG_SEPARATOR '>' // Marks the switch from the reversed prefix to the suffix
+#define GADDAG_NONE 0        // Child/sibling index meaning "no node" (the root is never a child)
+
+// GADDAG Node Structure (nodes live in one array and refer to each other by index)
+typedef struct GaddagNode {
+    uint32_t firstChild;    // Index of the first child, GADDAG_NONE if there is none.
+    uint32_t nextSibling;   // Index of the next child of the same parent, GADDAG_NONE if last.
+    char letter;            // 'A'-'Z' or GADDAG_SEPARATOR.
+    bool isWord;            // Flag indicating if a complete path ends at this node.
+} GaddagNode;
+
+// GADDAG Structure
+typedef struct Gaddag {
+    GaddagNode *nodes;      // Node array, nodes[0] is the root.
+    uint32_t totalNodes;    // Number of nodes in use.
+    uint32_t capacity;      // Number of nodes allocated.
+} Gaddag;
+
+// Function prototypes
+Gaddag *createGaddag(void);
+void insertGaddagWord(Gaddag *gaddag, const char *word);
+void freeGaddag(Gaddag *gaddag);
+int searchGaddag(const Gaddag *gaddag, const char *word);
+
+/*---------- FUNCTION: gaddagChild -----------------------------------
+/   Function Description:
+/     Returns the child of a GADDAG node for a given letter.
+/   Caller Input:
+/     - const Gaddag *gaddag: The GADDAG.
+/     - uint32_t node: Index of the current node.
+/     - char letter: The letter (or GADDAG_SEPARATOR) to follow.
+/   Caller Output:
+/     - uint32_t: Index of the child, GADDAG_NONE if there is none.
+/   Assumptions, Limitations, Known Bugs:
+/     - Children are kept sorted by letter so the scan stops early.
+/---------------------------------------------------------*/
+static inline uint32_t gaddagChild(const Gaddag *gaddag, uint32_t node, char letter)
+{
+    uint32_t child = gaddag->nodes[node].firstChild;
+    while (child != GADDAG_NONE && gaddag->nodes[child].letter < letter)
+    {
+        child = gaddag->nodes[child].nextSibling;
+    }
+    if (child != GADDAG_NONE && gaddag->nodes[child].letter == letter)
+    {
+        return child;
+    }
+    return GADDAG_NONE;
+}
+
+#endif
@@ -0,0 +1,287 @@
+/*---------- ID HEADER -------------------------------------
+/   Author(s):    Aidan Andrews, Kyle Scidmore
+/   File Name:    gameState.c
+/
+/   File Description:
+/     This file implements the game state. A new tile can only change the
+/     squares next to it: the side neighbours may become anchors, and the
+/     empty squares just past the words it joins, along its row and its
+/     column, get new cross-checks. applyMove visits exactly those squares
+/     and saves each one before changing it, so undoMove is a copy back.
+/
+/---------------------------------------------------------*/
+#include "gameState.h"
+
+static const int rowStep[4] = {-1, 1, 0, 0};
+static const int colStep[4] = {0, 0, -1, 1};
+
+static void saveSquare(GameState *state, MoveUndo *undo, BoardBits *saved, int row, int col);
+static void addAnchor(GameState *state, MoveUndo *undo, BoardBits *saved, int row, int col);
+static void refreshWordEnd(GameState *state, MoveUndo *undo, BoardBits *saved, BoardBits refreshed[2], int row, int col, int direction);
+
+/*---------- FUNCTION: initGameState -----------------------------------
+/   Function Description:
+/     Copies a board, with its occupancy, into a game state, marks the
+/     bonuses under its tiles used and computes its anchors and
+/     cross-checks from scratch.
+/   Caller Input:
+/     - GameState *state: Receives the game state.
+/     - const Dictionary *dictionary: The loaded dictionary.
+/     - Board *board: The board to start from.
+/   Caller Output:
+/     - void: No return value.
+/   Assumptions, Limitations, Known Bugs:
+/     - The only full pass over the board; later turns go through applyMove.
+/---------------------------------------------------------*/
+void initGameState(GameState *state, const Dictionary *dictionary, Board *board)
+{
+    state->board = *board;
+    state->dictionary = dictionary;
+
+    findAnchors(&state->board.occupied, &state->anchors);
+    for (int row = 0; row < BOARD_SIZE; row++)
+    {
+        for (int col = 0; col < BOARD_SIZE; col++)
+        {
+            Square *square = &state->board.squares[row][col];
+            square->validPlacement = (state->anchors.rows[row] >> col) & 1;
+            if (square->letter != ' ')
+            {
+                square->usedBonus = true;
+            }
+        }
+    }
+    computeCrossChecks(state->board.squares, dictionary);
+}
+
+/*---------- FUNCTION: findMovePlacements -----------------------------------
+/   Function Description:
+/     Walks the squares of a move's word from its first square and lists
+/     the empty ones with the letter the word puts there.
+/   Caller Input:
+/     - Square board[BOARD_SIZE][BOARD_SIZE]: The game board.
+/     - const Move *move: The move.
+/     - TilePlacement placements[BOARD_SIZE]: Receives the tiles, in word order.
+/   Caller Output:
+/     - int: Number of tiles, -1 if the word does not fit the board.
+/   Assumptions, Limitations, Known Bugs:
+/     - The board is not changed.
+/---------------------------------------------------------*/
+int findMovePlacements(Square board[BOARD_SIZE][BOARD_SIZE], const Move *move, TilePlacement placements[BOARD_SIZE])
+{
+    int totalPlacements = 0;
+
+    if (move->direction < UP || move->direction > RIGHT)
+    {
+        return -1;
+    }
+
+    for (int i = 0; move->word[i] != '\0'; i++)
+    {
+        int row = move->row + i * rowStep[move->direction];
+        int col = move->col + i * colStep[move->direction];
+
+        if (row < 0 || row >= BOARD_SIZE || col < 0 || col >= BOARD_SIZE)
+        {
+            return -1;
+        }
+        if (board[row][col].letter == ' ')
+        {
+            placements[totalPlacements].row = row;
+            placements[totalPlacements].col = col;
+            placements[totalPlacements].letter = move->word[i];
+            totalPlacements++;
+        }
+        else if (board[row][col].letter != move->word[i])
+        {
+            return -1;
+        }
+    }
+    return totalPlacements;
+}
+
+/*---------- FUNCTION: applyMove -----------------------------------
+/   Function Description:
+/     Places the tiles of a move, then, for each tile, adds it and its
+/     neighbours to the anchors and recomputes the cross-checks at the four
+/     ends of the words through it. Each changed square is saved first.
+/   Caller Input:
+/     - GameState *state: The game state.
+/     - const Move *move: The move.
+/     - MoveUndo *undo: Receives the tiles placed and the saved squares.
+/   Caller Output:
+/     - bool: False, with the state unchanged, if the move places no tile.
+/   Assumptions, Limitations, Known Bugs:
+/     - Costs a few dictionary walks per tile, whatever is on the board.
+/---------------------------------------------------------*/
+bool applyMove(GameState *state, const Move *move, MoveUndo *undo)
+{
+    BoardBits saved = {{0}, {0}};
+    BoardBits refreshed[2] = {{{0}, {0}}, {{0}, {0}}}; // Squares whose cross-check of each orientation is up to date
+
+    undo->totalPlacements = findMovePlacements(state->board.squares, move, undo->placements);
+    if (undo->totalPlacements <= 0)
+    {
+        undo->totalPlacements = 0;
+        undo->totalSaved = 0;
+        return false;
+    }
+    undo->totalSaved = 0;
+    undo->occupied = state->board.occupied;
+    undo->anchors = state->anchors;
+
+    // Every tile goes down before any cross-check is taken, so the words
+    // read through the new tiles are complete
+    for (int i = 0; i < undo->totalPlacements; i++)
+    {
+        const TilePlacement *placement = &undo->placements[i];
+        Square *square = &state->board.squares[placement->row][placement->col];
+
+        saveSquare(state, undo, &saved, placement->row, placement->col);
+        setBoardTile(&state->board, placement->row, placement->col, placement->letter);
+        square->usedBonus = true;
+        square->crossCheck[0] = CROSS_CHECK_ALL;
+        square->crossCheck[1] = CROSS_CHECK_ALL;
+        square->crossScore[0] = 0;
+        square->crossScore[1] = 0;
+    }
+
+    for (int i = 0; i < undo->totalPlacements; i++)
+    {
+        int row = undo->placements[i].row;
+        int col = undo->placements[i].col;
+
+        addAnchor(state, undo, &saved, row, col);
+        for (int direction = UP; direction <= RIGHT; direction++)
+        {
+            int neighbourRow = row + rowStep[direction];
+            int neighbourCol = col + colStep[direction];
+            if (neighbourRow >= 0 && neighbourRow < BOARD_SIZE && neighbourCol >= 0 && neighbourCol < BOARD_SIZE)
+            {
+                addAnchor(state, undo, &saved, neighbourRow, neighbourCol);
+            }
+            refreshWordEnd(state, undo, &saved, refreshed, row, col, direction);
+        }
+    }
+    return true;
+}
+
+/*---------- FUNCTION: undoMove -----------------------------------
+/   Function Description:
+/     Copies back the squares and bitboards a move saved.
+/   Caller Input:
+/     - GameState *state: The game state.
+/     - const MoveUndo *undo: The record filled in by applyMove.
+/   Caller Output:
+/     - void: No return value.
+/   Assumptions, Limitations, Known Bugs:
+/     - The move must be the last one applied that is not yet undone.
+/---------------------------------------------------------*/
+void undoMove(GameState *state, const MoveUndo *undo)
+{
+    for (int i = undo->totalSaved - 1; i >= 0; i--)
+    {
+        state->board.squares[undo->saved[i].row][undo->saved[i].col] = undo->saved[i].square;
+    }
+    state->board.occupied = undo->occupied;
+    state->anchors = undo->anchors;
+}
+
+/*---------- FUNCTION: saveSquare -----------------------------------
+/   Function Description:
+/     Records a square in the undo record the first time a move changes it.
+/   Caller Input:
+/     - GameState *state: The game state.
+/     - MoveUndo *undo: The record of the move being applied.
+/     - BoardBits *saved: The squares recorded so far.
+/     - int row: Row index of the square.
+/     - int col: Column index of the square.
+/   Caller Output:
+/     - void: No return value.
+/   Assumptions, Limitations, Known Bugs:
+/     - At most GAME_MAX_CHANGED_SQUARES squares are recorded per move.
+/---------------------------------------------------------*/
+static void saveSquare(GameState *state, MoveUndo *undo, BoardBits *saved, int row, int col)
+{
+    if ((saved->rows[row] >> col) & 1)
+    {
+        return;
+    }
+    saved->rows[row] |= 1u << col;
+
+    SavedSquare *entry = &undo->saved[undo->totalSaved++];
+    entry->row = row;
+    entry->col = col;
+    entry->square = state->board.squares[row][col];
+}
+
+/*---------- FUNCTION: addAnchor -----------------------------------
+/   Function Description:
+/     Makes a square a valid placement, in both the anchor bitboard and
+/     the square itself.
+/   Caller Input:
+/     - GameState *state: The game state.
+/     - MoveUndo *undo: The record of the move being applied.
+/     - BoardBits *saved: The squares recorded so far.
+/     - int row: Row index of the square.
+/     - int col: Column index of the square.
+/   Caller Output:
+/     - void: No return value.
+/   Assumptions, Limitations, Known Bugs:
+/     - Squares that already are anchors are left alone.
+/---------------------------------------------------------*/
+static void addAnchor(GameState *state, MoveUndo *undo, BoardBits *saved, int row, int col)
+{
+    if ((state->anchors.rows[row] >> col) & 1)
+    {
+        return;
+    }
+    saveSquare(state, undo, saved, row, col);
+    state->anchors.rows[row] |= 1u << col;
+    state->anchors.columns[col] |= 1u << row;
+    state->board.squares[row][col].validPlacement = true;
+}
+
+/*---------- FUNCTION: refreshWordEnd -----------------------------------
+/   Function Description:
+/     Walks from a new tile over the tiles in one direction and recomputes
+/     the cross-check of the empty square the word ends at. Words along a
+/     row decide the cross-checks of UP/DOWN plays, words along a column
+/     those of LEFT/RIGHT plays.
+/   Caller Input:
+/     - GameState *state: The game state.
+/     - MoveUndo *undo: The record of the move being applied.
+/     - BoardBits *saved: The squares recorded so far.
+/     - BoardBits refreshed[2]: Squares already recomputed, per orientation.
+/     - int row: Row index of the new tile.
+/     - int col: Column index of the new tile.
+/     - int direction: Direction to walk in.
+/   Caller Output:
+/     - void: No return value.
+/   Assumptions, Limitations, Known Bugs:
+/     - Nothing is done if the word runs to the edge of the board.
+/---------------------------------------------------------*/
+static void refreshWordEnd(GameState *state, MoveUndo *undo, BoardBits *saved, BoardBits refreshed[2], int row, int col, int direction)
+{
+    // A LEFT/RIGHT walk reads the cross word of UP/DOWN plays and the other way round
+    int orientation = direction <= DOWN ? CROSS_CHECK_INDEX(LEFT) : CROSS_CHECK_INDEX(UP);
+
+    do
+    {
+        row += rowStep[direction];
+        col += colStep[direction];
+        if (row < 0 || row >= BOARD_SIZE || col < 0 || col >= BOARD_SIZE)
+        {
+            return;
+        }
+    } while (state->board.squares[row][col].letter != ' ');
+
+    if ((refreshed[orientation].rows[row] >> col) & 1)
+    {
+        return;
+    }
+    refreshed[orientation].rows[row] |= 1u << col;
+
+    saveSquare(state, undo, saved, row, col);
+    computeSquareCrossCheck(state->board.squares, state->dictionary, row, col, orientation);
+}
@@ -0,0 +1,124 @@
+/*---------- ID HEADER -------------------------------------
+/   Author(s):    Aidan Andrews, Kyle Scidmore
+/   File Name:    gameState.h
+/
+/   File Description:
+/     This header file declares the game state, a board that is set up once
+/     and then played on move by move. Applying a move places its tiles,
+/     marks their bonuses used and refreshes the anchors and cross-checks
+/     of the squares the new tiles touch only, so a turn costs time in
+/     proportion to the move instead of the board. Every applied move can
+/     be undone, which lets a caller look ahead and back out again.
+/
+/---------------------------------------------------------*/
+#ifndef GAMESTATE_H
+#define GAMESTATE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "dataStruct.h"
+#include "dictionary.h"
+#include "moveGenerator.h"
+
+// Squares one move can change: its tiles, the square past either end of its
+// word and, on either side of each tile, the square past its perpendicular word
+#define GAME_MAX_CHANGED_SQUARES (3 * BOARD_SIZE + 2)
+
+// A tile a move puts on the board
+typedef struct TilePlacement {
+    int row;     // Row index of the square.
+    int col;     // Column index of the square.
+    char letter; // The letter placed.
+} TilePlacement;
+
+// A square as it was before a move changed it
+typedef struct SavedSquare {
+    int row;
+    int col;
+    Square square;
+} SavedSquare;
+
+// A board being played on (see initGameState)
+typedef struct GameState {
+    Board board;                  // Squares and occupancy, with valid placements and cross-checks kept up to date.
+    BoardBits anchors;            // The valid placement squares (see findAnchors).
+    const Dictionary *dictionary; // Dictionary the cross-checks are taken from.
+} GameState;
+
+// What applyMove did, to report the tiles and to undo it
+typedef struct MoveUndo {
+    TilePlacement placements[BOARD_SIZE]; // The tiles placed, in word order.
+    int totalPlacements;
+    SavedSquare saved[GAME_MAX_CHANGED_SQUARES]; // Every square changed, as it was.
+    int totalSaved;
+    BoardBits occupied; // Occupancy before the move.
+    BoardBits anchors;  // Anchors before the move.
+} MoveUndo;
+
+/*---------- FUNCTION: initGameState -----------------------------------
+/   Function Description:
+/     Sets up a game state from a board, computing its anchors and
+/     cross-checks once.
+/   Caller Input:
+/     - GameState *state: Receives the game state.
+/     - const Dictionary *dictionary: The loaded dictionary; it must outlive the state.
+/     - Board *board: A board set up by initBoard and loadBoard or
+/       setBoardLetters; it is copied, not changed.
+/   Caller Output:
+/     - void: No return value.
+/   Assumptions, Limitations, Known Bugs:
+/     - The bonuses under the tiles already on the board count as used.
+/---------------------------------------------------------*/
+void initGameState(GameState *state, const Dictionary *dictionary, Board *board);
+
+/*---------- FUNCTION: findMovePlacements -----------------------------------
+/   Function Description:
+/     Finds the tiles a move puts on a board without changing it. The word
+/     lies on the squares the generator walked and scored it on, read in
+/     the move's direction from its first square.
+/   Caller Input:
+/     - Square board[BOARD_SIZE][BOARD_SIZE]: The game board.
+/     - const Move *move: The move.
+/     - TilePlacement placements[BOARD_SIZE]: Receives the tiles, in word order.
+/   Caller Output:
+/     - int: Number of tiles, -1 if the word leaves the board or disagrees
+/       with a tile already on it.
+/   Assumptions, Limitations, Known Bugs:
+/     - Only the position is checked; the words formed are not looked up.
+/---------------------------------------------------------*/
+int findMovePlacements(Square board[BOARD_SIZE][BOARD_SIZE], const Move *move, TilePlacement placements[BOARD_SIZE]);
+
+/*---------- FUNCTION: applyMove -----------------------------------
+/   Function Description:
+/     Plays a move: places its tiles, marks their bonuses used, adds the
+/     squares around them to the anchors and recomputes the cross-checks
+/     of the empty squares at the ends of the words running through them.
+/   Caller Input:
+/     - GameState *state: The game state.
+/     - const Move *move: The move, as found by the solver on state->board.
+/     - MoveUndo *undo: Receives the tiles placed and what undoMove needs.
+/   Caller Output:
+/     - bool: False, with the state unchanged, if the move places no tile
+/       (see findMovePlacements).
+/   Assumptions, Limitations, Known Bugs:
+/     - Afterwards the state is what initGameState would make of the new board.
+/---------------------------------------------------------*/
+bool applyMove(GameState *state, const Move *move, MoveUndo *undo);
+
+/*---------- FUNCTION: undoMove -----------------------------------
+/   Function Description:
+/     Takes back a move made by applyMove, restoring every square it changed.
+/   Caller Input:
+/     - GameState *state: The game state.
+/     - const MoveUndo *undo: The record filled in by applyMove.
+/   Caller Output:
+/     - void: No return value.
+/   Assumptions, Limitations, Known Bugs:
+/     - Moves must be undone in the reverse order they were applied.
+/---------------------------------------------------------*/
+void undoMove(GameState *state, const MoveUndo *undo);
+
+#endif
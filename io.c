@@ -4,11 +4,24 @@
 /
 /   File Description:
 /     This file implements functions for loading a Scrabble dictionary
-/     from a file into a Trie data structure for word lookup.
+/     from a file into a Trie, compact Trie, GADDAG and/or DAWG for word
+/     lookup and move generation, for compiling and mapping precompiled
+/     dictionary images, and for printing the chosen move.
 /
 /---------------------------------------------------------*/
 #include "io.h"
 
+#define READ_BLOCK_SIZE (1 << 20)   // Bytes read per call when a dictionary cannot be mapped
+#define MAX_REPORTED_WORDS 10       // Skipped dictionary words reported one by one
+#define IS_WORD_SEPARATOR(c) ((unsigned char)(c) <= ' ') // Spaces, tabs, CR and other control characters
+
+//Prototypes
+static char *readTextFile(const char *filename, size_t *size, bool *mapped);
+static void releaseTextFile(char *text, size_t size, bool mapped);
+static bool foldWord(const char *token, size_t length, char word[16]);
+static int compareWords(const void *a, const void *b);
+static void sortWordList(char (*words)[16], size_t totalWords);
+
 /*---------- FUNCTION: loadDictionary -----------------------------------
 /   Function Description:
 /     Loads words from a specified file into a Trie data structure.
@@ -23,44 +36,461 @@
 /       Returns NULL and exits the program if file opening fails.
 /
 /   Assumptions, Limitations, Known Bugs:
-/     - Assumes each word in the file is no longer than 15 character.
+/     - Words longer than 15 letters are skipped and reported.
 /     - Exits the program if the file cannot be opened.
 /
 -------------------------------------------------------------------------*/
 TrieNode *loadDictionary(const char *filename)
 {
+    Dictionary *dictionary = loadDictionaryStructures(filename, DICTIONARY_TRIE);
+    TrieNode *root = dictionary->trie;
+
+    free(dictionary);
+    return root;
+}
+
+/*---------- FUNCTION: loadDictionaryStructures -----------------------------------
+/   Function Description:
+/     Loads words from a specified file into the requested word structures.
+/     The whole file is read at once (see readTextFile), split into lines
+/     with memchr and each word is case-folded and checked while it is
+/     copied out. Every word is then inserted into the Trie (and reversed
+/     into its reverse Trie) and/or the GADDAG. For the DAWG and the compact
+/     Trie, and for the Trie when DICTIONARY_PARALLEL is given, the words are
+/     collected first and added in sorted order once the whole file has been
+/     read.
+/
+/   Caller Input:
+/     - const char *filename: Path to the dictionary file containing words.
+/     - int structures: DICTIONARY_TRIE, DICTIONARY_GADDAG, DICTIONARY_DAWG and/or
+/       DICTIONARY_COMPACT_TRIE combined with |, plus DICTIONARY_PARALLEL to
+/       build the Trie on every core and DICTIONARY_REVERSE_TRIE to build the
+/       reverse Trie alongside it.
+/
+/   Caller Output:
+/     - Dictionary *: The built structures; the ones not requested are NULL.
+/       Release with freeDictionary.
+/
+/   Assumptions, Limitations, Known Bugs:
+/     - Words are separated by whitespace or control characters, normally
+/       one per line.
+/     - Words longer than 15 letters or containing characters other than
+/       letters are skipped and reported on stderr with their line number.
+/     - Exits the program if the file cannot be opened.
+/     - The word list is only sorted if it is not sorted already.
+/     - DICTIONARY_REVERSE_TRIE has no effect without DICTIONARY_TRIE.
+/
+-------------------------------------------------------------------------*/
+Dictionary *loadDictionaryStructures(const char *filename, int structures)
+{
+    size_t size = 0;
+    bool mapped = false;
+    char *text = readTextFile(filename, &size, &mapped);
 
-    FILE *file = fopen(filename, "r");
-    if (file == NULL)
+    Dictionary *dictionary = malloc(sizeof(Dictionary));
+    if (dictionary == NULL)
     {
-        perror("Failed to open dictionary file");
+        perror("Failed to allocate memory");
         exit(1);
     }
+    bool parallelTrie = (structures & DICTIONARY_TRIE) && (structures & DICTIONARY_PARALLEL);
+    bool reverseTrie = (structures & DICTIONARY_TRIE) && (structures & DICTIONARY_REVERSE_TRIE);
+    dictionary->trie = ((structures & DICTIONARY_TRIE) && !parallelTrie) ? createTrieNode('\0') : NULL;
+    dictionary->gaddag = (structures & DICTIONARY_GADDAG) ? createGaddag() : NULL;
+    dictionary->dawg = NULL;
+    dictionary->compactTrie = NULL;
+
+    bool collectWords = parallelTrie || (structures & (DICTIONARY_DAWG | DICTIONARY_COMPACT_TRIE)) != 0;
+    char (*words)[16] = NULL;
+    size_t totalWords = 0;
+    size_t wordCapacity = 0;
 
-    TrieNode *root = createTrieNode('\0');
-    char word[16];
+    TrieNode *path[BOARD_SIZE + 1];     // Trie nodes along the previous word
+    char previousWord[16] = "";
+    int previousLength = 0;
+    int skippedWords = 0;
+    int lineNumber = 0;
+    path[0] = dictionary->trie;
 
-    while (fscanf(file, "%15s", word) != EOF)
+    const char *cursor = text;
+    const char *end = text + size;
+    while (cursor < end)
     {
+        const char *lineEnd = memchr(cursor, '\n', end - cursor);
+        if (lineEnd == NULL)
+        {
+            lineEnd = end;
+        }
+        lineNumber++;
 
-        for (int i = 0; word[i]; i++)
+        while (cursor < lineEnd)
         {
-            word[i] = toupper(word[i]);
+            while (cursor < lineEnd && IS_WORD_SEPARATOR(*cursor))
+            {
+                cursor++;
+            }
+            const char *token = cursor;
+            while (cursor < lineEnd && !IS_WORD_SEPARATOR(*cursor))
+            {
+                cursor++;
+            }
+            size_t length = cursor - token;
+            if (length == 0)
+            {
+                break;
+            }
+
+            char word[16];
+            if (!foldWord(token, length, word))
+            {
+                if (skippedWords++ < MAX_REPORTED_WORDS)
+                {
+                    fprintf(stderr, "Warning: %s line %d: skipping '%.*s' (%s)\n", filename, lineNumber, (int)length, token,
+                            length > BOARD_SIZE ? "longer than 15 letters" : "not a word of letters A-Z");
+                }
+                continue;
+            }
+
+            if (dictionary->trie != NULL)
+            {
+                int shared = 0;
+                while (shared < previousLength && word[shared] == previousWord[shared])
+                {
+                    shared++;
+                }
+                insertWordAlongPath(dictionary->trie, path, word, (int)length, shared);
+                memcpy(previousWord, word, sizeof(word));
+                previousLength = (int)length;
+                if (reverseTrie)
+                {
+                    insertReversedWord(dictionary->trie, word);
+                }
+            }
+            if (dictionary->gaddag != NULL)
+            {
+                insertGaddagWord(dictionary->gaddag, word);
+            }
+            if (collectWords)
+            {
+                if (totalWords == wordCapacity)
+                {
+                    wordCapacity = wordCapacity == 0 ? 4096 : wordCapacity * 2;
+                    words = realloc(words, wordCapacity * sizeof(*words));
+                    if (words == NULL)
+                    {
+                        perror("Failed to allocate memory");
+                        exit(1);
+                    }
+                }
+                memcpy(words[totalWords++], word, sizeof(word));
+            }
         }
+        cursor = lineEnd + 1;
+    }
 
-        insertWord(root, word);
+    if (skippedWords > MAX_REPORTED_WORDS)
+    {
+        fprintf(stderr, "Warning: %s: %d more words skipped\n", filename, skippedWords - MAX_REPORTED_WORDS);
     }
 
-    fclose(file);
-    return root;
+    if (collectWords)
+    {
+        sortWordList(words, totalWords);
+    }
+    if (parallelTrie)
+    {
+        long cores = sysconf(_SC_NPROCESSORS_ONLN);
+        dictionary->trie = buildTrieParallel(words, totalWords, cores > 0 ? (int)cores : 1);
+        for (size_t i = 0; reverseTrie && i < totalWords; i++)
+        {
+            insertReversedWord(dictionary->trie, words[i]);
+        }
+    }
+    if (structures & DICTIONARY_DAWG)
+    {
+        DawgBuilder *builder = createDawgBuilder();
+        for (size_t i = 0; i < totalWords; i++)
+        {
+            addDawgWord(builder, words[i]);
+        }
+        dictionary->dawg = finishDawg(builder);
+    }
+    if (structures & DICTIONARY_COMPACT_TRIE)
+    {
+        dictionary->compactTrie = createCompactTrie(words, totalWords);
+    }
+    free(words);
+
+    releaseTextFile(text, size, mapped);
+    return dictionary;
+}
+
+/*---------- FUNCTION: readTextFile -----------------------------------
+/   Function Description:
+/     Makes the whole contents of a file available in memory. Regular files
+/     are mapped read-only; anything that cannot be mapped (a pipe, for
+/     example) is read in large blocks into a growing buffer instead.
+/
+/   Caller Input:
+/     - const char *filename: Path to the file.
+/     - size_t *size: Receives the number of bytes.
+/     - bool *mapped: Receives whether the contents are mapped.
+/
+/   Caller Output:
+/     - char *: The contents (not null terminated). Release with releaseTextFile.
+/
+/   Assumptions, Limitations, Known Bugs:
+/     - Exits the program if the file cannot be opened or read.
+/
+-------------------------------------------------------------------------*/
+static char *readTextFile(const char *filename, size_t *size, bool *mapped)
+{
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0)
+    {
+        perror("Failed to open dictionary file");
+        exit(1);
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0)
+    {
+        char *text = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (text != MAP_FAILED)
+        {
+            madvise(text, (size_t)info.st_size, MADV_SEQUENTIAL);
+            close(fd);
+            *size = (size_t)info.st_size;
+            *mapped = true;
+            return text;
+        }
+    }
+
+    size_t capacity = READ_BLOCK_SIZE;
+    size_t used = 0;
+    char *text = malloc(capacity);
+    if (text == NULL)
+    {
+        perror("Failed to allocate memory");
+        exit(1);
+    }
+    for (;;)
+    {
+        if (capacity - used < READ_BLOCK_SIZE)
+        {
+            capacity *= 2;
+            text = realloc(text, capacity);
+            if (text == NULL)
+            {
+                perror("Failed to allocate memory");
+                exit(1);
+            }
+        }
+        ssize_t bytesRead = read(fd, text + used, READ_BLOCK_SIZE);
+        if (bytesRead < 0)
+        {
+            perror("Failed to read dictionary file");
+            exit(1);
+        }
+        if (bytesRead == 0)
+        {
+            break;
+        }
+        used += (size_t)bytesRead;
+    }
+
+    close(fd);
+    *size = used;
+    *mapped = false;
+    return text;
+}
+
+/*---------- FUNCTION: releaseTextFile -----------------------------------
+/   Function Description:
+/     Releases contents returned by readTextFile.
+/
+/   Caller Input:
+/     - char *text: The contents.
+/     - size_t size: Number of bytes.
+/     - bool mapped: Whether the contents are mapped.
+/
+/   Caller Output:
+/     - void: No return value.
+/
+/   Assumptions, Limitations, Known Bugs:
+/     - N/A
+/
+-------------------------------------------------------------------------*/
+static void releaseTextFile(char *text, size_t size, bool mapped)
+{
+    if (mapped)
+    {
+        munmap(text, size);
+    }
+    else
+    {
+        free(text);
+    }
+}
+
+/*---------- FUNCTION: foldWord -----------------------------------
+/   Function Description:
+/     Copies a word out of the file contents, converting it to uppercase and
+/     checking that it can be stored. The fold is branch-free so the compiler
+/     can process the whole word at once.
+/
+/   Caller Input:
+/     - const char *token: First character of the word.
+/     - size_t length: Number of characters.
+/     - char word[16]: Receives the uppercase, null terminated word.
+/
+/   Caller Output:
+/     - bool: True if the word has 1 to 15 characters, all letters.
+/
+/   Assumptions, Limitations, Known Bugs:
+/     - word is left undefined when false is returned.
+/
+-------------------------------------------------------------------------*/
+static bool foldWord(const char *token, size_t length, char word[16])
+{
+    if (length == 0 || length > BOARD_SIZE)
+    {
+        return false;
+    }
+
+    unsigned char invalid = 0;
+    for (size_t i = 0; i < length; i++)
+    {
+        unsigned char letter = (unsigned char)token[i];
+        letter -= (unsigned char)(((unsigned)(letter - 'a') < 26u) << 5);
+        invalid |= (unsigned char)((unsigned)(letter - 'A') >= 26u);
+        word[i] = (char)letter;
+    }
+    word[length] = '\0';
+    return invalid == 0;
+}
+
+/*---------- FUNCTION: loadDictionaryImage -----------------------------------
+/   Function Description:
+/     Maps a precompiled dictionary image (see dawgImage.h) as the DAWG of a
+/     new Dictionary, without reading or rebuilding any words.
+/
+/   Caller Input:
+/     - const char *filename: Path to the image written by compileDictionaryImage.
+/
+/   Caller Output:
+/     - Dictionary *: A Dictionary holding only the mapped DAWG, or NULL if
+/       the image was rejected. Release with freeDictionary.
+/
+/   Assumptions, Limitations, Known Bugs:
+/     - The reason for a rejection is printed to stderr.
+/
+-------------------------------------------------------------------------*/
+Dictionary *loadDictionaryImage(const char *filename)
+{
+    Dawg *dawg = mapDawgImage(filename);
+    if (dawg == NULL)
+    {
+        return NULL;
+    }
+
+    Dictionary *dictionary = malloc(sizeof(Dictionary));
+    if (dictionary == NULL)
+    {
+        perror("Failed to allocate memory");
+        exit(1);
+    }
+    dictionary->trie = NULL;
+    dictionary->gaddag = NULL;
+    dictionary->dawg = dawg;
+    dictionary->compactTrie = NULL;
+    return dictionary;
+}
+
+/*---------- FUNCTION: compileDictionaryImage -----------------------------------
+/   Function Description:
+/     Builds the DAWG for a text dictionary and writes it as an image that
+/     loadDictionaryImage can map.
+/
+/   Caller Input:
+/     - const char *dictionaryFile: Path to the text dictionary.
+/     - const char *imageFile: Path of the image to create or replace.
+/
+/   Caller Output:
+/     - bool: True if the image was written.
+/
+/   Assumptions, Limitations, Known Bugs:
+/     - Exits the program if the text dictionary cannot be opened.
+/
+-------------------------------------------------------------------------*/
+bool compileDictionaryImage(const char *dictionaryFile, const char *imageFile)
+{
+    Dictionary *dictionary = loadDictionaryStructures(dictionaryFile, DICTIONARY_DAWG);
+    bool saved = saveDawgImage(dictionary->dawg, imageFile);
+
+    freeDictionary(dictionary);
+    return saved;
+}
+
+/*---------- FUNCTION: compareWords -----------------------------------
+/   Function Description:
+/     qsort comparator for the fixed-size word records used to build the DAWG.
+/
+/   Caller Input:
+/     - const void *a: First word.
+/     - const void *b: Second word.
+/
+/   Caller Output:
+/     - int: Negative, zero or positive like strcmp.
+/
+/   Assumptions, Limitations, Known Bugs:
+/     - N/A
+/
+-------------------------------------------------------------------------*/
+static int compareWords(const void *a, const void *b)
+{
+    return strcmp((const char *)a, (const char *)b);
+}
+
+/*---------- FUNCTION: sortWordList -----------------------------------
+/   Function Description:
+/     Sorts a collected word list for the structures that are built from
+/     sorted input, unless it is already in order.
+/
+/   Caller Input:
+/     - char (*words)[16]: The words, uppercase and null terminated.
+/     - size_t totalWords: Number of words.
+/
+/   Caller Output:
+/     - void: No return value.
+/
+/   Assumptions, Limitations, Known Bugs:
+/     - N/A
+/
+-------------------------------------------------------------------------*/
+static void sortWordList(char (*words)[16], size_t totalWords)
+{
+    for (size_t i = 1; i < totalWords; i++)
+    {
+        if (strcmp(words[i - 1], words[i]) > 0)
+        {
+            qsort(words, totalWords, sizeof(*words), compareWords);
+            return;
+        }
+    }
 }
 
 void printBestMove(Move bestMove, char *rack, Square board[BOARD_SIZE][BOARD_SIZE])
 {
+    // The tiles are placed on copies, so the caller's rack and board stay as they were
+    Square placedBoard[BOARD_SIZE][BOARD_SIZE];
+    char rackLeft[BOARD_SIZE + 1];
+    memcpy(placedBoard, board, sizeof(placedBoard));
+    snprintf(rackLeft, sizeof(rackLeft), "%s", rack);
 
     char usedLetters[BOARD_SIZE] = {0};
-    findUsedLetters(usedLetters, bestMove.word, rack);
-    char *placements = findTilePlacements(board, usedLetters, bestMove);
+    findUsedLetters(usedLetters, bestMove.word, rackLeft);
+    char *placements = findTilePlacements(placedBoard, bestMove);
 
     printf("Word: %s\nRack Letters Used: %s\nPosition: (%d,%d)\n", bestMove.word, usedLetters, bestMove.row + 1, bestMove.col + 1);
 
@@ -93,12 +523,12 @@ void printBestMove(Move bestMove, char *rack, Square board[BOARD_SIZE][BOARD_SIZ
     printf("Score: %d\n", bestMove.score);
 
     printf("Board after placement:\n");
-    printBoard(board);
+    printBoard(placedBoard);
     free(placements);
     placements = NULL;
 }
 
-char *findTilePlacements(Square board[BOARD_SIZE][BOARD_SIZE], char *usedLetters, Move bestMove)
+char *findTilePlacements(Square board[BOARD_SIZE][BOARD_SIZE], Move bestMove)
 {
     char *placements = (char *)malloc(1024 * sizeof(char));
     if (!placements)
@@ -108,45 +538,11 @@ char *findTilePlacements(Square board[BOARD_SIZE][BOARD_SIZE], char *usedLetters
     }
     memset(placements, 0, 1024);
 
-    int currentRow;
-    int currentCol;
-
-    if (bestMove.isReversed)
+    for (int i = 0; bestMove.word[i] != '\0'; i++)
     {
-        switch (bestMove.direction)
-        {
-        case (RIGHT):
-            currentRow = bestMove.row;
-            currentCol = bestMove.col;
-            break;
-        case (LEFT):
-            currentRow = bestMove.row;
-            currentCol = bestMove.col - 1;
-            break;
-        case (UP):
-            currentRow = bestMove.row;
-            currentCol = bestMove.col;
-            break;
-        case (DOWN):
-            currentRow = bestMove.row;
-            currentCol = bestMove.col;
-            break;
-        default:
-            fprintf(stderr, "Invalid direction\n");
-            free(placements);
-            return NULL;
-        }
-    }
-    else
-    {
-        currentRow = bestMove.row;
-        currentCol = bestMove.col;
-    }
-    int direction = bestMove.direction;
-    int letterIndex = 0; // Tracks which letter of usedLetters we're on
+        int currentRow = bestMove.row + (bestMove.direction == DOWN ? i : 0);
+        int currentCol = bestMove.col + (bestMove.direction == RIGHT ? i : 0);
 
-    while (letterIndex < (int)strlen(usedLetters))
-    {
         // Out-of-bounds check
         if (currentRow < 0 || currentRow >= BOARD_SIZE ||
             currentCol < 0 || currentCol >= BOARD_SIZE)
@@ -154,36 +550,14 @@ char *findTilePlacements(Square board[BOARD_SIZE][BOARD_SIZE], char *usedLetters
             break;
         }
 
-        // If this square is empty, place the next letter
+        // If this square is empty, the move places this letter there
         if (board[currentRow][currentCol].letter == ' ')
         {
-            board[currentRow][currentCol].letter = usedLetters[letterIndex];
+            board[currentRow][currentCol].letter = bestMove.word[i];
             char temp[128];
             sprintf(temp, "  Row: %d, Col: %d, Char: %c\n",
-                    currentRow + 1, currentCol + 1, usedLetters[letterIndex]);
+                    currentRow + 1, currentCol + 1, bestMove.word[i]);
             strcat(placements, temp);
-            letterIndex++;
-        }
-
-        // Move to the next square in the specified direction
-        switch (direction)
-        {
-        case UP:
-            currentRow--;
-            break;
-        case DOWN:
-            currentRow++;
-            break;
-        case LEFT:
-            currentCol--;
-            break;
-        case RIGHT:
-            currentCol++;
-            break;
-        default:
-            fprintf(stderr, "Invalid direction\n");
-            free(placements);
-            return NULL;
         }
     }
     return placements;
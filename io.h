@@ -4,7 +4,9 @@
 /
 /   File Description:
 /     This header file declares functions related to input/output operations,
-/     specifically for loading a dictionary from a file into a Trie data structure.
+/     specifically for loading a dictionary from a file into a Trie, GADDAG
+/     and/or DAWG, for precompiled dictionary images, and for printing the
+/     chosen move.
 /
 /---------------------------------------------------------*/
 #ifndef IO_H
@@ -14,13 +16,21 @@
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 #include "dataStruct.h"
-
+#include "dictionary.h"
+#include "dawgImage.h"
 
 TrieNode *loadDictionary(const char *filename);
+Dictionary *loadDictionaryStructures(const char *filename, int structures);
+Dictionary *loadDictionaryImage(const char *filename);
+bool compileDictionaryImage(const char *dictionaryFile, const char *imageFile);
 void printBestMove(Move bestMove, char *rack, Square board[BOARD_SIZE][BOARD_SIZE]);
-char* findTilePlacements(Square board[BOARD_SIZE][BOARD_SIZE], char* usedLetters, Move bestMove);
+char* findTilePlacements(Square board[BOARD_SIZE][BOARD_SIZE], Move bestMove);
 void findUsedLetters(char *usedLetters, const char *word, char *rack);
 
 #endif
\ No newline at end of file
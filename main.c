@@ -5,43 +5,291 @@
 /   File Description:
 /     This file is the main entry point for the Scrabble solver.
 /     It takes a board file, rack letters, and a dictionary file as command-line
-/     arguments. It loads the game board, generates letter combinations from
-/     the rack, finds valid moves using the dictionary, and determines the
-/     best move based on score. It then prints the best move details to the
-/     console.
+/     arguments. It loads the game board and the dictionary (as a minimised
+/     DAWG), finds every valid move for the rack whose perpendicular words
+/     are valid as well, and determines the best move based on score. It
+/     then prints the best move details to the console. The search can be
+/     spread over several threads with --threads <count> (0 for one per core).
+/     The dictionary and search threads live in a SolverContext. With
+/     --batch it instead solves a whole stream of board/rack jobs against
+/     one loaded dictionary (see batch.h), reporting the best --top moves
+/     of each, and with --serve it stays resident and answers solve
+/     requests over a Unix domain socket (see server.h). --time-limit <ms>
+/     turns every search into an anytime search that returns the best move
+/     found within the limit.
 /
 /---------------------------------------------------------*/
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <math.h>
+#include <unistd.h>
+#include <signal.h>
 #include "io.h"
 #include "dataStruct.h"
 #include "solver.h"
+#include "moveGenerator.h"
+#include "solverContext.h"
+#include "batch.h"
+#include "server.h"
+
+#define MAX_THREAD_OPTION 1024 // Highest --threads count accepted
+
+/* FUNCTION PROTOTYPES*/
+static void printUsage(const char *program);
+static bool parseIntOption(const char *text, int min, int max, int *value);
+static bool parseMillisecondsOption(const char *text, double *seconds);
+static int runBatchCommand(const char *dictionaryFile, const char *jobFile, int threads, int topMoves, SearchBudget budget);
+static int runServeCommand(const char *dictionaryFile, const char *socketPath, int threads, int topMoves, SearchBudget budget);
+static void handleStopSignal(int signalNumber);
+
+static Server *runningServer = NULL; // Service stopped by SIGINT and SIGTERM
+
 
 int main(int argc, char *argv[]){
+    const char *program = argv[0];
+    if (argc == 4 && strcmp(argv[1], "--compile") == 0){
+        return compileDictionaryImage(argv[2], argv[3]) ? 0 : 1;
+    }
+    int threads = 1;
+    int topMoves = 1;
+    SearchBudget budget = SEARCH_EXHAUSTIVE;
+    while (argc >= 3 && (strcmp(argv[1], "--threads") == 0 || strcmp(argv[1], "--top") == 0 || strcmp(argv[1], "--time-limit") == 0)){
+        bool valid;
+        if (strcmp(argv[1], "--top") == 0){
+            valid = parseIntOption(argv[2], 1, MAX_FOUND_MOVES, &topMoves);
+        }
+        else if (strcmp(argv[1], "--time-limit") == 0){
+            valid = parseMillisecondsOption(argv[2], &budget.seconds);
+        }
+        else {
+            valid = parseIntOption(argv[2], 0, MAX_THREAD_OPTION, &threads);
+            if (valid && threads == 0){
+                long cores = sysconf(_SC_NPROCESSORS_ONLN);
+                threads = cores > 0 ? (int)cores : 1;
+            }
+        }
+        if (!valid){
+            fprintf(stderr, "Invalid value for %s: %s\n", argv[1], argv[2]);
+            printUsage(program);
+            return 1;
+        }
+        argv += 2;
+        argc -= 2;
+    }
+    if ((argc == 3 || argc == 4) && strcmp(argv[1], "--batch") == 0){
+        return runBatchCommand(argv[2], argc == 4 ? argv[3] : "-", threads, topMoves, budget);
+    }
+    if (argc == 4 && strcmp(argv[1], "--serve") == 0){
+        return runServeCommand(argv[2], argv[3], threads, topMoves, budget);
+    }
     if (argc < 4){
-        fprintf(stderr, "Usage: %s <board_file> <rack_letters> <dictionary_file>\n", argv[0]);
+        printUsage(program);
         return 1;
     }
     char *rack = argv[2];
-    TrieNode *root = loadDictionary(argv[3]);
-    Square board[BOARD_SIZE][BOARD_SIZE];
+    Board board;
 
-    initBoard(board);
-    loadBoard(board, argv[1]);
+    initBoard(&board);
+    loadBoard(&board, argv[1]);
 
-    if (!validateBoard(board)){
+    if (!validateBoard(&board)){
         printf("Board validation failed!\n");
         return 1;
     }
 
-    if (!root){
+    // The dictionary is only loaded for a board that can be solved
+    SolverContext *context = createSolverContext(argv[3], DICTIONARY_DAWG, threads);
+    if (!context){
         fprintf(stderr, "Failed to load dictionary.\n");
         return 1;
     }
 
-    Move bestMove = findBestMove(root, board, rack);
-    printBestMove(bestMove, rack, board);
+    Move bestMove = {0, 0, 0, " ", 0};
+    bool complete = true;
+    solveTopMovesWithin(context, &board, rack, &bestMove, 1, budget, &complete);
+    printBestMove(bestMove, rack, board.squares);
+    if (!complete){
+        fprintf(stderr, "Time limit reached: this is the best move found, it may not be the best there is.\n");
+    }
 
-    freeTrie(root);
+    freeSolverContext(context);
     return 0;
 }
+
+/*---------- FUNCTION: printUsage -----------------------------------
+/   Function Description:
+/     Prints the command line forms the program accepts to stderr.
+/   Caller Input:
+/     - const char *program: Name the program was started as.
+/   Caller Output:
+/     - void: No return value.
+/   Assumptions, Limitations, Known Bugs:
+/     - N/A
+/---------------------------------------------------------*/
+static void printUsage(const char *program){
+    fprintf(stderr, "Usage: %s [--threads <count>] [--time-limit <ms>] <board_file> <rack_letters> <dictionary_file|dictionary_image>\n", program);
+    fprintf(stderr, "       %s [--threads <count>] [--top <moves>] [--time-limit <ms>] --batch <dictionary_file|dictionary_image> [job_file|-]\n", program);
+    fprintf(stderr, "       %s [--threads <count>] [--top <moves>] [--time-limit <ms>] --serve <dictionary_file|dictionary_image> <socket_path>\n", program);
+    fprintf(stderr, "       %s --compile <dictionary_file> <dictionary_image>\n", program);
+}
+
+/*---------- FUNCTION: parseIntOption -----------------------------------
+/   Function Description:
+/     Reads the whole-number value of a command line option.
+/   Caller Input:
+/     - const char *text: The option's argument.
+/     - int min: Lowest value accepted.
+/     - int max: Highest value accepted.
+/     - int *value: Receives the value.
+/   Caller Output:
+/     - bool: False, with value unchanged, unless text is a base 10
+/       integer from min to max and nothing else.
+/   Assumptions, Limitations, Known Bugs:
+/     - N/A
+/---------------------------------------------------------*/
+static bool parseIntOption(const char *text, int min, int max, int *value){
+    char *end;
+    errno = 0;
+    long parsed = strtol(text, &end, 10);
+    if (end == text || *end != '\0' || errno == ERANGE || parsed < min || parsed > max){
+        return false;
+    }
+    *value = (int)parsed;
+    return true;
+}
+
+/*---------- FUNCTION: parseMillisecondsOption -----------------------------------
+/   Function Description:
+/     Reads a time limit given in milliseconds.
+/   Caller Input:
+/     - const char *text: The option's argument.
+/     - double *seconds: Receives the limit in seconds.
+/   Caller Output:
+/     - bool: False, with seconds unchanged, unless text is a positive,
+/       finite number and nothing else.
+/   Assumptions, Limitations, Known Bugs:
+/     - Fractions of a millisecond are kept.
+/---------------------------------------------------------*/
+static bool parseMillisecondsOption(const char *text, double *seconds){
+    char *end;
+    errno = 0;
+    double parsed = strtod(text, &end);
+    if (end == text || *end != '\0' || errno == ERANGE || !isfinite(parsed) || parsed <= 0){
+        return false;
+    }
+    *seconds = parsed / 1000.0;
+    return true;
+}
+
+/*---------- FUNCTION: runBatchCommand -----------------------------------
+/   Function Description:
+/     Loads the dictionary once and solves every job of a job file, writing
+/     the results to stdout and the throughput to stderr.
+/   Caller Input:
+/     - const char *dictionaryFile: Dictionary file or compiled image.
+/     - const char *jobFile: Job file, "-" for stdin.
+/     - int threads: Number of worker threads.
+/     - int topMoves: Moves reported per job.
+/     - SearchBudget budget: Limits of each job's search.
+/   Caller Output:
+/     - int: Exit status, 1 if nothing could be solved.
+/   Assumptions, Limitations, Known Bugs:
+/     - Jobs that fail are reported in the output and do not change the
+/       exit status.
+/---------------------------------------------------------*/
+static int runBatchCommand(const char *dictionaryFile, const char *jobFile, int threads, int topMoves, SearchBudget budget){
+    FILE *input = strcmp(jobFile, "-") == 0 ? stdin : fopen(jobFile, "r");
+    if (!input){
+        perror("Failed to open job file");
+        return 1;
+    }
+    SolverContext *context = createSolverContext(dictionaryFile, DICTIONARY_DAWG, 1);
+    if (!context){
+        fprintf(stderr, "Failed to load dictionary.\n");
+        if (input != stdin){
+            fclose(input);
+        }
+        return 1;
+    }
+
+    BatchStats stats;
+    bool solved = runBatch(solverContextDictionary(context), input, stdout, threads, topMoves, budget, &stats);
+    if (solved){
+        fprintf(stderr, "Solved %ld positions in %.2f s (%.1f positions/s), %ld failed, %ld stopped at the time limit\n",
+                stats.jobs, stats.seconds, stats.seconds > 0 ? stats.jobs / stats.seconds : 0.0, stats.failedJobs, stats.partialJobs);
+    }
+
+    freeSolverContext(context);
+    if (input != stdin){
+        fclose(input);
+    }
+    return solved ? 0 : 1;
+}
+
+/*---------- FUNCTION: handleStopSignal -----------------------------------
+/   Function Description:
+/     Stops the running service on SIGINT or SIGTERM.
+/   Caller Input:
+/     - int signalNumber: The signal.
+/   Caller Output:
+/     - void: No return value.
+/   Assumptions, Limitations, Known Bugs:
+/     - stopServer is signal safe.
+/---------------------------------------------------------*/
+static void handleStopSignal(int signalNumber){
+    (void)signalNumber;
+    if (runningServer){
+        stopServer(runningServer);
+    }
+}
+
+/*---------- FUNCTION: runServeCommand -----------------------------------
+/   Function Description:
+/     Loads the dictionary once and serves solve requests on a Unix domain
+/     socket until SIGINT or SIGTERM, then prints the service counters.
+/   Caller Input:
+/     - const char *dictionaryFile: Dictionary file or compiled image.
+/     - const char *socketPath: Path of the socket.
+/     - int threads: Number of worker threads.
+/     - int topMoves: Moves reported per job.
+/     - SearchBudget budget: Limits of each job's search.
+/   Caller Output:
+/     - int: Exit status, 1 if the service could not be started.
+/   Assumptions, Limitations, Known Bugs:
+/     - N/A
+/---------------------------------------------------------*/
+static int runServeCommand(const char *dictionaryFile, const char *socketPath, int threads, int topMoves, SearchBudget budget){
+    SolverContext *context = createSolverContext(dictionaryFile, DICTIONARY_DAWG, 1);
+    if (!context){
+        fprintf(stderr, "Failed to load dictionary.\n");
+        return 1;
+    }
+    Server *server = createServer(solverContextDictionary(context), socketPath, threads, topMoves, budget);
+    if (!server){
+        freeSolverContext(context);
+        return 1;
+    }
+
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = handleStopSignal;
+    sigemptyset(&action.sa_mask);
+    runningServer = server;
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+
+    fprintf(stderr, "Serving on %s with %d workers\n", socketPath, threads);
+    bool served = runServer(server);
+
+    ServerStats stats;
+    serverStats(server, &stats);
+    fprintf(stderr, "Answered %ld requests (%ld failed, %ld stopped at the time limit), p50 %ld us, p99 %ld us, max queue depth %d\n",
+            stats.requests, stats.failedRequests, stats.partialRequests, stats.p50Micros, stats.p99Micros, stats.maxQueueDepth);
+
+    runningServer = NULL;
+    freeServer(server);
+    freeSolverContext(context);
+    return served ? 0 : 1;
+}
@@ -0,0 +1,1779 @@
+/*---------- ID HEADER -------------------------------------
+/   Author(s):    Aidan Andrews, Kyle Scidmore
+/   File Name:    moveGenerator.c
+/
+/   File Description:
+/     This file implements the anchor-based move generator. For every valid
+/     placement square and direction the dictionary is walked once, placing
+/     rack tiles on empty squares and following existing board letters.
+/
+/     With a forward dictionary (the DAWG, compact Trie or Trie, walked through the
+/     cursor interface of dictionary.h), words that grow DOWN or RIGHT are
+/     walked from the anchor; words that grow UP or LEFT are walked from each
+/     possible first square back towards the anchor, so the dictionary can
+/     prune every branch as soon as it stops being a prefix. The GADDAG walk
+/     starts on each empty anchor instead, once along its row and once along
+/     its column: it follows the reversed prefix UP or LEFT away from the
+/     anchor, crosses the separator and continues with the suffix DOWN or
+/     RIGHT of it, so it also finds the words that run through the anchor.
+/
+/     With a forward dictionary the produced moves are identical to those of
+/     findMoves in solver.c and are returned in the same order (rack
+/     combination, then column, row and direction of the anchor); the GADDAG
+/     finds each of them once, plus the words through an anchor, in the same
+/     order. Once computeCrossChecks has filled in the
+/     cross-check masks of the board, a tile that would form an invalid
+/     perpendicular word is rejected with a single AND.
+/
+/---------------------------------------------------------*/
+#include "moveGenerator.h"
+#include "solver.h"
+#include "gaddag.h"
+#include "dictionary.h"
+
+// Score of the letters walked so far, kept the way calculateScore computes it
+typedef struct PartialScore
+{
+    int letterSum;      // Letter values times their letter multipliers.
+    int wordMultiplier; // Product of the word multipliers.
+    int crossWords;     // Score of the perpendicular words formed by the rack tiles.
+} PartialScore;
+
+// State shared by every step of one anchor search
+typedef struct SearchState
+{
+    const Dictionary *dictionary; // Forward dictionary to walk, used when gaddag is NULL.
+    const Gaddag *gaddag;  // GADDAG to walk instead of the Trie.
+    Square (*board)[BOARD_SIZE];
+    PackedBoard packed;         // Packed copy of the board the walks run on.
+    const char *letters;        // Letter plane of the packed board for the current direction.
+    const uint32_t *crossCheck; // Cross-check plane of the packed board for the current direction.
+    const uint16_t *crossScore; // Cross score plane of the packed board for the current direction.
+    const uint8_t *letterMultiplier; // Multiplier planes of the packed board for the current direction.
+    const uint8_t *wordMultiplier;
+    int step;                   // Index step of the current direction inside its plane.
+    int rackCounts[MAX_CHARACTERS]; // How many of each letter are left on the rack.
+    uint32_t rackMask;              // Bit i set while rackCounts[i] is not zero.
+    int rackSize;                   // Letters on the full rack.
+    int rackValues[BOARD_SIZE];     // Letter values of the full rack, highest first.
+    int anchorRow;
+    int anchorCol;
+    int anchor; // Index of the anchor square in the plane.
+    int start;  // Index of the first square of an UP/LEFT or GADDAG word.
+    int prefixLength; // Letters of a GADDAG word walked before the separator.
+    BoardBits openAnchors; // Empty anchor squares, where the GADDAG searches start.
+    const uint16_t *openAnchorLines; // Lines of openAnchors along the current plane.
+    int direction;
+    char word[BOARD_SIZE + 1];  // Letters of the word in the order they were walked.
+    char tiles[BOARD_SIZE + 1]; // Rack tiles in the order they were placed.
+    int totalTiles;
+    MoveSink *sink;
+} SearchState;
+
+// Score bound of one anchor search, used to order and prune the searches
+typedef struct AnchorBound
+{
+    int bound;
+    int row;
+    int col;
+    int direction;
+} AnchorBound;
+
+// Squares from the anchor to some square on one side of it, summed up for the score bounds
+typedef struct SideBound
+{
+    int emptySquares;
+    int emptyMultipliers[4]; // Empty squares by letter multiplier.
+    int boardLetters;        // Board letters on their squares.
+    int wordProduct;
+    int crossWords;          // Best perpendicular word of every empty square.
+} SideBound;
+
+// Anchor searches owned by one worker of a parallel run
+typedef struct TaskQueue
+{
+    AnchorBound *tasks; // Highest bound first when pruning.
+    int head;           // Next task of the owner.
+    int tail;           // One past the task a thief takes next.
+    pthread_mutex_t lock;
+} TaskQueue;
+
+// One worker thread of a pool with its own scratch state and sink
+typedef struct GeneratorWorker
+{
+    GeneratorPool *pool;
+    int index;
+    SearchState state;
+    MoveSink sink;
+    GeneratedMove *moves; // Storage of the sink, kept between runs.
+    int capacity;         // Moves the storage holds.
+    TaskQueue queue;
+    pthread_t thread;
+} GeneratorWorker;
+
+// Worker threads kept between parallel runs, and the state one run shares
+struct GeneratorPool
+{
+    GeneratorWorker *workers;
+    int totalWorkers;   // Workers, including the calling thread as worker 0.
+    int startedThreads; // Workers 1 to startedThreads have a thread.
+    AnchorBound queued[BOARD_SQUARES * 4]; // Task storage of every queue.
+    pthread_mutex_t lock;
+    pthread_cond_t wake;  // Signalled when a run starts or the pool stops.
+    pthread_cond_t done;  // Signalled when the last busy thread finishes its part.
+    long runNumber;       // Increased for every run.
+    int busyThreads;      // Started threads still working on the current run.
+    bool stopping;
+    bool prune;    // Skip searches whose bound is below threshold.
+    int threshold; // Highest worst-kept score of any full worker sink, updated atomically.
+    long movesSeen;    // Moves offered to every worker sink, updated atomically when the run has a budget.
+    bool stoppedEarly; // A worker left searches undone because the budget ran out.
+};
+
+static const int rowStep[4] = {-1, 1, 0, 0};
+static const int colStep[4] = {0, 0, -1, 1};
+
+#define BINGO_TILES 7  // Rack tiles a move must use to earn the bingo bonus
+#define BINGO_BONUS 50
+
+/* FUNCTION PROTOTYPES*/
+static bool isOnBoard(int row, int col);
+static PartialScore scoreLetter(const SearchState *state, PartialScore score, int square, char letter, bool rackTile);
+static int finishScore(PartialScore score, int totalTiles);
+static bool endsWord(const SearchState *state, int square);
+static void recordMove(SearchState *state, int endSquare, const char *word, int wordLength, const char *tiles, int score);
+static void extendForward(SearchState *state, DictCursor node, int square, int wordLength, PartialScore score);
+static void extendToAnchor(SearchState *state, DictCursor node, int square, int wordLength, PartialScore score);
+static void recordAtAnchor(SearchState *state, int wordLength, PartialScore score);
+static void extendGaddagBackward(SearchState *state, uint32_t node, int square, int wordLength, PartialScore score);
+static void extendGaddagForward(SearchState *state, uint32_t node, int square, int wordLength, PartialScore score);
+static void recordGaddagMove(SearchState *state, int wordLength, PartialScore score);
+static bool searchesDirection(const SearchState *state, int direction);
+static void searchAnchor(SearchState *state);
+static void setAnchor(SearchState *state, int row, int col, int direction);
+static int sideScoreBounds(const SearchState *state, int square, int step, SideBound sides[]);
+static int runScoreBound(const SearchState *state, const SideBound *before, const SideBound *after);
+static int anchorScoreBound(const SearchState *state);
+static void siftAnchorBound(AnchorBound tasks[], int index, int totalTasks);
+static void sortAnchorBounds(AnchorBound tasks[], int totalTasks);
+static int collectAnchorTasks(SearchState *state, const BoardBits *anchors, AnchorBound tasks[], bool bounded);
+static void searchByBound(SearchState *state, const BoardBits *anchors);
+static bool takeTask(TaskQueue *queue, bool fromHead, AnchorBound *task);
+static void *runGeneratorWorker(void *argument);
+static void *runPoolThread(void *argument);
+static void searchInPool(SearchState *state, const BoardBits *anchors, MoveSink *sink, GeneratorPool *pool);
+static void runGenerator(SearchState *state, Board *board, const char *rack, MoveSink *sink, GeneratorPool *pool);
+static void generateIntoArray(SearchState *state, Board *board, const char *rack, Move foundMoves[], int *totalMovesFound, int maxMoves);
+static uint32_t crossCheckMask(const Dictionary *dictionary, const char *before, int beforeLength, const char *after, int afterLength);
+
+/*---------- FUNCTION: isOnBoard -----------------------------------
+/   Function Description:
+/     Checks if a row and column are inside the board.
+/   Caller Input:
+/     - int row: The row index.
+/     - int col: The column index.
+/   Caller Output:
+/     - bool: True if the square exists.
+/   Assumptions, Limitations, Known Bugs:
+/     - N/A
+/---------------------------------------------------------*/
+static bool isOnBoard(int row, int col)
+{
+    return row >= 0 && row < BOARD_SIZE && col >= 0 && col < BOARD_SIZE;
+}
+
+/*---------- FUNCTION: scoreLetter -----------------------------------
+/   Function Description:
+/     Adds one letter of the word to a partial score: its value on the
+/     square it is placed on and, for a rack tile with
+/     perpendicular neighbours, the perpendicular word it forms.
+/   Caller Input:
+/     - const SearchState *state: The current search state.
+/     - PartialScore score: Score of the letters before this one.
+/     - int square: Plane index of the square the letter is on.
+/     - char letter: The letter, 'A' to 'Z'.
+/     - bool rackTile: True if the letter is a rack tile placed on the square.
+/   Caller Output:
+/     - PartialScore: The score including the letter.
+/   Assumptions, Limitations, Known Bugs:
+/     - Letters may be added in any order.
+/---------------------------------------------------------*/
+static inline PartialScore scoreLetter(const SearchState *state, PartialScore score, int square, char letter, bool rackTile)
+{
+    int value = letterScores[letter - 'A'];
+
+    score.letterSum += value * state->letterMultiplier[square];
+    score.wordMultiplier *= state->wordMultiplier[square];
+    if (rackTile && state->crossScore[square] != 0)
+    {
+        score.crossWords += (state->crossScore[square] + value * state->letterMultiplier[square]) * state->wordMultiplier[square];
+    }
+    return score;
+}
+
+/*---------- FUNCTION: finishScore -----------------------------------
+/   Function Description:
+/     Turns the partial score of a complete word into the score of its move.
+/   Caller Input:
+/     - PartialScore score: Score of every letter of the word.
+/     - int totalTiles: Number of rack tiles the move uses.
+/   Caller Output:
+/     - int: The move score, equal to calculateScore plus the perpendicular words.
+/   Assumptions, Limitations, Known Bugs:
+/     - Like calculateScore, the bingo bonus is added before the word multiplier.
+/---------------------------------------------------------*/
+static inline int finishScore(PartialScore score, int totalTiles)
+{
+    int bingo = totalTiles == BINGO_TILES ? BINGO_BONUS : 0;
+    return (score.letterSum + bingo) * score.wordMultiplier + score.crossWords;
+}
+
+/*---------- FUNCTION: endsWord -----------------------------------
+/   Function Description:
+/     Checks that a word ends before a square, so no tile there runs into it.
+/   Caller Input:
+/     - const SearchState *state: The current search state.
+/     - int square: Plane index of the square past the word.
+/   Caller Output:
+/     - bool: True if the square is empty or the border.
+/   Assumptions, Limitations, Known Bugs:
+/     - N/A
+/---------------------------------------------------------*/
+static inline bool endsWord(const SearchState *state, int square)
+{
+    return state->letters[square] == ' ' || state->letters[square] == BORDER_LETTER;
+}
+
+/*---------- FUNCTION: recordMove -----------------------------------
+/   Function Description:
+/     Builds the Move record for a completed word and adds it to the move sink.
+/   Caller Input:
+/     - SearchState *state: The current search state.
+/     - int endSquare: Plane index of the last square of the word in search order.
+/     - const char *word: The word in reading order.
+/     - int wordLength: Length of the word.
+/     - const char *tiles: The state->totalTiles rack tiles in search order.
+/     - int score: The move score (see finishScore).
+/   Caller Output:
+/     - void: No return value.
+/   Assumptions, Limitations, Known Bugs:
+/     - The move holds the first square of the word and the direction it
+/       reads in, like dfs in solver.c. For UP/LEFT the end square is the
+/       first square of the word; for DOWN/RIGHT it is the last one.
+/---------------------------------------------------------*/
+static void recordMove(SearchState *state, int endSquare, const char *word, int wordLength, const char *tiles, int score)
+{
+    GeneratedMove generatedMove;
+    Move *move = &generatedMove.move;
+
+    // Plane 1 is row-major, plane 0 transposed
+    int major = endSquare / PADDED_SIZE - 1;
+    int minor = endSquare % PADDED_SIZE - 1;
+    int endRow = PACKED_PLANE(state->direction) == 1 ? major : minor;
+    int endCol = PACKED_PLANE(state->direction) == 1 ? minor : major;
+
+    memcpy(move->word, word, wordLength);
+    move->word[wordLength] = '\0';
+    memcpy(generatedMove.tiles, tiles, state->totalTiles);
+    generatedMove.tiles[state->totalTiles] = '\0';
+    move->row = state->direction == DOWN ? endRow - wordLength + 1 : endRow;
+    move->col = state->direction == RIGHT ? endCol - wordLength + 1 : endCol;
+    move->direction = PACKED_PLANE(state->direction) == 1 ? RIGHT : DOWN;
+    move->score = score;
+
+    generatedMove.origin = (state->anchorCol * BOARD_SIZE + state->anchorRow) * 4 + state->direction;
+    addToMoveSink(state->sink, &generatedMove);
+}
+
+/*---------- FUNCTION: extendForward -----------------------------------
+/   Function Description:
+/     Extends a DOWN or RIGHT word one square at a time, following board
+/     letters and trying every distinct rack letter on empty squares.
+/   Caller Input:
+/     - SearchState *state: The current search state.
+/     - DictCursor node: Dictionary cursor for the letters placed so far.
+/     - int square: Plane index of the square to fill next.
+/     - int wordLength: Number of letters placed so far.
+/     - PartialScore score: Score of the letters placed so far.
+/   Caller Output:
+/     - void: No return value. Records every word completed by a rack tile.
+/   Assumptions, Limitations, Known Bugs:
+/     - A move is only recorded when a rack tile completes the word and
+/       the square after it holds no tile (see endsWord).
+/     - The border letter never continues a word, so the walk needs no
+/       bounds check.
+/---------------------------------------------------------*/
+static void extendForward(SearchState *state, DictCursor node, int square, int wordLength, PartialScore score)
+{
+    const Dictionary *dictionary = state->dictionary;
+    char boardLetter = state->letters[square];
+
+    if (boardLetter != ' ')
+    {
+        DictCursor child = dictionaryChild(dictionary, node, boardLetter);
+        if (child != DICT_CURSOR_NONE)
+        {
+            state->word[wordLength] = boardLetter;
+            extendForward(state, child, square + state->step, wordLength + 1, scoreLetter(state, score, square, boardLetter, false));
+        }
+        return;
+    }
+
+    // Only letters that continue a word, are still on the rack and pass the cross-check
+    uint32_t letters = dictionaryChildMask(dictionary, node) & state->rackMask & state->crossCheck[square];
+    while (letters != 0)
+    {
+        int i = __builtin_ctz(letters);
+        letters &= letters - 1;
+
+        DictCursor child = dictionaryChild(dictionary, node, 'A' + i);
+        if (--state->rackCounts[i] == 0)
+        {
+            state->rackMask &= ~(1u << i);
+        }
+        state->word[wordLength] = 'A' + i;
+        state->tiles[state->totalTiles++] = 'A' + i;
+
+        PartialScore placed = scoreLetter(state, score, square, 'A' + i, true);
+        if (dictionaryIsWord(dictionary, child) && endsWord(state, square + state->step))
+        {
+            recordMove(state, square, state->word, wordLength + 1, state->tiles, finishScore(placed, state->totalTiles));
+        }
+        extendForward(state, child, square + state->step, wordLength + 1, placed);
+
+        state->totalTiles--;
+        state->rackCounts[i]++;
+        state->rackMask |= 1u << i;
+    }
+}
+
+/*---------- FUNCTION: extendToAnchor -----------------------------------
+/   Function Description:
+/     Builds an UP or LEFT word in reading order, starting from its first
+/     square and walking back towards the anchor square.
+/   Caller Input:
+/     - SearchState *state: The current search state.
+/     - DictCursor node: Dictionary cursor for the letters placed so far.
+/     - int square: Plane index of the square to fill next.
+/     - int wordLength: Number of letters placed so far.
+/     - PartialScore score: Score of the letters placed so far.
+/   Caller Output:
+/     - void: No return value. Records the word if it is valid at the anchor.
+/   Assumptions, Limitations, Known Bugs:
+/     - The caller guarantees the first square is empty and the square
+/       before it holds no tile, so the word always ends (in search order)
+/       with a rack tile and nothing runs into it.
+/---------------------------------------------------------*/
+static void extendToAnchor(SearchState *state, DictCursor node, int square, int wordLength, PartialScore score)
+{
+    // Walking towards the anchor is the opposite of the search direction
+    const Dictionary *dictionary = state->dictionary;
+    int next = square - state->step;
+    bool atAnchor = (square == state->anchor);
+    char boardLetter = state->letters[square];
+
+    if (boardLetter != ' ')
+    {
+        DictCursor child = dictionaryChild(dictionary, node, boardLetter);
+        if (child == DICT_CURSOR_NONE)
+        {
+            return;
+        }
+        state->word[wordLength] = boardLetter;
+        score = scoreLetter(state, score, square, boardLetter, false);
+        if (atAnchor)
+        {
+            if (dictionaryIsWord(dictionary, child))
+            {
+                recordAtAnchor(state, wordLength + 1, score);
+            }
+            return;
+        }
+        extendToAnchor(state, child, next, wordLength + 1, score);
+        return;
+    }
+
+    // Only letters that continue a word, are still on the rack and pass the cross-check
+    uint32_t letters = dictionaryChildMask(dictionary, node) & state->rackMask & state->crossCheck[square];
+    while (letters != 0)
+    {
+        int i = __builtin_ctz(letters);
+        letters &= letters - 1;
+
+        DictCursor child = dictionaryChild(dictionary, node, 'A' + i);
+        if (--state->rackCounts[i] == 0)
+        {
+            state->rackMask &= ~(1u << i);
+        }
+        state->word[wordLength] = 'A' + i;
+        state->tiles[state->totalTiles++] = 'A' + i;
+
+        PartialScore placed = scoreLetter(state, score, square, 'A' + i, true);
+        if (atAnchor)
+        {
+            if (dictionaryIsWord(dictionary, child))
+            {
+                recordAtAnchor(state, wordLength + 1, placed);
+            }
+        }
+        else
+        {
+            extendToAnchor(state, child, next, wordLength + 1, placed);
+        }
+
+        state->totalTiles--;
+        state->rackCounts[i]++;
+        state->rackMask |= 1u << i;
+    }
+}
+
+/*---------- FUNCTION: recordAtAnchor -----------------------------------
+/   Function Description:
+/     Records an UP or LEFT word built by extendToAnchor. The tiles were laid
+/     from the first square towards the anchor, so they are reversed into
+/     search order first.
+/   Caller Input:
+/     - SearchState *state: The current search state.
+/     - int wordLength: Length of the word.
+/     - PartialScore score: Score of the whole word.
+/   Caller Output:
+/     - void: No return value.
+/   Assumptions, Limitations, Known Bugs:
+/     - N/A
+/---------------------------------------------------------*/
+static void recordAtAnchor(SearchState *state, int wordLength, PartialScore score)
+{
+    char tiles[BOARD_SIZE + 1];
+
+    for (int i = 0; i < state->totalTiles; i++)
+    {
+        tiles[i] = state->tiles[state->totalTiles - i - 1];
+    }
+    recordMove(state, state->start, state->word, wordLength, tiles, finishScore(score, state->totalTiles));
+}
+
+/*---------- FUNCTION: extendGaddagBackward -----------------------------------
+/   Function Description:
+/     Walks the reversed prefix of a word through the GADDAG, starting on the
+/     anchor and moving UP or LEFT away from it. Wherever the prefix can end,
+/     the separator is crossed and extendGaddagForward continues with the
+/     suffix DOWN or RIGHT of the anchor.
+/   Caller Input:
+/     - SearchState *state: The current search state.
+/     - uint32_t node: GADDAG node for the letters walked so far.
+/     - int square: Plane index of the square to fill next.
+/     - int wordLength: Number of letters walked so far (0 on the anchor).
+/     - PartialScore score: Score of the letters walked so far.
+/   Caller Output:
+/     - void: No return value.
+/   Assumptions, Limitations, Known Bugs:
+/     - No tile is laid on an empty anchor before this one. The word is then
+/       found from its first anchor only, so each move is found once.
+/     - The border letter has no GADDAG edge, so the walk needs no bounds check.
+/---------------------------------------------------------*/
+static void extendGaddagBackward(SearchState *state, uint32_t node, int square, int wordLength, PartialScore score)
+{
+    const Gaddag *gaddag = state->gaddag;
+    char boardLetter = state->letters[square];
+
+    // The prefix may end before an empty square or the border
+    if (wordLength > 0 && endsWord(state, square))
+    {
+        uint32_t separator = gaddagChild(gaddag, node, GADDAG_SEPARATOR);
+        if (separator != GADDAG_NONE)
+        {
+            state->start = square - state->step;
+            state->prefixLength = wordLength;
+            extendGaddagForward(state, separator, state->anchor - state->step, wordLength, score);
+        }
+    }
+
+    if (boardLetter != ' ')
+    {
+        uint32_t child = gaddagChild(gaddag, node, boardLetter);
+        if (child != GADDAG_NONE)
+        {
+            state->word[wordLength] = boardLetter;
+            extendGaddagBackward(state, child, square + state->step, wordLength + 1, scoreLetter(state, score, square, boardLetter, false));
+        }
+        return;
+    }
+
+    int major = square / PADDED_SIZE - 1;
+    int minor = square % PADDED_SIZE - 1;
+    if (square != state->anchor && (state->openAnchorLines[major] >> minor & 1))
+    {
+        return; // The search of that anchor finds the word
+    }
+
+    uint32_t allowed = state->crossCheck[square];
+    for (uint32_t child = gaddag->nodes[node].firstChild; child != GADDAG_NONE; child = gaddag->nodes[child].nextSibling)
+    {
+        char letter = gaddag->nodes[child].letter;
+        if (letter == GADDAG_SEPARATOR || state->rackCounts[letter - 'A'] == 0 || !(allowed & (1u << (letter - 'A'))))
+        {
+            continue;
+        }
+
+        state->rackCounts[letter - 'A']--;
+        state->word[wordLength] = letter;
+        state->tiles[state->totalTiles++] = letter;
+
+        extendGaddagBackward(state, child, square + state->step, wordLength + 1, scoreLetter(state, score, square, letter, true));
+
+        state->totalTiles--;
+        state->rackCounts[letter - 'A']++;
+    }
+}
+
+/*---------- FUNCTION: extendGaddagForward -----------------------------------
+/   Function Description:
+/     Walks the suffix of a word through the GADDAG after the separator,
+/     moving DOWN or RIGHT from the square after the anchor exactly like
+/     the Trie. The word is recorded wherever it can end.
+/   Caller Input:
+/     - SearchState *state: The current search state.
+/     - uint32_t node: GADDAG node for the letters walked so far.
+/     - int square: Plane index of the square to fill next.
+/     - int wordLength: Number of letters walked so far, the prefix included.
+/     - PartialScore score: Score of the letters walked so far.
+/   Caller Output:
+/     - void: No return value.
+/   Assumptions, Limitations, Known Bugs:
+/     - The border letter has no GADDAG edge, so the walk needs no bounds check.
+/---------------------------------------------------------*/
+static void extendGaddagForward(SearchState *state, uint32_t node, int square, int wordLength, PartialScore score)
+{
+    const Gaddag *gaddag = state->gaddag;
+    char boardLetter = state->letters[square];
+
+    if (gaddag->nodes[node].isWord && endsWord(state, square))
+    {
+        recordGaddagMove(state, wordLength, score);
+    }
+
+    if (boardLetter != ' ')
+    {
+        uint32_t child = gaddagChild(gaddag, node, boardLetter);
+        if (child != GADDAG_NONE)
+        {
+            state->word[wordLength] = boardLetter;
+            extendGaddagForward(state, child, square - state->step, wordLength + 1, scoreLetter(state, score, square, boardLetter, false));
+        }
+        return;
+    }
+
+    uint32_t allowed = state->crossCheck[square];
+    for (uint32_t child = gaddag->nodes[node].firstChild; child != GADDAG_NONE; child = gaddag->nodes[child].nextSibling)
+    {
+        char letter = gaddag->nodes[child].letter;
+        if (letter == GADDAG_SEPARATOR || state->rackCounts[letter - 'A'] == 0 || !(allowed & (1u << (letter - 'A'))))
+        {
+            continue;
+        }
+
+        state->rackCounts[letter - 'A']--;
+        state->word[wordLength] = letter;
+        state->tiles[state->totalTiles++] = letter;
+
+        extendGaddagForward(state, child, square - state->step, wordLength + 1, scoreLetter(state, score, square, letter, true));
+
+        state->totalTiles--;
+        state->rackCounts[letter - 'A']++;
+    }
+}
+
+/*---------- FUNCTION: recordGaddagMove -----------------------------------
+/   Function Description:
+/     Records a word built by the GADDAG walks. The prefix was walked from
+/     the anchor outwards, so it is reversed into reading order in front of
+/     the suffix.
+/   Caller Input:
+/     - SearchState *state: The current search state.
+/     - int wordLength: Length of the word.
+/     - PartialScore score: Score of the whole word.
+/   Caller Output:
+/     - void: No return value.
+/   Assumptions, Limitations, Known Bugs:
+/     - N/A
+/---------------------------------------------------------*/
+static void recordGaddagMove(SearchState *state, int wordLength, PartialScore score)
+{
+    char word[BOARD_SIZE + 1];
+    int prefixLength = state->prefixLength;
+
+    for (int i = 0; i < prefixLength; i++)
+    {
+        word[i] = state->word[prefixLength - i - 1];
+    }
+    memcpy(word + prefixLength, state->word + prefixLength, wordLength - prefixLength);
+    recordMove(state, state->start, word, wordLength, state->tiles, finishScore(score, state->totalTiles));
+}
+
+/*---------- FUNCTION: searchesDirection -----------------------------------
+/   Function Description:
+/     Checks if anchors are searched in a direction. A forward dictionary
+/     searches all four; the GADDAG search of UP or LEFT covers both sides
+/     of the anchor, so DOWN and RIGHT are skipped.
+/   Caller Input:
+/     - const SearchState *state: Search state with dictionary or gaddag set.
+/     - int direction: Search direction (UP, DOWN, LEFT, RIGHT).
+/   Caller Output:
+/     - bool: True if the direction is searched.
+/   Assumptions, Limitations, Known Bugs:
+/     - N/A
+/---------------------------------------------------------*/
+static bool searchesDirection(const SearchState *state, int direction)
+{
+    return state->gaddag == NULL || direction == UP || direction == LEFT;
+}
+
+/*---------- FUNCTION: searchAnchor -----------------------------------
+/   Function Description:
+/     Finds every move that starts at the anchor square of the search state
+/     and grows in its direction. With the GADDAG, finds every move along
+/     the line of the direction that covers the anchor instead.
+/   Caller Input:
+/     - SearchState *state: Search state with the anchor and direction set.
+/   Caller Output:
+/     - void: No return value.
+/   Assumptions, Limitations, Known Bugs:
+/     - Without the GADDAG the square behind the anchor must be empty, as
+/       in dfs, so words through the anchor are missed.
+/---------------------------------------------------------*/
+static void searchAnchor(SearchState *state)
+{
+    int direction = state->direction;
+    char behind = state->letters[state->anchor - state->step];
+    PartialScore score = {0, 1, 0};
+
+    if (state->gaddag != NULL)
+    {
+        extendGaddagBackward(state, 0, state->anchor, 0, score);
+        return;
+    }
+
+    if (behind != ' ' && behind != BORDER_LETTER)
+    {
+        return;
+    }
+
+    if (direction == DOWN || direction == RIGHT)
+    {
+        extendForward(state, dictionaryRoot(state->dictionary), state->anchor, 0, score);
+        return;
+    }
+
+    // Try every empty square the word could start on, nearest first
+    int rackSize = state->rackSize;
+    int emptySquares = 0;
+    for (int square = state->anchor; state->letters[square] != BORDER_LETTER; square += state->step)
+    {
+        if (state->letters[square] == ' ')
+        {
+            emptySquares++;
+            if (emptySquares > rackSize)
+            {
+                break;
+            }
+            if (!endsWord(state, square + state->step))
+            {
+                continue; // The tile beyond would be part of the word
+            }
+            state->start = square;
+            extendToAnchor(state, dictionaryRoot(state->dictionary), square, 0, score);
+        }
+    }
+}
+
+/*---------- FUNCTION: setAnchor -----------------------------------
+/   Function Description:
+/     Points the search state at an anchor square and search direction.
+/   Caller Input:
+/     - SearchState *state: Search state whose board is packed.
+/     - int row: Row of the anchor.
+/     - int col: Column of the anchor.
+/     - int direction: Search direction (UP, DOWN, LEFT, RIGHT).
+/   Caller Output:
+/     - void: No return value.
+/   Assumptions, Limitations, Known Bugs:
+/     - N/A
+/---------------------------------------------------------*/
+static void setAnchor(SearchState *state, int row, int col, int direction)
+{
+    const PackedBoard *packed = &state->packed;
+    int plane = PACKED_PLANE(direction);
+
+    state->anchorRow = row;
+    state->anchorCol = col;
+    state->direction = direction;
+    state->letters = packed->letter[plane];
+    state->crossCheck = packed->crossCheck[plane];
+    state->crossScore = packed->crossScore[plane];
+    state->letterMultiplier = packed->letterMultiplier[plane];
+    state->wordMultiplier = packed->wordMultiplier[plane];
+    state->step = PACKED_STEP(direction);
+    state->openAnchorLines = plane == 1 ? state->openAnchors.rows : state->openAnchors.columns;
+    state->anchor = plane == 1 ? (row + 1) * PADDED_SIZE + col + 1 : (col + 1) * PADDED_SIZE + row + 1;
+}
+
+/*---------- FUNCTION: sideScoreBounds -----------------------------------
+/   Function Description:
+/     Sums up the squares on one side of a word for the score bounds: the
+/     board letters on their squares, the empty squares by letter
+/     multiplier, the word multipliers and the best perpendicular word every
+/     empty square could form with the highest rack value.
+/   Caller Input:
+/     - const SearchState *state: Search state with the anchor and direction set.
+/     - int square: Plane index of the first square of the side.
+/     - int step: Index step away from the anchor.
+/     - SideBound sides[]: Array of BOARD_SIZE + 1 entries to fill.
+/   Caller Output:
+/     - int: Number of entries. sides[i] covers the first i squares, so
+/       sides[0] covers none.
+/   Assumptions, Limitations, Known Bugs:
+/     - Stops at the border or before the side needs more empty squares than
+/       the rack has tiles.
+/---------------------------------------------------------*/
+static int sideScoreBounds(const SearchState *state, int square, int step, SideBound sides[])
+{
+    SideBound side = {0, {0, 0, 0, 0}, 0, 1, 0};
+    int totalSides = 0;
+
+    sides[totalSides++] = side;
+    for (; state->letters[square] != BORDER_LETTER; square += step)
+    {
+        char letter = state->letters[square];
+
+        if (letter == ' ')
+        {
+            side.emptySquares++;
+            if (side.emptySquares > state->rackSize)
+            {
+                break;
+            }
+            side.emptyMultipliers[state->letterMultiplier[square]]++;
+            if (state->crossScore[square] != 0)
+            {
+                side.crossWords += (state->crossScore[square] + state->rackValues[0] * state->letterMultiplier[square]) * state->wordMultiplier[square];
+            }
+        }
+        else
+        {
+            side.boardLetters += letterScores[letter - 'A'] * state->letterMultiplier[square];
+        }
+        side.wordProduct *= state->wordMultiplier[square];
+        sides[totalSides++] = side;
+    }
+    return totalSides;
+}
+
+/*---------- FUNCTION: runScoreBound -----------------------------------
+/   Function Description:
+/     Bounds the score of a word covering two sides of squares: it scores
+/     the board letters, puts the highest rack values on the highest letter
+/     multipliers of the empty squares, applies every word multiplier and
+/     the bingo bonus, and adds the perpendicular words.
+/   Caller Input:
+/     - const SearchState *state: The current search state.
+/     - const SideBound *before: Squares on one side (see sideScoreBounds).
+/     - const SideBound *after: Squares on the other side.
+/   Caller Output:
+/     - int: No word on those squares scores more than this, 0 if the rack
+/       cannot fill them.
+/   Assumptions, Limitations, Known Bugs:
+/     - N/A
+/---------------------------------------------------------*/
+static int runScoreBound(const SearchState *state, const SideBound *before, const SideBound *after)
+{
+    int emptySquares = before->emptySquares + after->emptySquares;
+    int letterSum = before->boardLetters + after->boardLetters;
+    int tile = 0;
+
+    if (emptySquares > state->rackSize)
+    {
+        return 0;
+    }
+    for (int multiplier = 3; multiplier >= 1; multiplier--)
+    {
+        for (int i = 0; i < before->emptyMultipliers[multiplier] + after->emptyMultipliers[multiplier]; i++)
+        {
+            letterSum += state->rackValues[tile++] * multiplier;
+        }
+    }
+
+    int bingo = emptySquares == BINGO_TILES ? BINGO_BONUS : 0;
+    return (letterSum + bingo) * before->wordProduct * after->wordProduct + before->crossWords + after->crossWords;
+}
+
+/*---------- FUNCTION: anchorScoreBound -----------------------------------
+/   Function Description:
+/     Computes an upper bound on the score of every move searchAnchor can
+/     find from the current anchor and direction. Each word it can form
+/     covers the squares from the anchor to some square in the search
+/     direction; a GADDAG word may also cover squares on the other side of
+/     the anchor, so every pair of the two sides is bounded (runScoreBound).
+/   Caller Input:
+/     - const SearchState *state: Search state with the anchor and direction set.
+/   Caller Output:
+/     - int: No move from the anchor scores more than this.
+/   Assumptions, Limitations, Known Bugs:
+/     - Ignores the dictionary and the cross-check masks, so the bound is
+/       admissible but not tight.
+/---------------------------------------------------------*/
+static int anchorScoreBound(const SearchState *state)
+{
+    SideBound sides[BOARD_SIZE + 1];
+    SideBound after[BOARD_SIZE + 1];
+    char behind = state->letters[state->anchor - state->step];
+    int totalAfter = 1;
+    int best = 0;
+
+    after[0] = (SideBound){0, {0, 0, 0, 0}, 0, 1, 0};
+    if (state->rackSize == 0 || (state->gaddag == NULL && behind != ' ' && behind != BORDER_LETTER))
+    {
+        return 0; // searchAnchor finds nothing here
+    }
+    if (state->gaddag != NULL)
+    {
+        totalAfter = sideScoreBounds(state, state->anchor - state->step, -state->step, after);
+    }
+
+    // sides[0] covers no square, and every word covers the anchor
+    int totalSides = sideScoreBounds(state, state->anchor, state->step, sides);
+    for (int i = 1; i < totalSides; i++)
+    {
+        for (int j = 0; j < totalAfter; j++)
+        {
+            int bound = runScoreBound(state, &sides[i], &after[j]);
+            if (bound > best)
+            {
+                best = bound;
+            }
+        }
+    }
+    return best;
+}
+
+/*---------- FUNCTION: siftAnchorBound -----------------------------------
+/   Function Description:
+/     Restores the order of a min-heap of anchor searches below an entry,
+/     moving it down past every child with a lower bound.
+/   Caller Input:
+/     - AnchorBound tasks[]: The heap.
+/     - int index: Index of the entry.
+/     - int totalTasks: Number of entries in the heap.
+/   Caller Output:
+/     - void: No return value.
+/   Assumptions, Limitations, Known Bugs:
+/     - Both subtrees of the entry must already be heaps.
+/---------------------------------------------------------*/
+static void siftAnchorBound(AnchorBound tasks[], int index, int totalTasks)
+{
+    while (true)
+    {
+        int lowest = index;
+        int left = 2 * index + 1;
+        int right = left + 1;
+        if (left < totalTasks && tasks[left].bound < tasks[lowest].bound)
+        {
+            lowest = left;
+        }
+        if (right < totalTasks && tasks[right].bound < tasks[lowest].bound)
+        {
+            lowest = right;
+        }
+        if (lowest == index)
+        {
+            break;
+        }
+        AnchorBound temp = tasks[index];
+        tasks[index] = tasks[lowest];
+        tasks[lowest] = temp;
+        index = lowest;
+    }
+}
+
+/*---------- FUNCTION: sortAnchorBounds -----------------------------------
+/   Function Description:
+/     Sorts anchor searches by descending score bound with an in-place heap
+/     sort: a min-heap on the bound is built, then its root, the lowest
+/     bound left, is moved behind the heap until the heap is empty.
+/   Caller Input:
+/     - AnchorBound tasks[]: The searches.
+/     - int totalTasks: Number of searches.
+/   Caller Output:
+/     - void: No return value. tasks is sorted highest bound first.
+/   Assumptions, Limitations, Known Bugs:
+/     - Not stable. Unlike qsort it never allocates.
+/---------------------------------------------------------*/
+static void sortAnchorBounds(AnchorBound tasks[], int totalTasks)
+{
+    for (int index = totalTasks / 2 - 1; index >= 0; index--)
+    {
+        siftAnchorBound(tasks, index, totalTasks);
+    }
+    for (int heapSize = totalTasks - 1; heapSize > 0; heapSize--)
+    {
+        AnchorBound lowest = tasks[0];
+        tasks[0] = tasks[heapSize];
+        tasks[heapSize] = lowest;
+        siftAnchorBound(tasks, 0, heapSize);
+    }
+}
+
+/*---------- FUNCTION: collectAnchorTasks -----------------------------------
+/   Function Description:
+/     Lists the anchor searches of a board: every anchor square, column by
+/     column, in every direction it is searched in (see searchesDirection).
+/   Caller Input:
+/     - SearchState *state: Search state with the rack and packed board set.
+/     - const BoardBits *anchors: The anchor squares.
+/     - AnchorBound tasks[]: Array of BOARD_SQUARES * 4 entries to fill.
+/     - bool bounded: Compute the score bound of every search and order the
+/       list by it, highest first.
+/   Caller Output:
+/     - int: Number of searches listed.
+/   Assumptions, Limitations, Known Bugs:
+/     - Without bounds every bound is 0 and the list keeps anchor order.
+/---------------------------------------------------------*/
+static int collectAnchorTasks(SearchState *state, const BoardBits *anchors, AnchorBound tasks[], bool bounded)
+{
+    int totalTasks = 0;
+
+    for (int col = 0; col < BOARD_SIZE; col++)
+    {
+        for (uint32_t rows = anchors->columns[col]; rows != 0; rows &= rows - 1)
+        {
+            int row = __builtin_ctz(rows);
+            for (int direction = UP; direction <= RIGHT; direction++)
+            {
+                if (!searchesDirection(state, direction))
+                {
+                    continue;
+                }
+                AnchorBound *task = &tasks[totalTasks++];
+                task->bound = 0;
+                if (bounded)
+                {
+                    setAnchor(state, row, col, direction);
+                    task->bound = anchorScoreBound(state);
+                }
+                task->row = row;
+                task->col = col;
+                task->direction = direction;
+            }
+        }
+    }
+
+    if (bounded)
+    {
+        sortAnchorBounds(tasks, totalTasks);
+    }
+    return totalTasks;
+}
+
+/*---------- FUNCTION: searchByBound -----------------------------------
+/   Function Description:
+/     Branch and bound over the anchor searches: bounds every anchor and
+/     direction (anchorScoreBound), searches them highest bound first and
+/     stops once no remaining bound can beat the worst move the sink keeps.
+/   Caller Input:
+/     - SearchState *state: Search state with the rack and packed board set.
+/     - const BoardBits *anchors: The anchor squares.
+/   Caller Output:
+/     - void: No return value.
+/   Assumptions, Limitations, Known Bugs:
+/     - The sink must be limited. A search is skipped only if its bound is
+/       below the worst kept score, since an equal score may still rank
+/       before it, so the sink ends with the same moves as a full search.
+/     - A sink with a deadline or move budget stops the searches when it
+/       runs out; the most promising anchors have been searched by then.
+/---------------------------------------------------------*/
+static void searchByBound(SearchState *state, const BoardBits *anchors)
+{
+    AnchorBound bounds[BOARD_SQUARES * 4];
+    int totalBounds = collectAnchorTasks(state, anchors, bounds, true);
+
+    for (int i = 0; i < totalBounds; i++)
+    {
+        if (moveSinkRejects(state->sink, bounds[i].bound))
+        {
+            break; // Bounds only fall from here
+        }
+        if (moveSinkOutOfBudget(state->sink, state->sink->movesSeen))
+        {
+            state->sink->stoppedEarly = true;
+            break;
+        }
+        setAnchor(state, bounds[i].row, bounds[i].col, bounds[i].direction);
+        searchAnchor(state);
+    }
+}
+
+/*---------- FUNCTION: takeTask -----------------------------------
+/   Function Description:
+/     Takes one anchor search from a worker's queue: the owner takes from
+/     the head, a thief from the tail.
+/   Caller Input:
+/     - TaskQueue *queue: The queue.
+/     - bool fromHead: True for the owner of the queue.
+/     - AnchorBound *task: Receives the task.
+/   Caller Output:
+/     - bool: False if the queue was empty.
+/   Assumptions, Limitations, Known Bugs:
+/     - N/A
+/---------------------------------------------------------*/
+static bool takeTask(TaskQueue *queue, bool fromHead, AnchorBound *task)
+{
+    bool taken = false;
+
+    pthread_mutex_lock(&queue->lock);
+    if (queue->head < queue->tail)
+    {
+        *task = fromHead ? queue->tasks[queue->head++] : queue->tasks[--queue->tail];
+        taken = true;
+    }
+    pthread_mutex_unlock(&queue->lock);
+    return taken;
+}
+
+/*---------- FUNCTION: runGeneratorWorker -----------------------------------
+/   Function Description:
+/     Runs the anchor searches of a worker's own queue, then steals from the
+/     other workers until every queue is empty. Moves go to the worker's own
+/     sink. When pruning, a worker whose sink is full publishes its worst
+/     kept score: no move below it can be among the best overall.
+/   Caller Input:
+/     - void *argument: The GeneratorWorker.
+/   Caller Output:
+/     - void *: Always NULL.
+/   Assumptions, Limitations, Known Bugs:
+/     - Queues only shrink once the workers run, so a worker stops after
+/       finding every queue empty once.
+/     - With a deadline or move budget the workers add up the moves they
+/       have seen and stop taking searches once the budget is spent.
+/---------------------------------------------------------*/
+static void *runGeneratorWorker(void *argument)
+{
+    GeneratorWorker *worker = (GeneratorWorker *)argument;
+    GeneratorPool *pool = worker->pool;
+    AnchorBound task;
+    bool budgeted = worker->sink.deadline > 0 || worker->sink.moveBudget > 0;
+
+    for (;;)
+    {
+        bool taken = takeTask(&worker->queue, true, &task);
+        for (int i = 1; !taken && i < pool->totalWorkers; i++)
+        {
+            taken = takeTask(&pool->workers[(worker->index + i) % pool->totalWorkers].queue, false, &task);
+        }
+        if (!taken)
+        {
+            break;
+        }
+
+        if (pool->prune && task.bound < __atomic_load_n(&pool->threshold, __ATOMIC_RELAXED))
+        {
+            continue;
+        }
+        if (budgeted && moveSinkOutOfBudget(&worker->sink, __atomic_load_n(&pool->movesSeen, __ATOMIC_RELAXED)))
+        {
+            __atomic_store_n(&pool->stoppedEarly, true, __ATOMIC_RELAXED);
+            break;
+        }
+        long movesBefore = worker->sink.movesSeen;
+        setAnchor(&worker->state, task.row, task.col, task.direction);
+        searchAnchor(&worker->state);
+        if (budgeted)
+        {
+            __atomic_fetch_add(&pool->movesSeen, worker->sink.movesSeen - movesBefore, __ATOMIC_RELAXED);
+        }
+
+        if (pool->prune && worker->sink.totalMoves == worker->sink.limit)
+        {
+            int worstKept = worker->sink.moves[0].move.score;
+            int threshold = __atomic_load_n(&pool->threshold, __ATOMIC_RELAXED);
+            while (worstKept > threshold &&
+                   !__atomic_compare_exchange_n(&pool->threshold, &threshold, worstKept, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            {
+            }
+        }
+    }
+    return NULL;
+}
+
+/*---------- FUNCTION: runPoolThread -----------------------------------
+/   Function Description:
+/     Body of a pool thread: waits for a run to start, runs its worker's
+/     share of it (runGeneratorWorker) and reports back, until the pool
+/     stops.
+/   Caller Input:
+/     - void *argument: The GeneratorWorker of the thread.
+/   Caller Output:
+/     - void *: Always NULL.
+/   Assumptions, Limitations, Known Bugs:
+/     - N/A
+/---------------------------------------------------------*/
+static void *runPoolThread(void *argument)
+{
+    GeneratorWorker *worker = (GeneratorWorker *)argument;
+    GeneratorPool *pool = worker->pool;
+    long runsSeen = 0;
+
+    pthread_mutex_lock(&pool->lock);
+    while (true)
+    {
+        while (!pool->stopping && pool->runNumber == runsSeen)
+        {
+            pthread_cond_wait(&pool->wake, &pool->lock);
+        }
+        if (pool->stopping)
+        {
+            break;
+        }
+        runsSeen = pool->runNumber;
+        pthread_mutex_unlock(&pool->lock);
+
+        runGeneratorWorker(worker);
+
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->busyThreads == 0)
+        {
+            pthread_cond_signal(&pool->done);
+        }
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+/*---------- FUNCTION: searchInPool -----------------------------------
+/   Function Description:
+/     Splits the anchor searches of a board between the workers of a pool.
+/     The searches are dealt round-robin (highest bound first when pruning)
+/     into one queue per worker and idle workers steal from the others, so a
+/     few heavy anchors near open premium squares do not hold up the run.
+/     Each worker keeps its own search state and sink; their moves are
+/     merged into the caller's sink afterwards.
+/   Caller Input:
+/     - SearchState *state: Search state with the rack and packed board set.
+/     - const BoardBits *anchors: The anchor squares.
+/     - MoveSink *sink: The caller's sink.
+/     - GeneratorPool *pool: The pool; the calling thread is its worker 0.
+/   Caller Output:
+/     - void: No return value. The sink is not finished.
+/   Assumptions, Limitations, Known Bugs:
+/     - Exits the program on allocation failure.
+/     - Worker sinks keep their storage between runs, so once it has grown
+/       to fit a run, a run of the same size allocates nothing.
+/     - Moves are ordered by a key unique to each move (see finishMoveSink),
+/       so the result does not depend on the thread count or timing.
+/     - Only one run at a time may use a pool.
+/---------------------------------------------------------*/
+static void searchInPool(SearchState *state, const BoardBits *anchors, MoveSink *sink, GeneratorPool *pool)
+{
+    AnchorBound tasks[BOARD_SQUARES * 4];
+    bool prune = sink->limit != MOVE_SINK_ALL && sink->allowPruning;
+    int totalTasks = collectAnchorTasks(state, anchors, tasks, prune);
+    int threads = pool->totalWorkers;
+
+    pool->prune = prune;
+    pool->threshold = INT_MIN;
+    pool->movesSeen = sink->movesSeen;
+    pool->stoppedEarly = false;
+
+    // Worker i owns tasks i, i + threads, ... stored contiguously
+    int filled = 0;
+    for (int i = 0; i < threads; i++)
+    {
+        GeneratorWorker *worker = &pool->workers[i];
+        if (sink->limit > worker->capacity)
+        {
+            GeneratedMove *moves = (GeneratedMove *)realloc(worker->moves, sink->limit * sizeof(GeneratedMove));
+            if (moves == NULL)
+            {
+                perror("Failed to allocate memory");
+                exit(1);
+            }
+            worker->moves = moves;
+            worker->capacity = sink->limit;
+        }
+        worker->state = *state;
+        initMoveSinkInBuffer(&worker->sink, sink->limit, worker->moves, worker->capacity);
+        worker->sink.deadline = sink->deadline;
+        worker->sink.moveBudget = sink->moveBudget;
+        worker->state.sink = &worker->sink;
+        worker->queue.tasks = pool->queued + filled;
+        worker->queue.head = 0;
+        for (int task = i; task < totalTasks; task += threads)
+        {
+            pool->queued[filled++] = tasks[task];
+        }
+        worker->queue.tail = (int)(pool->queued + filled - worker->queue.tasks);
+    }
+
+    // The calling thread is worker 0; the pool threads run alongside it
+    pthread_mutex_lock(&pool->lock);
+    pool->busyThreads = pool->startedThreads;
+    pool->runNumber++;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+
+    runGeneratorWorker(&pool->workers[0]);
+
+    pthread_mutex_lock(&pool->lock);
+    while (pool->busyThreads > 0)
+    {
+        pthread_cond_wait(&pool->done, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+
+    long movesSeen = sink->movesSeen;
+    for (int i = 0; i < threads; i++)
+    {
+        GeneratorWorker *worker = &pool->workers[i];
+        for (int move = 0; move < worker->sink.totalMoves; move++)
+        {
+            addToMoveSink(sink, &worker->sink.moves[move]);
+        }
+        movesSeen += worker->sink.movesSeen;
+
+        // A sink that outgrew the worker's storage moved to storage of its own; keep that
+        if (worker->sink.ownsMoves)
+        {
+            free(worker->moves);
+            worker->moves = worker->sink.moves;
+            worker->capacity = worker->sink.capacity;
+        }
+    }
+    sink->movesSeen = movesSeen;
+    sink->stoppedEarly |= pool->stoppedEarly;
+}
+
+/*---------- FUNCTION: runGenerator -----------------------------------
+/   Function Description:
+/     Searches every valid placement square in all four directions with the
+/     dictionary set in the search state, or every empty one along its row
+/     and column with the GADDAG, and offers every move to a sink.
+/     The squares are found from the occupancy the board keeps (findAnchors),
+/     column by column, and the walks run on a packed copy of the board
+/     (packBoard).
+/     A limited sink that allows pruning is filled by searchByBound instead,
+/     and with a pool the searches are shared out by searchInPool. Every
+/     path stops between anchor searches once the sink's deadline or move
+/     budget runs out (see moveSinkOutOfBudget).
+/   Caller Input:
+/     - SearchState *state: Search state with dictionary or gaddag set.
+/     - Board *board: The game board.
+/     - const char *rack: The letters the player has (any case).
+/     - MoveSink *sink: The sink to offer the moves to.
+/     - GeneratorPool *pool: Pool to search with, NULL to search on the calling thread.
+/   Caller Output:
+/     - void: No return value. The sink is not finished.
+/   Assumptions, Limitations, Known Bugs:
+/     - Non-letter rack characters can never be placed and are ignored.
+/---------------------------------------------------------*/
+static void runGenerator(SearchState *state, Board *board, const char *rack, MoveSink *sink, GeneratorPool *pool)
+{
+    state->board = board->squares;
+    state->sink = sink;
+    state->totalTiles = 0;
+    memset(state->rackCounts, 0, sizeof(state->rackCounts));
+    state->rackMask = 0;
+    for (int i = 0; rack[i] != '\0'; i++)
+    {
+        int index = toupper((unsigned char)rack[i]) - 'A';
+        if (index >= 0 && index < MAX_CHARACTERS)
+        {
+            state->rackCounts[index]++;
+            state->rackMask |= 1u << index;
+        }
+    }
+
+    // Rack letter values, highest first, for the anchor score bounds
+    state->rackSize = 0;
+    for (int i = 0; i < MAX_CHARACTERS; i++)
+    {
+        for (int count = 0; count < state->rackCounts[i] && state->rackSize < BOARD_SIZE; count++)
+        {
+            int position = state->rackSize++;
+            while (position > 0 && state->rackValues[position - 1] < letterScores[i])
+            {
+                state->rackValues[position] = state->rackValues[position - 1];
+                position--;
+            }
+            state->rackValues[position] = letterScores[i];
+        }
+    }
+
+    const BoardBits *occupied = &board->occupied;
+    BoardBits anchors;
+    findAnchors(occupied, &anchors);
+
+    // Every move lays a tile on an empty anchor, so the GADDAG searches start there only
+    for (int line = 0; line < BOARD_SIZE; line++)
+    {
+        state->openAnchors.rows[line] = anchors.rows[line] & ~occupied->rows[line];
+        state->openAnchors.columns[line] = anchors.columns[line] & ~occupied->columns[line];
+    }
+    if (state->gaddag != NULL)
+    {
+        anchors = state->openAnchors;
+    }
+
+    packBoard(board->squares, &state->packed);
+
+    if (pool != NULL && pool->totalWorkers > 1)
+    {
+        searchInPool(state, &anchors, sink, pool);
+        return;
+    }
+    if (sink->limit != MOVE_SINK_ALL && sink->allowPruning)
+    {
+        searchByBound(state, &anchors);
+        return;
+    }
+
+    for (int col = 0; col < BOARD_SIZE; col++)
+    {
+        for (uint32_t rows = anchors.columns[col]; rows != 0; rows &= rows - 1)
+        {
+            int row = __builtin_ctz(rows);
+            for (int direction = UP; direction <= RIGHT; direction++)
+            {
+                if (!searchesDirection(state, direction))
+                {
+                    continue;
+                }
+                if (moveSinkOutOfBudget(sink, sink->movesSeen))
+                {
+                    sink->stoppedEarly = true;
+                    return;
+                }
+                setAnchor(state, row, col, direction);
+                searchAnchor(state);
+            }
+        }
+    }
+}
+
+/*---------- FUNCTION: generateIntoArray -----------------------------------
+/   Function Description:
+/     Runs the generator into a sink that keeps every move and appends them,
+/     in order, to a Move array.
+/   Caller Input:
+/     - SearchState *state: Search state with dictionary or gaddag set.
+/     - Board *board: The game board.
+/     - const char *rack: The letters the player has (any case).
+/     - Move foundMoves[]: Array to append found moves to.
+/     - int *totalMovesFound: Pointer to the number of moves already in foundMoves.
+/     - int maxMoves: Capacity of foundMoves.
+/   Caller Output:
+/     - void: Appends moves to foundMoves and updates totalMovesFound.
+/   Assumptions, Limitations, Known Bugs:
+/     - Moves past maxMoves are dropped with a warning.
+/---------------------------------------------------------*/
+static void generateIntoArray(SearchState *state, Board *board, const char *rack, Move foundMoves[], int *totalMovesFound, int maxMoves)
+{
+    MoveSink sink;
+
+    initMoveSink(&sink, MOVE_SINK_ALL);
+    runGenerator(state, board, rack, &sink, NULL);
+    finishMoveSink(&sink);
+    *totalMovesFound += copyMoveSink(&sink, foundMoves + *totalMovesFound, maxMoves - *totalMovesFound);
+    freeMoveSink(&sink);
+}
+
+/*---------- FUNCTION: generateMoves -----------------------------------
+/   Function Description:
+/     Finds every valid move for the given rack by walking the Trie from each
+/     valid placement square in all four directions.
+/   Caller Input:
+/     - TrieNode *root: Pointer to the root of the Trie.
+/     - Board *board: The game board.
+/     - const char *rack: The letters the player has (any case).
+/     - Move foundMoves[]: Array to append found moves to.
+/     - int *totalMovesFound: Pointer to the number of moves already in foundMoves.
+/     - int maxMoves: Capacity of foundMoves.
+/   Caller Output:
+/     - void: Appends moves to foundMoves and updates totalMovesFound.
+/   Assumptions, Limitations, Known Bugs:
+/     - Non-letter rack characters can never be placed and are ignored.
+/     - Moves past maxMoves are dropped with a warning.
+/---------------------------------------------------------*/
+void generateMoves(TrieNode *root, Board *board, const char *rack, Move foundMoves[], int *totalMovesFound, int maxMoves)
+{
+    Dictionary dictionary = {root, NULL, NULL, NULL};
+    SearchState state;
+
+    state.dictionary = &dictionary;
+    state.gaddag = NULL;
+    generateIntoArray(&state, board, rack, foundMoves, totalMovesFound, maxMoves);
+}
+
+/*---------- FUNCTION: generateMovesWithGaddag -----------------------------------
+/   Function Description:
+/     Finds every valid move for the given rack by walking the GADDAG both
+/     ways from each empty anchor, along its row and its column.
+/   Caller Input:
+/     - const Gaddag *gaddag: The GADDAG built from the dictionary.
+/     - Board *board: The game board.
+/     - const char *rack: The letters the player has (any case).
+/     - Move foundMoves[]: Array to append found moves to.
+/     - int *totalMovesFound: Pointer to the number of moves already in foundMoves.
+/     - int maxMoves: Capacity of foundMoves.
+/   Caller Output:
+/     - void: Appends moves to foundMoves and updates totalMovesFound.
+/   Assumptions, Limitations, Known Bugs:
+/     - Finds every move of generateMoves, each one once, plus the words
+/       through an anchor.
+/---------------------------------------------------------*/
+void generateMovesWithGaddag(const Gaddag *gaddag, Board *board, const char *rack, Move foundMoves[], int *totalMovesFound, int maxMoves)
+{
+    SearchState state;
+
+    state.dictionary = NULL;
+    state.gaddag = gaddag;
+    generateIntoArray(&state, board, rack, foundMoves, totalMovesFound, maxMoves);
+}
+
+/*---------- FUNCTION: generateMovesInDictionary -----------------------------------
+/   Function Description:
+/     Finds every valid move for the given rack with the fastest structure the
+/     dictionary holds: the GADDAG if it was built, otherwise the forward
+/     structure chosen by dictionaryRoot (DAWG, compact Trie, then Trie).
+/   Caller Input:
+/     - const Dictionary *dictionary: The loaded dictionary.
+/     - Board *board: The game board.
+/     - const char *rack: The letters the player has (any case).
+/     - Move foundMoves[]: Array to append found moves to.
+/     - int *totalMovesFound: Pointer to the number of moves already in foundMoves.
+/     - int maxMoves: Capacity of foundMoves.
+/   Caller Output:
+/     - void: Appends moves to foundMoves and updates totalMovesFound.
+/   Assumptions, Limitations, Known Bugs:
+/     - Every forward backend produces exactly the same moves; the GADDAG
+/       also finds the words through an anchor.
+/---------------------------------------------------------*/
+void generateMovesInDictionary(const Dictionary *dictionary, Board *board, const char *rack, Move foundMoves[], int *totalMovesFound, int maxMoves)
+{
+    SearchState state;
+
+    state.dictionary = dictionary;
+    state.gaddag = dictionary->gaddag;
+    generateIntoArray(&state, board, rack, foundMoves, totalMovesFound, maxMoves);
+}
+
+/*---------- FUNCTION: generateMovesIntoSink -----------------------------------
+/   Function Description:
+/     Finds every valid move for the given rack like generateMovesInDictionary
+/     and offers each one to a sink instead of an array.
+/   Caller Input:
+/     - const Dictionary *dictionary: The loaded dictionary.
+/     - Board *board: The game board.
+/     - const char *rack: The letters the player has (any case).
+/     - MoveSink *sink: An initialised sink.
+/     - int threads: Number of threads to search with (values below 1 mean 1).
+/   Caller Output:
+/     - void: No return value. The sink is finished and holds its moves in
+/       their final order.
+/   Assumptions, Limitations, Known Bugs:
+/     - The moves do not depend on the thread count.
+/---------------------------------------------------------*/
+void generateMovesIntoSink(const Dictionary *dictionary, Board *board, const char *rack, MoveSink *sink, int threads)
+{
+    GeneratorPool *pool = threads > 1 ? createGeneratorPool(threads) : NULL;
+
+    generateMovesInPool(dictionary, board, rack, sink, pool);
+    freeGeneratorPool(pool);
+}
+
+/*---------- FUNCTION: generateMovesInPool -----------------------------------
+/   Function Description:
+/     Same as generateMovesIntoSink, sharing the search out between the
+/     threads of a pool that outlives the call.
+/   Caller Input:
+/     - const Dictionary *dictionary: The loaded dictionary.
+/     - Board *board: The game board.
+/     - const char *rack: The letters the player has (any case).
+/     - MoveSink *sink: An initialised sink.
+/     - GeneratorPool *pool: The pool, NULL to search on the calling thread.
+/   Caller Output:
+/     - void: No return value. The sink is finished and holds its moves in
+/       their final order.
+/   Assumptions, Limitations, Known Bugs:
+/     - The moves do not depend on the pool size.
+/---------------------------------------------------------*/
+void generateMovesInPool(const Dictionary *dictionary, Board *board, const char *rack, MoveSink *sink, GeneratorPool *pool)
+{
+    SearchState state;
+
+    state.dictionary = dictionary;
+    state.gaddag = dictionary->gaddag;
+    runGenerator(&state, board, rack, sink, pool);
+    finishMoveSink(sink);
+}
+
+/*---------- FUNCTION: createGeneratorPool -----------------------------------
+/   Function Description:
+/     Creates a pool of workers for generateMovesInPool and starts a thread
+/     for every worker but the first, which is the thread that searches.
+/   Caller Input:
+/     - int threads: Number of threads to search with, including the caller.
+/   Caller Output:
+/     - GeneratorPool *: The pool, NULL if it could not be allocated.
+/   Assumptions, Limitations, Known Bugs:
+/     - Values below 1 mean 1.
+/     - If a thread cannot be started its share of every run is stolen by
+/       the other workers.
+/---------------------------------------------------------*/
+GeneratorPool *createGeneratorPool(int threads)
+{
+    if (threads < 1)
+    {
+        threads = 1;
+    }
+
+    GeneratorPool *pool = (GeneratorPool *)malloc(sizeof(GeneratorPool));
+    GeneratorWorker *workers = (GeneratorWorker *)calloc(threads, sizeof(GeneratorWorker));
+    if (pool == NULL || workers == NULL)
+    {
+        perror("Failed to allocate memory");
+        free(pool);
+        free(workers);
+        return NULL;
+    }
+
+    pool->workers = workers;
+    pool->totalWorkers = threads;
+    pool->startedThreads = 0;
+    pool->runNumber = 0;
+    pool->busyThreads = 0;
+    pool->stopping = false;
+    pool->prune = false;
+    pool->threshold = INT_MIN;
+    pool->movesSeen = 0;
+    pool->stoppedEarly = false;
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->wake, NULL);
+    pthread_cond_init(&pool->done, NULL);
+
+    for (int i = 0; i < threads; i++)
+    {
+        workers[i].pool = pool;
+        workers[i].index = i;
+        pthread_mutex_init(&workers[i].queue.lock, NULL);
+    }
+    for (int i = 1; i < threads; i++)
+    {
+        if (pthread_create(&workers[i].thread, NULL, runPoolThread, &workers[i]) != 0)
+        {
+            break;
+        }
+        pool->startedThreads = i;
+    }
+    return pool;
+}
+
+/*---------- FUNCTION: freeGeneratorPool -----------------------------------
+/   Function Description:
+/     Stops the threads of a pool and frees it.
+/   Caller Input:
+/     - GeneratorPool *pool: The pool, may be NULL.
+/   Caller Output:
+/     - void: No return value.
+/   Assumptions, Limitations, Known Bugs:
+/     - No run may be in progress.
+/---------------------------------------------------------*/
+void freeGeneratorPool(GeneratorPool *pool)
+{
+    if (pool == NULL)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    pool->stopping = true;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (int i = 1; i <= pool->startedThreads; i++)
+    {
+        pthread_join(pool->workers[i].thread, NULL);
+    }
+    for (int i = 0; i < pool->totalWorkers; i++)
+    {
+        free(pool->workers[i].moves);
+        pthread_mutex_destroy(&pool->workers[i].queue.lock);
+    }
+    pthread_cond_destroy(&pool->done);
+    pthread_cond_destroy(&pool->wake);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool->workers);
+    free(pool);
+}
+
+/*---------- FUNCTION: computeCrossChecks -----------------------------------
+/   Function Description:
+/     Fills in the cross-check mask and cross score of every empty square for
+/     both play orientations (see computeSquareCrossCheck).
+/   Caller Input:
+/     - Square board[BOARD_SIZE][BOARD_SIZE]: The loaded game board.
+/     - const Dictionary *dictionary: The loaded dictionary.
+/   Caller Output:
+/     - void: No return value. Updates crossCheck and crossScore of every empty square.
+/   Assumptions, Limitations, Known Bugs:
+/     - Must be called again after tiles are added to the board, unless
+/       they are added through a GameState (see applyMove).
+/     - The cross score is the face value of the neighbouring tiles only.
+/       A move that places a tile there adds the perpendicular word it forms:
+/       the cross score plus the tile, on the bonuses of its square.
+/---------------------------------------------------------*/
+void computeCrossChecks(Square board[BOARD_SIZE][BOARD_SIZE], const Dictionary *dictionary)
+{
+    for (int row = 0; row < BOARD_SIZE; row++)
+    {
+        for (int col = 0; col < BOARD_SIZE; col++)
+        {
+            if (board[row][col].letter != ' ')
+            {
+                continue;
+            }
+
+            for (int orientation = 0; orientation < 2; orientation++)
+            {
+                computeSquareCrossCheck(board, dictionary, row, col, orientation);
+            }
+        }
+    }
+}
+
+/*---------- FUNCTION: computeSquareCrossCheck -----------------------------------
+/   Function Description:
+/     Fills in the cross-check mask and cross score of one empty square for
+/     one play orientation. A tile placed in an UP/DOWN word forms a
+/     perpendicular word with the tiles left and right of it, a tile placed
+/     in a LEFT/RIGHT word with the tiles above and below it. The mask holds
+/     the letters for which that perpendicular word is in the dictionary;
+/     squares without perpendicular neighbours allow every letter.
+/   Caller Input:
+/     - Square board[BOARD_SIZE][BOARD_SIZE]: The loaded game board.
+/     - const Dictionary *dictionary: The loaded dictionary.
+/     - int row: Row index of the square.
+/     - int col: Column index of the square.
+/     - int orientation: CROSS_CHECK_INDEX of the plays to check for.
+/   Caller Output:
+/     - void: No return value. Updates crossCheck[orientation] and crossScore[orientation] of the square.
+/   Assumptions, Limitations, Known Bugs:
+/     - The square must be empty.
+/---------------------------------------------------------*/
+void computeSquareCrossCheck(Square board[BOARD_SIZE][BOARD_SIZE], const Dictionary *dictionary, int row, int col, int orientation)
+{
+    // The perpendicular word of an UP/DOWN play reads RIGHT, that of a LEFT/RIGHT play DOWN
+    int crossDirection = (orientation == CROSS_CHECK_INDEX(UP)) ? RIGHT : DOWN;
+    char before[BOARD_SIZE];
+    char after[BOARD_SIZE];
+    int beforeLength = 0;
+    int afterLength = 0;
+    int score = 0;
+
+    int r = row - rowStep[crossDirection];
+    int c = col - colStep[crossDirection];
+    while (isOnBoard(r, c) && board[r][c].letter != ' ')
+    {
+        r -= rowStep[crossDirection];
+        c -= colStep[crossDirection];
+    }
+    for (r += rowStep[crossDirection], c += colStep[crossDirection]; r != row || c != col; r += rowStep[crossDirection], c += colStep[crossDirection])
+    {
+        before[beforeLength++] = board[r][c].letter;
+    }
+    for (r = row + rowStep[crossDirection], c = col + colStep[crossDirection]; isOnBoard(r, c) && board[r][c].letter != ' '; r += rowStep[crossDirection], c += colStep[crossDirection])
+    {
+        after[afterLength++] = board[r][c].letter;
+    }
+
+    for (int i = 0; i < beforeLength; i++)
+    {
+        score += (before[i] >= 'A' && before[i] <= 'Z') ? letterScores[before[i] - 'A'] : 0;
+    }
+    for (int i = 0; i < afterLength; i++)
+    {
+        score += (after[i] >= 'A' && after[i] <= 'Z') ? letterScores[after[i] - 'A'] : 0;
+    }
+
+    board[row][col].crossCheck[orientation] = crossCheckMask(dictionary, before, beforeLength, after, afterLength);
+    board[row][col].crossScore[orientation] = score;
+}
+
+/*---------- FUNCTION: crossCheckMask -----------------------------------
+/   Function Description:
+/     Finds the letters that complete before + letter + after to a word. The
+/     letters before the square are walked once, then only the children of
+/     that cursor are tried with the letters after it.
+/   Caller Input:
+/     - const Dictionary *dictionary: The loaded dictionary.
+/     - const char *before: Tiles in front of the square, in reading order.
+/     - int beforeLength: Number of tiles in front of the square.
+/     - const char *after: Tiles behind the square, in reading order.
+/     - int afterLength: Number of tiles behind the square.
+/   Caller Output:
+/     - uint32_t: Bit i set if letter 'A' + i forms a word; CROSS_CHECK_ALL
+/       if there are no tiles on either side.
+/   Assumptions, Limitations, Known Bugs:
+/     - A dictionary that only holds a GADDAG is searched word by word.
+/---------------------------------------------------------*/
+static uint32_t crossCheckMask(const Dictionary *dictionary, const char *before, int beforeLength, const char *after, int afterLength)
+{
+    uint32_t mask = 0;
+
+    if (beforeLength == 0 && afterLength == 0)
+    {
+        return CROSS_CHECK_ALL;
+    }
+
+    if (dictionary->trie == NULL && dictionary->dawg == NULL && dictionary->compactTrie == NULL)
+    {
+        char word[BOARD_SIZE + 1];
+        memcpy(word, before, beforeLength);
+        memcpy(word + beforeLength + 1, after, afterLength);
+        word[beforeLength + 1 + afterLength] = '\0';
+        for (int i = 0; i < MAX_CHARACTERS; i++)
+        {
+            word[beforeLength] = 'A' + i;
+            if (searchGaddag(dictionary->gaddag, word))
+            {
+                mask |= 1u << i;
+            }
+        }
+        return mask;
+    }
+
+    DictCursor cursor = dictionaryRoot(dictionary);
+    for (int i = 0; i < beforeLength && cursor != DICT_CURSOR_NONE; i++)
+    {
+        cursor = dictionaryChild(dictionary, cursor, before[i]);
+    }
+    if (cursor == DICT_CURSOR_NONE)
+    {
+        return 0;
+    }
+
+    uint32_t letters = dictionaryChildMask(dictionary, cursor);
+    while (letters != 0)
+    {
+        int i = __builtin_ctz(letters);
+        letters &= letters - 1;
+
+        DictCursor node = dictionaryChild(dictionary, cursor, 'A' + i);
+        for (int j = 0; j < afterLength && node != DICT_CURSOR_NONE; j++)
+        {
+            node = dictionaryChild(dictionary, node, after[j]);
+        }
+        if (node != DICT_CURSOR_NONE && dictionaryIsWord(dictionary, node))
+        {
+            mask |= 1u << i;
+        }
+    }
+    return mask;
+}
@@ -0,0 +1,167 @@
+/*---------- ID HEADER -------------------------------------
+/   Author(s):    Aidan Andrews, Kyle Scidmore
+/   File Name:    moveGenerator.h
+/
+/   File Description:
+/     This header file declares the anchor-based move generator. Instead of
+/     re-scanning the board once for every permutation of the rack, the
+/     generator walks the dictionary (Trie, compact Trie, DAWG or GADDAG)
+/     once from each anchor square and draws tiles from a letter-count
+/     multiset of the rack, so every placement is discovered exactly once.
+/
+/---------------------------------------------------------*/
+#ifndef MOVEGENERATOR_H
+#define MOVEGENERATOR_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <limits.h>
+#include <pthread.h>
+
+#include "dataStruct.h"
+#include "gaddag.h"
+#include "dictionary.h"
+#include "moveSink.h"
+
+#define MAX_FOUND_MOVES 100000 // Size of a move buffer meant to hold every move of a rack
+
+// Worker threads kept between searches (see createGeneratorPool)
+typedef struct GeneratorPool GeneratorPool;
+
+/*---------- FUNCTION: generateMoves -----------------------------------
+/   Function Description:
+/     Finds every valid move for the given rack by walking the Trie from each
+/     valid placement square in all four directions.
+/   Caller Input:
+/     - TrieNode *root: Pointer to the root of the Trie.
+/     - Board *board: The game board.
+/     - const char *rack: The letters the player has (any case).
+/     - Move foundMoves[]: Array to append found moves to.
+/     - int *totalMovesFound: Pointer to the number of moves already in foundMoves.
+/     - int maxMoves: Capacity of foundMoves.
+/   Caller Output:
+/     - void: Appends moves to foundMoves and updates totalMovesFound.
+/   Assumptions, Limitations, Known Bugs:
+/     - Moves are produced in the same order and with the same fields as
+/       findMoves does for the full list of rack combinations.
+/     - Moves past maxMoves are dropped with a warning.
+/---------------------------------------------------------*/
+void generateMoves(TrieNode *root, Board *board, const char *rack, Move foundMoves[], int *totalMovesFound, int maxMoves);
+
+/*---------- FUNCTION: generateMovesWithGaddag -----------------------------------
+/   Function Description:
+/     Same as generateMoves, but walks a GADDAG from each empty anchor: the
+/     reversed prefix UP or LEFT of it, then the separator, then the suffix
+/     DOWN or RIGHT of it. It also finds the words that run through an
+/     anchor, which the walks starting or ending on one miss.
+/   Caller Input:
+/     - const Gaddag *gaddag: The GADDAG built from the dictionary.
+/     - Board *board: The game board.
+/     - const char *rack: The letters the player has (any case).
+/     - Move foundMoves[]: Array to append found moves to.
+/     - int *totalMovesFound: Pointer to the number of moves already in foundMoves.
+/     - int maxMoves: Capacity of foundMoves.
+/   Caller Output:
+/     - void: Appends moves to foundMoves and updates totalMovesFound.
+/   Assumptions, Limitations, Known Bugs:
+/     - Finds every move of generateMoves with the same score, each one
+/       once, plus the words through an anchor. The moves are ordered by
+/       rack tiles, then anchor column, row and direction.
+/---------------------------------------------------------*/
+void generateMovesWithGaddag(const Gaddag *gaddag, Board *board, const char *rack, Move foundMoves[], int *totalMovesFound, int maxMoves);
+
+/*---------- FUNCTION: generateMovesInDictionary -----------------------------------
+/   Function Description:
+/     Same as generateMoves, using the GADDAG of the dictionary if it has one,
+/     otherwise its DAWG, compact Trie or Trie, in that order.
+/   Caller Input:
+/     - const Dictionary *dictionary: The loaded dictionary.
+/     - Board *board: The game board.
+/     - const char *rack: The letters the player has (any case).
+/     - Move foundMoves[]: Array to append found moves to.
+/     - int *totalMovesFound: Pointer to the number of moves already in foundMoves.
+/     - int maxMoves: Capacity of foundMoves.
+/   Caller Output:
+/     - void: Appends moves to foundMoves and updates totalMovesFound.
+/   Assumptions, Limitations, Known Bugs:
+/     - The forward structures produce exactly the same moves as
+/       generateMoves; the GADDAG those of generateMovesWithGaddag.
+/---------------------------------------------------------*/
+void generateMovesInDictionary(const Dictionary *dictionary, Board *board, const char *rack, Move foundMoves[], int *totalMovesFound, int maxMoves);
+
+/*---------- FUNCTION: generateMovesIntoSink -----------------------------------
+/   Function Description:
+/     Same as generateMovesInDictionary, but offers every move to a MoveSink,
+/     which may keep only the best few.
+/   Caller Input:
+/     - const Dictionary *dictionary: The loaded dictionary.
+/     - Board *board: The game board.
+/     - const char *rack: The letters the player has (any case).
+/     - MoveSink *sink: An initialised sink.
+/     - int threads: Number of threads to search with; the anchor searches
+/       are shared out between them with work stealing.
+/   Caller Output:
+/     - void: Finishes the sink; its moves are in final order (see finishMoveSink).
+/   Assumptions, Limitations, Known Bugs:
+/     - The moves and their order do not depend on the thread count.
+/---------------------------------------------------------*/
+void generateMovesIntoSink(const Dictionary *dictionary, Board *board, const char *rack, MoveSink *sink, int threads);
+
+/*---------- FUNCTION: generateMovesInPool -----------------------------------
+/   Function Description:
+/     Same as generateMovesIntoSink, but searches with the threads of a pool
+/     made by createGeneratorPool, so repeated searches neither start
+/     threads nor, once the worker sinks have grown to fit, allocate.
+/   Caller Input:
+/     - const Dictionary *dictionary: The loaded dictionary.
+/     - Board *board: The game board.
+/     - const char *rack: The letters the player has (any case).
+/     - MoveSink *sink: An initialised sink.
+/     - GeneratorPool *pool: The pool, NULL to search on the calling thread.
+/   Caller Output:
+/     - void: Finishes the sink; its moves are in final order (see finishMoveSink).
+/   Assumptions, Limitations, Known Bugs:
+/     - Only one search at a time may use a pool; freeGeneratorPool stops
+/       its threads.
+/---------------------------------------------------------*/
+void generateMovesInPool(const Dictionary *dictionary, Board *board, const char *rack, MoveSink *sink, GeneratorPool *pool);
+GeneratorPool *createGeneratorPool(int threads);
+void freeGeneratorPool(GeneratorPool *pool);
+
+/*---------- FUNCTION: computeCrossChecks -----------------------------------
+/   Function Description:
+/     Computes, for every empty square and both play orientations, the
+/     letters that form a valid perpendicular word there and the face value
+/     of the perpendicular neighbours. Every generator then only places
+/     tiles the cross-check allows.
+/   Caller Input:
+/     - Square board[BOARD_SIZE][BOARD_SIZE]: The loaded game board.
+/     - const Dictionary *dictionary: The loaded dictionary.
+/   Caller Output:
+/     - void: Updates crossCheck and crossScore of every empty square.
+/   Assumptions, Limitations, Known Bugs:
+/     - Until it is called every letter passes the cross-checks.
+/---------------------------------------------------------*/
+void computeCrossChecks(Square board[BOARD_SIZE][BOARD_SIZE], const Dictionary *dictionary);
+
+/*---------- FUNCTION: computeSquareCrossCheck -----------------------------------
+/   Function Description:
+/     Same as computeCrossChecks, for one empty square and one play
+/     orientation, so a caller that knows which squares a new tile affects
+/     can refresh only those.
+/   Caller Input:
+/     - Square board[BOARD_SIZE][BOARD_SIZE]: The loaded game board.
+/     - const Dictionary *dictionary: The loaded dictionary.
+/     - int row: Row index of the square.
+/     - int col: Column index of the square.
+/     - int orientation: CROSS_CHECK_INDEX of the plays to check for.
+/   Caller Output:
+/     - void: Updates crossCheck[orientation] and crossScore[orientation] of the square.
+/   Assumptions, Limitations, Known Bugs:
+/     - The square must be empty.
+/---------------------------------------------------------*/
+void computeSquareCrossCheck(Square board[BOARD_SIZE][BOARD_SIZE], const Dictionary *dictionary, int row, int col, int orientation);
+
+#endif
@@ -0,0 +1,396 @@
+/*---------- ID HEADER -------------------------------------
+/   Author(s):    Aidan Andrews, Kyle Scidmore
+/   File Name:    moveSink.c
+/
+/   File Description:
+/     This file implements the MoveSink. A sink without a limit appends every
+/     move to a list that doubles when it is full. A sink with a limit keeps
+/     the best moves in a min-heap whose root is the worst move kept, so a
+/     new move only costs a comparison with the root unless it displaces it.
+/     When the search ends the heap is sorted in place, best move first.
+/
+/---------------------------------------------------------*/
+#include "moveSink.h"
+
+/* FUNCTION PROTOTYPES*/
+static bool ranksBefore(const GeneratedMove *first, const GeneratedMove *second);
+static void swapMoves(GeneratedMove *moves, int first, int second);
+static void siftDown(GeneratedMove *moves, int index, int totalMoves);
+
+/*---------- FUNCTION: compareGeneratedMoves -----------------------------------
+/   Function Description:
+/     qsort comparator ordering moves by rack combination, then anchor
+/     column, row and direction. This is the order findMoves reports moves in.
+/     The GADDAG can lay the same tiles from one anchor before or after it,
+/     so those moves are ordered by their first square.
+/   Caller Input:
+/     - const void *a: First GeneratedMove.
+/     - const void *b: Second GeneratedMove.
+/   Caller Output:
+/     - int: Negative, zero or positive like strcmp.
+/   Assumptions, Limitations, Known Bugs:
+/     - N/A
+/---------------------------------------------------------*/
+int compareGeneratedMoves(const void *a, const void *b)
+{
+    const GeneratedMove *first = a;
+    const GeneratedMove *second = b;
+
+    int result = strcmp(first->tiles, second->tiles);
+    if (result != 0)
+    {
+        return result;
+    }
+    if (first->origin != second->origin)
+    {
+        return first->origin - second->origin;
+    }
+    if (first->move.col != second->move.col)
+    {
+        return first->move.col - second->move.col;
+    }
+    return first->move.row - second->move.row;
+}
+
+/*---------- FUNCTION: ranksBefore -----------------------------------
+/   Function Description:
+/     Checks if a move ranks before another: a higher score first, and on a
+/     tie the move findMoves reports first, which is the one pickBestMove
+/     would choose.
+/   Caller Input:
+/     - const GeneratedMove *first: The first move.
+/     - const GeneratedMove *second: The second move.
+/   Caller Output:
+/     - bool: True if first ranks before second.
+/   Assumptions, Limitations, Known Bugs:
+/     - N/A
+/---------------------------------------------------------*/
+static bool ranksBefore(const GeneratedMove *first, const GeneratedMove *second)
+{
+    if (first->move.score != second->move.score)
+    {
+        return first->move.score > second->move.score;
+    }
+    return compareGeneratedMoves(first, second) < 0;
+}
+
+/*---------- FUNCTION: swapMoves -----------------------------------
+/   Function Description:
+/     Swaps two entries of a move array.
+/   Caller Input:
+/     - GeneratedMove *moves: The array.
+/     - int first: Index of the first entry.
+/     - int second: Index of the second entry.
+/   Caller Output:
+/     - void: No return value.
+/   Assumptions, Limitations, Known Bugs:
+/     - N/A
+/---------------------------------------------------------*/
+static void swapMoves(GeneratedMove *moves, int first, int second)
+{
+    GeneratedMove temp = moves[first];
+    moves[first] = moves[second];
+    moves[second] = temp;
+}
+
+/*---------- FUNCTION: siftDown -----------------------------------
+/   Function Description:
+/     Restores the heap order below an entry of a limited sink whose move
+/     was replaced, moving it down past every child that ranks after it.
+/   Caller Input:
+/     - GeneratedMove *moves: The heap.
+/     - int index: Index of the replaced entry.
+/     - int totalMoves: Number of entries in the heap.
+/   Caller Output:
+/     - void: No return value.
+/   Assumptions, Limitations, Known Bugs:
+/     - Both subtrees of the entry must already be heaps.
+/---------------------------------------------------------*/
+static void siftDown(GeneratedMove *moves, int index, int totalMoves)
+{
+    while (true)
+    {
+        int worst = index;
+        int left = 2 * index + 1;
+        int right = left + 1;
+        if (left < totalMoves && ranksBefore(&moves[worst], &moves[left]))
+        {
+            worst = left;
+        }
+        if (right < totalMoves && ranksBefore(&moves[worst], &moves[right]))
+        {
+            worst = right;
+        }
+        if (worst == index)
+        {
+            break;
+        }
+        swapMoves(moves, index, worst);
+        index = worst;
+    }
+}
+
+/*---------- FUNCTION: initMoveSink -----------------------------------
+/   Function Description:
+/     Prepares an empty sink.
+/   Caller Input:
+/     - MoveSink *sink: The sink to initialise.
+/     - int limit: Number of best moves to keep, MOVE_SINK_ALL to keep every move.
+/   Caller Output:
+/     - bool: False if the heap of a limited sink could not be allocated.
+/   Assumptions, Limitations, Known Bugs:
+/     - A limited sink allocates its heap once, up front; a sink without a
+/       limit allocates as moves arrive.
+/---------------------------------------------------------*/
+bool initMoveSink(MoveSink *sink, int limit)
+{
+    sink->moves = NULL;
+    sink->totalMoves = 0;
+    sink->capacity = 0;
+    sink->limit = limit < 0 ? MOVE_SINK_ALL : limit;
+    sink->movesSeen = 0;
+    sink->allowPruning = false;
+    sink->ownsMoves = true;
+    sink->deadline = 0;
+    sink->moveBudget = 0;
+    sink->stoppedEarly = false;
+
+    if (sink->limit != MOVE_SINK_ALL)
+    {
+        sink->moves = malloc(sink->limit * sizeof(GeneratedMove));
+        if (sink->moves == NULL)
+        {
+            perror("Failed to allocate memory");
+            return false;
+        }
+        sink->capacity = sink->limit;
+    }
+    return true;
+}
+
+/*---------- FUNCTION: initMoveSinkInBuffer -----------------------------------
+/   Function Description:
+/     Prepares an empty sink that keeps its moves in storage provided by
+/     the caller.
+/   Caller Input:
+/     - MoveSink *sink: The sink to initialise.
+/     - int limit: Number of best moves to keep, MOVE_SINK_ALL to keep every move.
+/     - GeneratedMove buffer[]: Storage for the moves.
+/     - int capacity: Number of moves buffer holds, at least limit.
+/   Caller Output:
+/     - void: No return value.
+/   Assumptions, Limitations, Known Bugs:
+/     - A limited sink never allocates. A sink without a limit moves to
+/       heap storage once the buffer is full.
+/     - The buffer must outlive the sink.
+/---------------------------------------------------------*/
+void initMoveSinkInBuffer(MoveSink *sink, int limit, GeneratedMove buffer[], int capacity)
+{
+    sink->moves = buffer;
+    sink->totalMoves = 0;
+    sink->capacity = capacity;
+    sink->limit = limit < 0 ? MOVE_SINK_ALL : limit;
+    sink->movesSeen = 0;
+    sink->allowPruning = false;
+    sink->ownsMoves = false;
+    sink->deadline = 0;
+    sink->moveBudget = 0;
+    sink->stoppedEarly = false;
+}
+
+/*---------- FUNCTION: addToMoveSink -----------------------------------
+/   Function Description:
+/     Offers a found move to a sink. A sink without a limit appends it,
+/     growing its list when it is full. A limited sink keeps it only if it
+/     ranks before the worst move kept so far.
+/   Caller Input:
+/     - MoveSink *sink: The sink.
+/     - const GeneratedMove *generatedMove: The move.
+/   Caller Output:
+/     - void: No return value.
+/   Assumptions, Limitations, Known Bugs:
+/     - Exits the program on allocation failure.
+/     - Moves must not be added after finishMoveSink.
+/---------------------------------------------------------*/
+void addToMoveSink(MoveSink *sink, const GeneratedMove *generatedMove)
+{
+    GeneratedMove *moves = sink->moves;
+
+    sink->movesSeen++;
+
+    if (sink->limit == MOVE_SINK_ALL)
+    {
+        if (sink->totalMoves == sink->capacity)
+        {
+            int newCapacity = sink->capacity == 0 ? 256 : sink->capacity * 2;
+            moves = realloc(sink->ownsMoves ? sink->moves : NULL, newCapacity * sizeof(GeneratedMove));
+            if (moves == NULL)
+            {
+                perror("Failed to allocate memory");
+                exit(1);
+            }
+            if (!sink->ownsMoves)
+            {
+                memcpy(moves, sink->moves, sink->totalMoves * sizeof(GeneratedMove));
+                sink->ownsMoves = true;
+            }
+            sink->moves = moves;
+            sink->capacity = newCapacity;
+        }
+        moves[sink->totalMoves++] = *generatedMove;
+        return;
+    }
+
+    // The heap root is the worst move kept: every parent ranks after its children
+    int index;
+    if (sink->totalMoves < sink->limit)
+    {
+        index = sink->totalMoves++;
+        moves[index] = *generatedMove;
+        while (index > 0 && ranksBefore(&moves[(index - 1) / 2], &moves[index]))
+        {
+            swapMoves(moves, index, (index - 1) / 2);
+            index = (index - 1) / 2;
+        }
+        return;
+    }
+
+    if (!ranksBefore(generatedMove, &moves[0]))
+    {
+        return;
+    }
+    moves[0] = *generatedMove;
+    siftDown(moves, 0, sink->totalMoves);
+}
+
+/*---------- FUNCTION: finishMoveSink -----------------------------------
+/   Function Description:
+/     Puts the moves of a sink in their final order: every move in the order
+/     findMoves reports them, or the kept best moves by rank, best first.
+/   Caller Input:
+/     - MoveSink *sink: The sink.
+/   Caller Output:
+/     - void: No return value.
+/   Assumptions, Limitations, Known Bugs:
+/     - Called once, after the last move was added.
+/     - The heap of a limited sink is sorted in place, without allocating,
+/       by moving its root (the worst move left) behind the heap until the
+/       heap is empty.
+/---------------------------------------------------------*/
+void finishMoveSink(MoveSink *sink)
+{
+    if (sink->limit == MOVE_SINK_ALL)
+    {
+        qsort(sink->moves, sink->totalMoves, sizeof(GeneratedMove), compareGeneratedMoves);
+        return;
+    }
+
+    for (int heapSize = sink->totalMoves - 1; heapSize > 0; heapSize--)
+    {
+        swapMoves(sink->moves, 0, heapSize);
+        siftDown(sink->moves, 0, heapSize);
+    }
+}
+
+/*---------- FUNCTION: setMoveSinkBudget -----------------------------------
+/   Function Description:
+/     Limits the search into a sink: once the time or move budget is spent
+/     no further anchor is searched and the sink keeps the best moves found
+/     so far.
+/   Caller Input:
+/     - MoveSink *sink: The sink.
+/     - SearchBudget budget: The limits, counted from now.
+/   Caller Output:
+/     - void: No return value.
+/   Assumptions, Limitations, Known Bugs:
+/     - Called just before the search starts.
+/---------------------------------------------------------*/
+void setMoveSinkBudget(MoveSink *sink, SearchBudget budget)
+{
+    sink->deadline = 0;
+    sink->moveBudget = budget.moves > 0 ? sink->movesSeen + budget.moves : 0;
+    if (budget.seconds > 0)
+    {
+        struct timespec time;
+        clock_gettime(CLOCK_MONOTONIC, &time);
+        sink->deadline = time.tv_sec + time.tv_nsec / 1e9 + budget.seconds;
+    }
+}
+
+/*---------- FUNCTION: moveSinkOutOfBudget -----------------------------------
+/   Function Description:
+/     Checks if a search into a sink has used up its deadline or move budget.
+/   Caller Input:
+/     - const MoveSink *sink: The sink.
+/     - long movesSeen: Moves offered so far, by every thread of the search.
+/   Caller Output:
+/     - bool: True if no further anchor should be searched.
+/   Assumptions, Limitations, Known Bugs:
+/     - Checked between anchor searches, so a search can overrun its
+/       deadline by the time of one anchor. Reading the clock costs a few
+/       tens of nanoseconds and only happens when a deadline is set.
+/---------------------------------------------------------*/
+bool moveSinkOutOfBudget(const MoveSink *sink, long movesSeen)
+{
+    if (sink->moveBudget > 0 && movesSeen >= sink->moveBudget)
+    {
+        return true;
+    }
+    if (sink->deadline > 0)
+    {
+        struct timespec time;
+        clock_gettime(CLOCK_MONOTONIC, &time);
+        return time.tv_sec + time.tv_nsec / 1e9 >= sink->deadline;
+    }
+    return false;
+}
+
+/*---------- FUNCTION: copyMoveSink -----------------------------------
+/   Function Description:
+/     Copies the moves of a finished sink into a Move array.
+/   Caller Input:
+/     - const MoveSink *sink: The finished sink.
+/     - Move moves[]: Array to copy the moves to.
+/     - int maxMoves: Capacity of moves.
+/   Caller Output:
+/     - int: Number of moves copied.
+/   Assumptions, Limitations, Known Bugs:
+/     - Moves past maxMoves are dropped with a warning.
+/---------------------------------------------------------*/
+int copyMoveSink(const MoveSink *sink, Move moves[], int maxMoves)
+{
+    int totalCopied = sink->totalMoves;
+
+    if (totalCopied > maxMoves)
+    {
+        fprintf(stderr, "Warning: move buffer full, %d moves dropped\n", totalCopied - maxMoves);
+        totalCopied = maxMoves < 0 ? 0 : maxMoves;
+    }
+    for (int i = 0; i < totalCopied; i++)
+    {
+        moves[i] = sink->moves[i].move;
+    }
+    return totalCopied;
+}
+
+/*---------- FUNCTION: freeMoveSink -----------------------------------
+/   Function Description:
+/     Frees the moves held by a sink.
+/   Caller Input:
+/     - MoveSink *sink: The sink.
+/   Caller Output:
+/     - void: No return value.
+/   Assumptions, Limitations, Known Bugs:
+/     - A buffer provided by the caller is left alone.
+/     - The sink must be initialised again before it is reused.
+/---------------------------------------------------------*/
+void freeMoveSink(MoveSink *sink)
+{
+    if (sink->ownsMoves)
+    {
+        free(sink->moves);
+    }
+    sink->moves = NULL;
+    sink->totalMoves = 0;
+    sink->capacity = 0;
+}
@@ -0,0 +1,88 @@
+/*---------- ID HEADER -------------------------------------
+/   Author(s):    Aidan Andrews, Kyle Scidmore
+/   File Name:    moveSink.h
+/
+/   File Description:
+/     This header file defines the MoveSink, which receives every move the
+/     anchor-based generator finds. A sink either collects all of them in a
+/     list that grows as needed, or keeps only the best few in a bounded
+/     min-heap, so finding the best move (or a short ranked list of
+/     alternatives) needs no buffer sized for every legal move. The moves
+/     can be kept in storage the caller provides, so a search into a
+/     limited sink allocates nothing. A sink can also carry a deadline and
+/     a move budget, after which the search stops and the sink keeps the
+/     best moves found so far.
+/
+/---------------------------------------------------------*/
+#ifndef MOVESINK_H
+#define MOVESINK_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+
+#include "dataStruct.h"
+
+#define MOVE_SINK_ALL 0 // Sink limit that collects every move
+
+// Limits of an anytime search; zero fields mean no limit
+typedef struct SearchBudget {
+    double seconds; // Wall time the search may take.
+    long moves;     // Moves the search may examine.
+} SearchBudget;
+
+#define SEARCH_EXHAUSTIVE ((SearchBudget){0, 0}) // Budget of a search that runs to the end
+
+// Every found move together with the information needed to order it
+typedef struct GeneratedMove {
+    Move move;
+    char tiles[BOARD_SIZE + 1]; // Rack tiles in the order they were laid from the anchor (GADDAG: before it, then after it).
+    int origin;                 // Anchor column, row and search direction packed into one key.
+} GeneratedMove;
+
+// Receiver of found moves
+typedef struct MoveSink {
+    GeneratedMove *moves; // Collected moves; a min-heap on rank while a limited sink is filling.
+    int totalMoves;
+    int capacity;
+    int limit;            // Moves kept, MOVE_SINK_ALL to keep every move.
+    long movesSeen;       // Moves offered to the sink, kept or not.
+    bool ownsMoves;       // moves was allocated by the sink rather than provided by the caller.
+    bool allowPruning;    // Let a limited sink's search skip anchors that cannot reach it (see searchByBound).
+    double deadline;      // CLOCK_MONOTONIC time after which no further anchor is searched, 0 for none.
+    long moveBudget;      // Moves that may be offered before no further anchor is searched, 0 for no limit.
+    bool stoppedEarly;    // An anchor was left unsearched because of the deadline or budget.
+} MoveSink;
+
+// Function prototypes
+bool initMoveSink(MoveSink *sink, int limit);
+void initMoveSinkInBuffer(MoveSink *sink, int limit, GeneratedMove buffer[], int capacity);
+void addToMoveSink(MoveSink *sink, const GeneratedMove *generatedMove);
+void finishMoveSink(MoveSink *sink);
+int copyMoveSink(const MoveSink *sink, Move moves[], int maxMoves);
+void freeMoveSink(MoveSink *sink);
+int compareGeneratedMoves(const void *a, const void *b);
+void setMoveSinkBudget(MoveSink *sink, SearchBudget budget);
+bool moveSinkOutOfBudget(const MoveSink *sink, long movesSeen);
+
+/*---------- FUNCTION: moveSinkRejects -----------------------------------
+/   Function Description:
+/     Checks if a sink would turn away every move scoring at most a bound.
+/   Caller Input:
+/     - const MoveSink *sink: The sink.
+/     - int bound: Highest score the moves in question can have.
+/   Caller Output:
+/     - bool: True if the sink is limited, full, and its worst move scores
+/       more than the bound.
+/   Assumptions, Limitations, Known Bugs:
+/     - A move scoring the same as the worst kept move can still rank
+/       before it, so equal scores are never rejected.
+/---------------------------------------------------------*/
+static inline bool moveSinkRejects(const MoveSink *sink, int bound)
+{
+    return sink->limit != MOVE_SINK_ALL && sink->totalMoves == sink->limit && bound < sink->moves[0].move.score;
+}
+
+#endif
@@ -0,0 +1,726 @@
+/*---------- ID HEADER -------------------------------------
+/   Author(s):    Aidan Andrews, Kyle Scidmore
+/   File Name:    server.c
+/
+/   File Description:
+/     This file implements the solver service. The thread in runServer
+/     polls the listening socket and every idle connection; a connection
+/     that becomes readable is put on the worker queue. A worker reads what
+/     the connection has sent, answers every complete request line and
+/     hands the connection back to the poller through a wake-up pipe. A
+/     connection is therefore served by one worker at a time, its replies
+/     stay in request order, and idle connections cost no worker.
+/
+/---------------------------------------------------------*/
+#include "server.h"
+#include "batch.h"
+#include "solverContext.h"
+
+#define SERVER_BACKLOG 64
+#define SERVER_STATS_LENGTH 256 // Longest STATS reply
+
+// Connection states
+#define CONNECTION_FREE 0   // Slot unused.
+#define CONNECTION_IDLE 1   // Polled by runServer.
+#define CONNECTION_QUEUED 2 // Queued for or held by a worker.
+
+// One client connection and its unfinished request line
+typedef struct ServerConnection
+{
+    int fd;
+    int state;
+    char buffer[SERVER_LINE_LENGTH];
+    size_t used;   // Bytes of buffer holding the start of the next request.
+    long requests; // Requests answered on this connection.
+    double queuedAt; // When the connection was queued for a worker.
+} ServerConnection;
+
+// One worker thread with its own solver state and reply buffer
+typedef struct ServerWorker
+{
+    Server *server;
+    SolverContext *context;
+    Move *moves;
+    char *reply;
+    size_t replySize;
+    pthread_t thread;
+} ServerWorker;
+
+struct Server
+{
+    const Dictionary *dictionary;
+    int topMoves;
+    SearchBudget budget;
+    int listenFd;
+    int wakePipe[2]; // Written to when a connection is handed back or the service is stopped.
+    char socketPath[sizeof(((struct sockaddr_un *)0)->sun_path)];
+    int stopRequested; // Set by stopServer, read with atomics so it is signal safe.
+
+    pthread_mutex_t lock; // Guards everything below.
+    pthread_cond_t workAvailable;
+    bool stopping;
+    ServerConnection connections[SERVER_MAX_CONNECTIONS];
+    int openConnections;
+    int queue[SERVER_QUEUE_LENGTH]; // Ring of connection indexes.
+    int queueHead;
+    int queueLength;
+    int maxQueueDepth;
+    long requests;
+    long failedRequests;
+    long partialRequests;
+    long latencies[SERVER_LATENCY_SAMPLES]; // Ring of the latest latencies in microseconds.
+    long sortedLatencies[SERVER_LATENCY_SAMPLES];
+
+    ServerWorker *workers;
+    int totalWorkers;
+};
+
+/* FUNCTION PROTOTYPES*/
+static double now(void);
+static void wakePoller(Server *server);
+static bool sendAll(int fd, const char *data, size_t length);
+static int compareLongs(const void *a, const void *b);
+static void recordRequest(Server *server, double queuedAt, bool failed, bool partial);
+static size_t answerRequest(ServerWorker *worker, ServerConnection *connection, char *line, bool *failed, bool *partial);
+static bool serveConnection(ServerWorker *worker, ServerConnection *connection);
+static void *runServerWorker(void *argument);
+static void acceptConnection(Server *server);
+static void queueConnection(Server *server, int index);
+
+/*---------- FUNCTION: now -----------------------------------
+/   Function Description:
+/     Returns a monotonic time stamp.
+/   Caller Input:
+/     - None.
+/   Caller Output:
+/     - double: Seconds since an arbitrary point.
+/   Assumptions, Limitations, Known Bugs:
+/     - N/A
+/---------------------------------------------------------*/
+static double now(void)
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec + time.tv_nsec / 1e9;
+}
+
+/*---------- FUNCTION: wakePoller -----------------------------------
+/   Function Description:
+/     Makes the poll in runServer return so it rebuilds its list of sockets.
+/   Caller Input:
+/     - Server *server: The service.
+/   Caller Output:
+/     - void: No return value.
+/   Assumptions, Limitations, Known Bugs:
+/     - The pipe does not block; if it is full a wake-up is already pending.
+/---------------------------------------------------------*/
+static void wakePoller(Server *server)
+{
+    char wakeUp = 0;
+    if (write(server->wakePipe[1], &wakeUp, 1) < 0)
+    {
+        return;
+    }
+}
+
+/*---------- FUNCTION: sendAll -----------------------------------
+/   Function Description:
+/     Sends a whole reply.
+/   Caller Input:
+/     - int fd: The connection.
+/     - const char *data: The reply.
+/     - size_t length: Its length.
+/   Caller Output:
+/     - bool: False if the client went away.
+/   Assumptions, Limitations, Known Bugs:
+/     - Blocks while the client is not reading; a closed client does not
+/       raise SIGPIPE.
+/---------------------------------------------------------*/
+static bool sendAll(int fd, const char *data, size_t length)
+{
+    while (length > 0)
+    {
+        ssize_t sent = send(fd, data, length, MSG_NOSIGNAL);
+        if (sent < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (sent <= 0)
+        {
+            return false;
+        }
+        data += sent;
+        length -= sent;
+    }
+    return true;
+}
+
+/*---------- FUNCTION: compareLongs -----------------------------------
+/   Function Description:
+/     qsort comparator for ascending longs.
+/   Caller Input:
+/     - const void *a: First long.
+/     - const void *b: Second long.
+/   Caller Output:
+/     - int: Negative, zero or positive like strcmp.
+/   Assumptions, Limitations, Known Bugs:
+/     - N/A
+/---------------------------------------------------------*/
+static int compareLongs(const void *a, const void *b)
+{
+    long first = *(const long *)a;
+    long second = *(const long *)b;
+    return (first > second) - (first < second);
+}
+
+/*---------- FUNCTION: recordRequest -----------------------------------
+/   Function Description:
+/     Counts an answered request and keeps its latency.
+/   Caller Input:
+/     - Server *server: The service.
+/     - double queuedAt: When the request was read off the socket.
+/     - bool failed: True if it was answered with an error.
+/     - bool partial: True if its search stopped at the budget.
+/   Caller Output:
+/     - void: No return value.
+/   Assumptions, Limitations, Known Bugs:
+/     - N/A
+/---------------------------------------------------------*/
+static void recordRequest(Server *server, double queuedAt, bool failed, bool partial)
+{
+    long micros = (long)((now() - queuedAt) * 1e6);
+
+    pthread_mutex_lock(&server->lock);
+    server->latencies[server->requests % SERVER_LATENCY_SAMPLES] = micros;
+    server->requests++;
+    server->failedRequests += failed;
+    server->partialRequests += partial;
+    pthread_mutex_unlock(&server->lock);
+}
+
+/*---------- FUNCTION: answerRequest -----------------------------------
+/   Function Description:
+/     Builds the reply to one request line (see server.h).
+/   Caller Input:
+/     - ServerWorker *worker: The worker answering.
+/     - ServerConnection *connection: The connection the line came from.
+/     - char *line: The request, without its line ending; it is modified.
+/     - bool *failed: Set if the reply is an error.
+/     - bool *partial: Set if the search stopped at the budget.
+/   Caller Output:
+/     - size_t: Length of the reply in the worker's reply buffer.
+/   Assumptions, Limitations, Known Bugs:
+/     - N/A
+/---------------------------------------------------------*/
+static size_t answerRequest(ServerWorker *worker, ServerConnection *connection, char *line, bool *failed, bool *partial)
+{
+    size_t length;
+    long number = ++connection->requests;
+    bool complete = true;
+
+    *failed = false;
+    *partial = false;
+    if (strcmp(line, "STATS") == 0)
+    {
+        ServerStats stats;
+        serverStats(worker->server, &stats);
+        length = snprintf(worker->reply, worker->replySize,
+                          "requests=%ld\tfailed=%ld\tpartial=%ld\tconnections=%d\tqueueDepth=%d\tmaxQueueDepth=%d\tp50Micros=%ld\tp99Micros=%ld\n\n",
+                          stats.requests, stats.failedRequests, stats.partialRequests, stats.connections, stats.queueDepth,
+                          stats.maxQueueDepth, stats.p50Micros, stats.p99Micros);
+        return length;
+    }
+
+    char rack[BOARD_SIZE + 1];
+    char letters[BOARD_SQUARES];
+    bool hasBoard;
+    int totalMoves = 0;
+    const char *error = parseJobLine(line, rack, letters, &hasBoard);
+    if (error == NULL && !hasBoard)
+    {
+        error = "request must hold the rack and 225 squares";
+    }
+    if (error == NULL)
+    {
+        error = solveJob(worker->context, rack, letters, worker->moves, worker->server->topMoves, worker->server->budget,
+                         &totalMoves, &complete);
+    }
+
+    *failed = error != NULL;
+    *partial = !complete;
+    length = formatJobResult(worker->reply, worker->replySize - 1, number, rack, error, worker->moves, totalMoves, complete);
+    worker->reply[length++] = '\n';
+    return length;
+}
+
+/*---------- FUNCTION: serveConnection -----------------------------------
+/   Function Description:
+/     Reads what a readable connection has sent and answers every complete
+/     request line, keeping the start of an unfinished one.
+/   Caller Input:
+/     - ServerWorker *worker: The worker serving.
+/     - ServerConnection *connection: The connection.
+/   Caller Output:
+/     - bool: False if the connection is to be closed.
+/   Assumptions, Limitations, Known Bugs:
+/     - A line longer than SERVER_LINE_LENGTH is answered with an error
+/       and closes the connection.
+/---------------------------------------------------------*/
+static bool serveConnection(ServerWorker *worker, ServerConnection *connection)
+{
+    ssize_t received;
+    do
+    {
+        received = recv(connection->fd, connection->buffer + connection->used, SERVER_LINE_LENGTH - 1 - connection->used, 0);
+    } while (received < 0 && errno == EINTR);
+    if (received <= 0)
+    {
+        return false;
+    }
+    connection->used += received;
+
+    char *start = connection->buffer;
+    char *end;
+    while ((end = memchr(start, '\n', connection->buffer + connection->used - start)) != NULL)
+    {
+        *end = '\0';
+        if (end > start && end[-1] == '\r')
+        {
+            end[-1] = '\0';
+        }
+        if (*start != '\0')
+        {
+            bool failed;
+            bool partial;
+            size_t length = answerRequest(worker, connection, start, &failed, &partial);
+            recordRequest(worker->server, connection->queuedAt, failed, partial);
+            if (!sendAll(connection->fd, worker->reply, length))
+            {
+                return false;
+            }
+        }
+        start = end + 1;
+    }
+    connection->used -= start - connection->buffer;
+    memmove(connection->buffer, start, connection->used);
+
+    if (connection->used == SERVER_LINE_LENGTH - 1)
+    {
+        const char *reply = "0\t0\terror\tline too long\n\n";
+        sendAll(connection->fd, reply, strlen(reply));
+        recordRequest(worker->server, connection->queuedAt, true, false);
+        return false;
+    }
+    return true;
+}
+
+/*---------- FUNCTION: runServerWorker -----------------------------------
+/   Function Description:
+/     Serves queued connections until the service is freed.
+/   Caller Input:
+/     - void *argument: The ServerWorker.
+/   Caller Output:
+/     - void *: Always NULL.
+/   Assumptions, Limitations, Known Bugs:
+/     - A connection is closed under the lock so freeServer never shuts
+/       down a descriptor that was already reused.
+/---------------------------------------------------------*/
+static void *runServerWorker(void *argument)
+{
+    ServerWorker *worker = (ServerWorker *)argument;
+    Server *server = worker->server;
+
+    pthread_mutex_lock(&server->lock);
+    while (true)
+    {
+        while (server->queueLength == 0 && !server->stopping)
+        {
+            pthread_cond_wait(&server->workAvailable, &server->lock);
+        }
+        if (server->stopping)
+        {
+            break;
+        }
+        ServerConnection *connection = &server->connections[server->queue[server->queueHead]];
+        server->queueHead = (server->queueHead + 1) % SERVER_QUEUE_LENGTH;
+        server->queueLength--;
+        pthread_mutex_unlock(&server->lock);
+
+        bool keep = serveConnection(worker, connection);
+
+        pthread_mutex_lock(&server->lock);
+        if (keep)
+        {
+            connection->state = CONNECTION_IDLE;
+        }
+        else
+        {
+            close(connection->fd);
+            connection->state = CONNECTION_FREE;
+            server->openConnections--;
+        }
+        wakePoller(server);
+    }
+    pthread_mutex_unlock(&server->lock);
+    return NULL;
+}
+
+/*---------- FUNCTION: acceptConnection -----------------------------------
+/   Function Description:
+/     Accepts a waiting client into a free connection slot.
+/   Caller Input:
+/     - Server *server: The service.
+/   Caller Output:
+/     - void: No return value.
+/   Assumptions, Limitations, Known Bugs:
+/     - Only called while a slot is free; the listening socket does not
+/       block, so a client that already left is ignored.
+/---------------------------------------------------------*/
+static void acceptConnection(Server *server)
+{
+    int fd = accept(server->listenFd, NULL, NULL);
+    if (fd < 0)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&server->lock);
+    for (int i = 0; i < SERVER_MAX_CONNECTIONS; i++)
+    {
+        if (server->connections[i].state == CONNECTION_FREE)
+        {
+            server->connections[i].fd = fd;
+            server->connections[i].state = CONNECTION_IDLE;
+            server->connections[i].used = 0;
+            server->connections[i].requests = 0;
+            server->openConnections++;
+            fd = -1;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&server->lock);
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+}
+
+/*---------- FUNCTION: queueConnection -----------------------------------
+/   Function Description:
+/     Queues a readable idle connection for the workers.
+/   Caller Input:
+/     - Server *server: The service.
+/     - int index: Slot of the connection.
+/   Caller Output:
+/     - void: No return value.
+/   Assumptions, Limitations, Known Bugs:
+/     - If the queue is full the connection stays idle and is polled again
+/       once a worker frees an entry.
+/---------------------------------------------------------*/
+static void queueConnection(Server *server, int index)
+{
+    pthread_mutex_lock(&server->lock);
+    if (server->queueLength < SERVER_QUEUE_LENGTH)
+    {
+        server->connections[index].state = CONNECTION_QUEUED;
+        server->connections[index].queuedAt = now();
+        server->queue[(server->queueHead + server->queueLength) % SERVER_QUEUE_LENGTH] = index;
+        server->queueLength++;
+        if (server->queueLength > server->maxQueueDepth)
+        {
+            server->maxQueueDepth = server->queueLength;
+        }
+        pthread_cond_signal(&server->workAvailable);
+    }
+    pthread_mutex_unlock(&server->lock);
+}
+
+/*---------- FUNCTION: createServer -----------------------------------
+/   Function Description:
+/     Creates the socket of a service and its worker threads.
+/   Caller Input:
+/     - const Dictionary *dictionary: The loaded dictionary.
+/     - const char *socketPath: Path of the socket.
+/     - int threads: Number of worker threads (values below 1 mean 1).
+/     - int topMoves: Moves reported per job (values below 1 mean 1).
+/     - SearchBudget budget: Limits of each job's search.
+/   Caller Output:
+/     - Server *: The service, NULL if the socket or workers could not be set up.
+/   Assumptions, Limitations, Known Bugs:
+/     - Only a socket is replaced at socketPath; any other file there makes
+/       the bind fail.
+/---------------------------------------------------------*/
+Server *createServer(const Dictionary *dictionary, const char *socketPath, int threads, int topMoves, SearchBudget budget)
+{
+    struct sockaddr_un address;
+    struct stat existing;
+
+    if (strlen(socketPath) >= sizeof(address.sun_path))
+    {
+        fprintf(stderr, "Socket path too long: %s\n", socketPath);
+        return NULL;
+    }
+
+    Server *server = (Server *)calloc(1, sizeof(Server));
+    if (server == NULL)
+    {
+        perror("Failed to allocate memory");
+        return NULL;
+    }
+    server->dictionary = dictionary;
+    server->topMoves = topMoves < 1 ? 1 : topMoves;
+    server->budget = budget;
+    server->listenFd = -1;
+    server->wakePipe[0] = -1;
+    server->wakePipe[1] = -1;
+    strcpy(server->socketPath, socketPath);
+    pthread_mutex_init(&server->lock, NULL);
+    pthread_cond_init(&server->workAvailable, NULL);
+
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, socketPath);
+    if (stat(socketPath, &existing) == 0 && S_ISSOCK(existing.st_mode))
+    {
+        unlink(socketPath);
+    }
+
+    server->listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (server->listenFd < 0 || pipe(server->wakePipe) != 0 ||
+        bind(server->listenFd, (struct sockaddr *)&address, sizeof(address)) != 0 ||
+        listen(server->listenFd, SERVER_BACKLOG) != 0)
+    {
+        perror("Failed to create the server socket");
+        server->socketPath[0] = '\0';
+        freeServer(server);
+        return NULL;
+    }
+    fcntl(server->listenFd, F_SETFL, O_NONBLOCK);
+    fcntl(server->wakePipe[0], F_SETFL, O_NONBLOCK);
+    fcntl(server->wakePipe[1], F_SETFL, O_NONBLOCK);
+
+    threads = threads < 1 ? 1 : threads;
+    server->workers = (ServerWorker *)calloc(threads, sizeof(ServerWorker));
+    if (server->workers == NULL)
+    {
+        perror("Failed to allocate memory");
+        freeServer(server);
+        return NULL;
+    }
+    for (int i = 0; i < threads; i++)
+    {
+        ServerWorker *worker = &server->workers[i];
+        worker->server = server;
+        worker->context = createSolverContextForDictionary(dictionary, 1);
+        worker->moves = (Move *)malloc(server->topMoves * sizeof(Move));
+        worker->replySize = (size_t)server->topMoves * BATCH_RESULT_LINE_LENGTH + SERVER_STATS_LENGTH;
+        worker->reply = (char *)malloc(worker->replySize);
+        if (worker->context == NULL || worker->moves == NULL || worker->reply == NULL ||
+            pthread_create(&worker->thread, NULL, runServerWorker, worker) != 0)
+        {
+            fprintf(stderr, "Failed to start server worker %d\n", i);
+            freeSolverContext(worker->context);
+            free(worker->moves);
+            free(worker->reply);
+            freeServer(server);
+            return NULL;
+        }
+        server->totalWorkers++;
+    }
+    return server;
+}
+
+/*---------- FUNCTION: runServer -----------------------------------
+/   Function Description:
+/     Polls the listening socket and the idle connections, accepting
+/     clients and queueing readable connections, until stopServer is called.
+/   Caller Input:
+/     - Server *server: The service.
+/   Caller Output:
+/     - bool: False if poll failed.
+/   Assumptions, Limitations, Known Bugs:
+/     - While the queue is full only the wake-up pipe is polled.
+/---------------------------------------------------------*/
+bool runServer(Server *server)
+{
+    struct pollfd fds[SERVER_MAX_CONNECTIONS + 2];
+    int slots[SERVER_MAX_CONNECTIONS + 2];
+
+    while (!__atomic_load_n(&server->stopRequested, __ATOMIC_RELAXED))
+    {
+        int totalFds = 0;
+        fds[totalFds].fd = server->wakePipe[0];
+        fds[totalFds].events = POLLIN;
+        slots[totalFds++] = -1;
+
+        pthread_mutex_lock(&server->lock);
+        if (server->queueLength < SERVER_QUEUE_LENGTH)
+        {
+            if (server->openConnections < SERVER_MAX_CONNECTIONS)
+            {
+                fds[totalFds].fd = server->listenFd;
+                fds[totalFds].events = POLLIN;
+                slots[totalFds++] = -1;
+            }
+            for (int i = 0; i < SERVER_MAX_CONNECTIONS; i++)
+            {
+                if (server->connections[i].state == CONNECTION_IDLE)
+                {
+                    fds[totalFds].fd = server->connections[i].fd;
+                    fds[totalFds].events = POLLIN;
+                    slots[totalFds++] = i;
+                }
+            }
+        }
+        pthread_mutex_unlock(&server->lock);
+
+        if (poll(fds, totalFds, -1) < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            perror("Failed to poll the server sockets");
+            return false;
+        }
+
+        char drained[64];
+        if (fds[0].revents != 0)
+        {
+            while (read(server->wakePipe[0], drained, sizeof(drained)) > 0)
+            {
+            }
+        }
+        for (int i = 1; i < totalFds; i++)
+        {
+            if (fds[i].revents == 0)
+            {
+                continue;
+            }
+            if (slots[i] < 0)
+            {
+                acceptConnection(server);
+            }
+            else
+            {
+                queueConnection(server, slots[i]);
+            }
+        }
+    }
+    return true;
+}
+
+/*---------- FUNCTION: stopServer -----------------------------------
+/   Function Description:
+/     Makes runServer return.
+/   Caller Input:
+/     - Server *server: The service.
+/   Caller Output:
+/     - void: No return value.
+/   Assumptions, Limitations, Known Bugs:
+/     - Only uses an atomic store and write, so it is safe in a signal handler.
+/---------------------------------------------------------*/
+void stopServer(Server *server)
+{
+    __atomic_store_n(&server->stopRequested, 1, __ATOMIC_RELAXED);
+    wakePoller(server);
+}
+
+/*---------- FUNCTION: serverStats -----------------------------------
+/   Function Description:
+/     Reads the counters of a service.
+/   Caller Input:
+/     - Server *server: The service.
+/     - ServerStats *stats: Receives the counters.
+/   Caller Output:
+/     - void: No return value.
+/   Assumptions, Limitations, Known Bugs:
+/     - Sorts a copy of the latency samples under the lock, which holds up
+/       the workers for a few microseconds.
+/---------------------------------------------------------*/
+void serverStats(Server *server, ServerStats *stats)
+{
+    pthread_mutex_lock(&server->lock);
+    stats->requests = server->requests;
+    stats->failedRequests = server->failedRequests;
+    stats->partialRequests = server->partialRequests;
+    stats->connections = server->openConnections;
+    stats->queueDepth = server->queueLength;
+    stats->maxQueueDepth = server->maxQueueDepth;
+
+    int samples = server->requests < SERVER_LATENCY_SAMPLES ? (int)server->requests : SERVER_LATENCY_SAMPLES;
+    stats->p50Micros = 0;
+    stats->p99Micros = 0;
+    if (samples > 0)
+    {
+        memcpy(server->sortedLatencies, server->latencies, samples * sizeof(long));
+        qsort(server->sortedLatencies, samples, sizeof(long), compareLongs);
+        stats->p50Micros = server->sortedLatencies[(samples - 1) / 2];
+        stats->p99Micros = server->sortedLatencies[(samples * 99 + 99) / 100 - 1];
+    }
+    pthread_mutex_unlock(&server->lock);
+}
+
+/*---------- FUNCTION: freeServer -----------------------------------
+/   Function Description:
+/     Stops the workers, closes every connection and removes the socket.
+/   Caller Input:
+/     - Server *server: The service, NULL is ignored.
+/   Caller Output:
+/     - void: No return value.
+/   Assumptions, Limitations, Known Bugs:
+/     - Connections a worker is sending to are shut down first so the
+/       worker cannot stay blocked on a client that stopped reading.
+/---------------------------------------------------------*/
+void freeServer(Server *server)
+{
+    if (server == NULL)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&server->lock);
+    server->stopping = true;
+    for (int i = 0; i < SERVER_MAX_CONNECTIONS; i++)
+    {
+        if (server->connections[i].state != CONNECTION_FREE)
+        {
+            shutdown(server->connections[i].fd, SHUT_RDWR);
+        }
+    }
+    pthread_cond_broadcast(&server->workAvailable);
+    pthread_mutex_unlock(&server->lock);
+
+    for (int i = 0; i < server->totalWorkers; i++)
+    {
+        pthread_join(server->workers[i].thread, NULL);
+        freeSolverContext(server->workers[i].context);
+        free(server->workers[i].moves);
+        free(server->workers[i].reply);
+    }
+    for (int i = 0; i < SERVER_MAX_CONNECTIONS; i++)
+    {
+        if (server->connections[i].state != CONNECTION_FREE)
+        {
+            close(server->connections[i].fd);
+        }
+    }
+
+    if (server->listenFd >= 0)
+    {
+        close(server->listenFd);
+    }
+    if (server->wakePipe[0] >= 0)
+    {
+        close(server->wakePipe[0]);
+        close(server->wakePipe[1]);
+    }
+    if (server->socketPath[0] != '\0')
+    {
+        unlink(server->socketPath);
+    }
+    pthread_cond_destroy(&server->workAvailable);
+    pthread_mutex_destroy(&server->lock);
+    free(server->workers);
+    free(server);
+}
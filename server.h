@@ -0,0 +1,135 @@
+/*---------- ID HEADER -------------------------------------
+/   Author(s):    Aidan Andrews, Kyle Scidmore
+/   File Name:    server.h
+/
+/   File Description:
+/     This header file declares the solver service, which loads the
+/     dictionary once and answers solve requests over a Unix domain socket.
+/     Requests are served by a fixed pool of worker threads, each with its
+/     own SolverContext on the shared dictionary.
+/
+/     Protocol (one request per line, any number per connection):
+/       - a compact job, the rack, a space and all 225 squares of the board
+/         (see batch.h), answered with its result lines in the batch output
+/         format, numbered by request on the connection;
+/       - STATS, answered with one line of tab-separated name=value counters
+/         (see ServerStats).
+/     Every reply ends with an empty line.
+/
+/     Backpressure: connections with a request waiting are queued for the
+/     workers in a queue of SERVER_QUEUE_LENGTH entries. While it is full
+/     the service neither reads requests nor accepts connections, so further
+/     requests wait in the socket buffers and the listen backlog.
+/
+/---------------------------------------------------------*/
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <pthread.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <time.h>
+
+#include "dataStruct.h"
+#include "dictionary.h"
+#include "moveSink.h"
+
+#define SERVER_MAX_CONNECTIONS 256 // Open connections; further clients wait in the listen backlog
+#define SERVER_QUEUE_LENGTH 64     // Connections with a request waiting for a worker
+#define SERVER_LATENCY_SAMPLES 4096 // Latest request latencies the percentiles are taken over
+#define SERVER_LINE_LENGTH 512     // Longest request line, line ending included
+
+// Solver service listening on a Unix domain socket (see createServer)
+typedef struct Server Server;
+
+// Counters of a running service
+typedef struct ServerStats {
+    long requests;       // Requests answered, STATS included.
+    long failedRequests; // Requests answered with an error.
+    long partialRequests; // Jobs whose search stopped at the time budget.
+    int connections;     // Connections open.
+    int queueDepth;      // Connections waiting for a worker.
+    int maxQueueDepth;   // Highest queue depth seen.
+    long p50Micros;      // Median latency, from the request being read to its reply being ready.
+    long p99Micros;      // 99th percentile latency.
+} ServerStats;
+
+/*---------- FUNCTION: createServer -----------------------------------
+/   Function Description:
+/     Creates the socket of a service and its worker threads.
+/   Caller Input:
+/     - const Dictionary *dictionary: The loaded dictionary; it must
+/       outlive the service.
+/     - const char *socketPath: Path of the socket; a file already there is replaced.
+/     - int threads: Number of worker threads (values below 1 mean 1).
+/     - int topMoves: Moves reported per job (values below 1 mean 1).
+/     - SearchBudget budget: Limits of each job's search, SEARCH_EXHAUSTIVE
+/       for none; a budget bounds the tail latency of costly positions.
+/   Caller Output:
+/     - Server *: The service, NULL if the socket or workers could not be set up.
+/   Assumptions, Limitations, Known Bugs:
+/     - Nothing is served until runServer is called.
+/---------------------------------------------------------*/
+Server *createServer(const Dictionary *dictionary, const char *socketPath, int threads, int topMoves, SearchBudget budget);
+
+/*---------- FUNCTION: runServer -----------------------------------
+/   Function Description:
+/     Accepts connections and hands their requests to the workers until
+/     stopServer is called.
+/   Caller Input:
+/     - Server *server: The service.
+/   Caller Output:
+/     - bool: False if waiting on the socket failed.
+/   Assumptions, Limitations, Known Bugs:
+/     - Called once, on one thread.
+/---------------------------------------------------------*/
+bool runServer(Server *server);
+
+/*---------- FUNCTION: stopServer -----------------------------------
+/   Function Description:
+/     Makes runServer return.
+/   Caller Input:
+/     - Server *server: The service.
+/   Caller Output:
+/     - void: No return value.
+/   Assumptions, Limitations, Known Bugs:
+/     - Safe to call from a signal handler and from any thread.
+/     - Requests not yet answered are dropped with their connections.
+/---------------------------------------------------------*/
+void stopServer(Server *server);
+
+/*---------- FUNCTION: serverStats -----------------------------------
+/   Function Description:
+/     Reads the counters of a service.
+/   Caller Input:
+/     - Server *server: The service.
+/     - ServerStats *stats: Receives the counters.
+/   Caller Output:
+/     - void: No return value.
+/   Assumptions, Limitations, Known Bugs:
+/     - The percentiles cover the latest SERVER_LATENCY_SAMPLES requests.
+/---------------------------------------------------------*/
+void serverStats(Server *server, ServerStats *stats);
+
+/*---------- FUNCTION: freeServer -----------------------------------
+/   Function Description:
+/     Stops the workers, closes every connection and removes the socket.
+/   Caller Input:
+/     - Server *server: The service, NULL is ignored.
+/   Caller Output:
+/     - void: No return value.
+/   Assumptions, Limitations, Known Bugs:
+/     - runServer must have returned (or never been called).
+/---------------------------------------------------------*/
+void freeServer(Server *server);
+
+#endif
@@ -10,11 +10,13 @@
 /
 /---------------------------------------------------------*/
 #include "solver.h"
+#include "moveGenerator.h"
 
 /* FUNCTION PROTOTYPES*/
 static void findStartingSquare(const int x, const int y, const int direction, const int currentCombinationIndex, Move *move);
-static void reverseString(char *oldString, char *newString);
-static void dfs(TrieNode *head, char *prefix, int *depth, int x, int y, Square board[BOARD_SIZE][BOARD_SIZE], char *combinationToTest, Move foundMoves[], int *totalMovesFound, int direction, int *currentCombinationIndex);
+static void reverseString(const char *oldString, char *newString);
+static void dfs(TrieNode *head, TrieNode *cursor, char *prefix, int *depth, int x, int y, Square board[BOARD_SIZE][BOARD_SIZE], char *combinationToTest, Move foundMoves[], int *totalMovesFound, int direction, int *currentCombinationIndex, int crossWords);
+static int crossWordScore(const Square *square, int direction, char letter);
 static void resetValues(int *depth, char *prefix, int *currentCombinationIndex);
 static void findMovesForBoard(
     TrieNode *root,
@@ -22,8 +24,6 @@ static void findMovesForBoard(
     int *totalMovesFound,
     Square board[BOARD_SIZE][BOARD_SIZE],
     char *combination,
-    int x,
-    int y,
     int *depth,
     char *prefix,
     int *currentCombinationIndex);
@@ -41,17 +41,24 @@ void findMoves(
     Square board[BOARD_SIZE][BOARD_SIZE],
     char *combinationsToTest[],
     int totalCombinations);
-static void swap(char *x, char *y);
-static void permute(char *letters, int left, int right, char *combinations[], unsigned int *totalCombinations);
-static void generateCombinationsRecurse(const char *letters, int totalLetters, char *combination, int start, int index, char *combinations[], unsigned int *totalCombinations);
-static void calculateScore(Move *move, Square board[BOARD_SIZE][BOARD_SIZE], int rackLettersUsed);
+
+// Face value of every letter, 'A' to 'Z'
+const int letterScores[MAX_CHARACTERS] = {
+    1, 3, 3, 2, 1, 4, 2, 4, 1, 8,
+    5, 1, 3, 1, 1, 3, 10, 1, 1, 1,
+    1, 4, 4, 8, 4, 10};
 
 /*---------- FUNCTION: dfs -----------------------------------
 /   Function Description:
 /     Performs Depth-First Search (DFS) to find valid word placements on the board.
+/     A Trie cursor for the letters placed so far is carried along, so each
+/     step is a single child lookup and the search stops as soon as the
+/     letters stop being the start (DOWN/RIGHT) or end (UP/LEFT) of a word.
 /
 /   Caller Input:
 /     - TrieNode *head: Pointer to the root of the Trie.
+/     - TrieNode *cursor: Node reached by the letters in prefix: in the Trie for
+/       DOWN/RIGHT, in the reverse Trie for UP/LEFT (its root at depth 0).
 /     - char *prefix: Current prefix of the word being formed.
 /     - int *depth: Pointer to the current depth of the search.
 /     - int x: Current column index.
@@ -62,25 +69,28 @@ static void calculateScore(Move *move, Square board[BOARD_SIZE][BOARD_SIZE], int
 /     - int *totalMovesFound: Pointer to the total number of moves found.
 /     - int direction: Direction of the search (UP, DOWN, LEFT, RIGHT).
 /     - int *currentCombinationIndex: Pointer to the current index in the letter combination.
+/     - int crossWords: Score of the perpendicular words formed by the tiles placed so far.
 /
 /   Caller Output:
 /     - void: No return value. Updates the foundMoves array and totalMovesFound.
 /
 /   Assumptions, Limitations, Known Bugs:
-/     - N/A
+/     - A move is only recorded when the last letter of the combination is
+/       placed; the search ends at the next empty square after that.
+/     - A tile is only placed on a square whose cross-check allows it.
+/     - A word is only recorded if the square past its last placed letter
+/       is empty or off the board.
+/     - For UP/LEFT the letters are placed last letter first, so the cursor
+/       walks the reverse Trie. Without one the cursor is unused and the
+/       reversed word is looked up once, when it is complete.
 /---------------------------------------------------------*/
-static void dfs(TrieNode *head, char *prefix, int *depth, int x, int y, Square board[BOARD_SIZE][BOARD_SIZE], char *combinationToTest, Move foundMoves[], int *totalMovesFound, int direction, int *currentCombinationIndex)
+static void dfs(TrieNode *head, TrieNode *cursor, char *prefix, int *depth, int x, int y, Square board[BOARD_SIZE][BOARD_SIZE], char *combinationToTest, Move foundMoves[], int *totalMovesFound, int direction, int *currentCombinationIndex, int crossWords)
 {
     if (x < 0 || x >= BOARD_SIZE || y < 0 || y >= BOARD_SIZE)
     {
         return;
     }
 
-    if (*currentCombinationIndex > (int)strlen(combinationToTest))
-    {
-        return;
-    }
-
     if (*depth == 0)
     {
         if (direction == UP && board[y + 1][x].letter != ' ')
@@ -101,170 +111,175 @@ static void dfs(TrieNode *head, char *prefix, int *depth, int x, int y, Square b
         }
     }
 
-    if (y >= 0 && y < BOARD_SIZE && x >= 0 && x < BOARD_SIZE && board[y][x].letter != ' ')
-    {
-        strncat(prefix, &board[y][x].letter, 1);
-        (*depth)++;
+    bool forward = (direction == DOWN || direction == RIGHT);
+    bool walked = forward || reverseTrieRoot(head) != NULL; // cursor follows the letters placed so far
+    char letter = board[y][x].letter;
+    bool placingTile = (letter == ' ');
 
-        switch (direction)
+    if (placingTile)
+    {
+        // Every letter of the combination is placed; nothing more can be recorded
+        if (combinationToTest[*currentCombinationIndex] == '\0')
         {
-        case UP:
-            dfs(head, prefix, depth, x, y - 1, board, combinationToTest, foundMoves, totalMovesFound, direction, currentCombinationIndex);
-            return;
-        case DOWN:
-            dfs(head, prefix, depth, x, y + 1, board, combinationToTest, foundMoves, totalMovesFound, direction, currentCombinationIndex);
-            return;
-        case LEFT:
-            dfs(head, prefix, depth, x - 1, y, board, combinationToTest, foundMoves, totalMovesFound, direction, currentCombinationIndex);
-            return;
-        case RIGHT:
-            dfs(head, prefix, depth, x + 1, y, board, combinationToTest, foundMoves, totalMovesFound, direction, currentCombinationIndex);
             return;
         }
+        letter = combinationToTest[*currentCombinationIndex];
+        int index = letter - 'A';
+        if (index < 0 || index >= MAX_CHARACTERS || !(board[y][x].crossCheck[CROSS_CHECK_INDEX(direction)] & (1u << index)))
+        {
+            return; // The tile would not form a word with its perpendicular neighbours
+        }
+        crossWords += crossWordScore(&board[y][x], direction, letter);
+        (*currentCombinationIndex)++;
     }
 
-    // Instead of checking if (prefix) is a valid word first, add the next letter now:
-    strncat(prefix, &combinationToTest[*currentCombinationIndex], 1);
+    prefix[*depth] = letter;
+    prefix[*depth + 1] = '\0';
     (*depth)++;
-    (*currentCombinationIndex)++;
-
-    char *reversePrefix = malloc(strlen(prefix) + 1);
-    reverseString(prefix, reversePrefix);
 
-    int reversePrefixIsWord = 0;
-    if (direction == UP || direction == LEFT)
+    if (walked)
     {
-        reversePrefixIsWord = searchWord(head, reversePrefix);
-    }
-
-    int prefixIsWord = 0;
-    if (searchWord(head, prefix) && (direction == DOWN || direction == RIGHT))
-    {
-        prefixIsWord = 1;
+        cursor = trieChild(cursor, letter);
+        if (cursor == NULL)
+        {
+            return;
+        }
     }
 
-    if ((reversePrefixIsWord || prefixIsWord) && (*currentCombinationIndex == (int)strlen(combinationToTest)))
+    if (placingTile && combinationToTest[*currentCombinationIndex] == '\0')
     {
-        Move newMove;
+        bool isWord = walked ? cursor->isWord : searchReversedWord(head, prefix);
 
-        newMove.direction = direction;
+        // A tile on the next square would run into the word and make it longer
+        int nextX = x + (direction == LEFT ? -1 : direction == RIGHT ? 1 : 0);
+        int nextY = y + (direction == UP ? -1 : direction == DOWN ? 1 : 0);
+        bool ends = nextX < 0 || nextX >= BOARD_SIZE || nextY < 0 || nextY >= BOARD_SIZE || board[nextY][nextX].letter == ' ';
 
-        if (reversePrefixIsWord)
+        if (isWord && ends)
         {
+            Move newMove;
 
-            strcpy(newMove.word, reversePrefix);
-            newMove.row = y;
-            newMove.col = x;
-            newMove.isReversed = true;
-        }
-        else
-        {
-            strcpy(newMove.word, prefix);
+            if (forward)
+            {
+                strcpy(newMove.word, prefix);
+            }
+            else
+            {
+                reverseString(prefix, newMove.word);
+            }
             findStartingSquare(x, y, direction, *depth, &newMove);
-        }
-        newMove.direction = direction;
 
-        calculateScore(&newMove, board, *currentCombinationIndex);
+            calculateScore(&newMove, board, *currentCombinationIndex);
+            newMove.score += crossWords;
 
-        if (newMove.isReversed)
-        {
-            switch (direction)
-            {
-            case UP:
-                newMove.direction = DOWN;
-                break;
-            case DOWN:
-                newMove.direction = UP;
-                break;
-            case LEFT:
-                newMove.direction = RIGHT;
-                break;
-            case RIGHT:
-                newMove.direction = LEFT;
-                break;
-            }
+            foundMoves[*totalMovesFound] = newMove;
+            *totalMovesFound += 1;
         }
-
-        foundMoves[*totalMovesFound] = newMove;
-        *totalMovesFound += 1;
     }
 
-    free(reversePrefix);
-
     switch (direction)
     {
     case UP:
-        dfs(head, prefix, depth, x, y - 1, board, combinationToTest, foundMoves, totalMovesFound, direction, currentCombinationIndex);
-
+        dfs(head, cursor, prefix, depth, x, y - 1, board, combinationToTest, foundMoves, totalMovesFound, direction, currentCombinationIndex, crossWords);
         break;
     case DOWN:
-        dfs(head, prefix, depth, x, y + 1, board, combinationToTest, foundMoves, totalMovesFound, direction, currentCombinationIndex);
-
+        dfs(head, cursor, prefix, depth, x, y + 1, board, combinationToTest, foundMoves, totalMovesFound, direction, currentCombinationIndex, crossWords);
         break;
     case LEFT:
-        dfs(head, prefix, depth, x - 1, y, board, combinationToTest, foundMoves, totalMovesFound, direction, currentCombinationIndex);
-
+        dfs(head, cursor, prefix, depth, x - 1, y, board, combinationToTest, foundMoves, totalMovesFound, direction, currentCombinationIndex, crossWords);
         break;
     case RIGHT:
-        dfs(head, prefix, depth, x + 1, y, board, combinationToTest, foundMoves, totalMovesFound, direction, currentCombinationIndex);
-
+        dfs(head, cursor, prefix, depth, x + 1, y, board, combinationToTest, foundMoves, totalMovesFound, direction, currentCombinationIndex, crossWords);
         break;
     }
 }
 
-/*---------- FUNCTION: calculateScore -----------------------------------
+/*---------- FUNCTION: crossWordScore -----------------------------------
 /   Function Description:
-/     Calculates the score of a move based on the number of squares used and any bonuses.
+/     Scores the perpendicular word a tile forms with its neighbours.
 /
 /   Caller Input:
-/     - int totalSquaresUsed: The number of squares used in the move.
-/     - in[5]: Array containing the number of each type o (Double Letter, Triple Letter, Double Word, Triple Word).
+/     - const Square *square: The empty square the tile is placed on.
+/     - int direction: Direction of the word being placed.
+/     - char letter: The tile, 'A' to 'Z'.
+/
+/   Caller Output:
+/     - int: Score of the perpendicular word, 0 if the tile forms none.
+/
+/   Assumptions, Limitations, Known Bugs:
+/     - crossScore is only filled in by computeCrossChecks; before that no
+/       tile forms a perpendicular word.
+/---------------------------------------------------------*/
+static int crossWordScore(const Square *square, int direction, char letter)
+{
+    int neighbours = square->crossScore[CROSS_CHECK_INDEX(direction)];
+    int value = letterScores[letter - 'A'];
+    int bonus = square->usedBonus ? 0 : square->bonus;
+    int wordMultiplier = 1;
+
+    if (neighbours == 0)
+    {
+        return 0;
+    }
+
+    if (bonus == 1) // Double Letter
+    {
+        value *= 2;
+    }
+    else if (bonus == 2) // Triple Letter
+    {
+        value *= 3;
+    }
+    else if (bonus == 3) // Double Word
+    {
+        wordMultiplier = 2;
+    }
+    else if (bonus == 4) // Triple Word
+    {
+        wordMultiplier = 3;
+    }
+
+    return (neighbours + value) * wordMultiplier;
+}
+
+/*---------- FUNCTION: calculateScore -----------------------------------
+/   Function Description:
+/     Calculates the score of a move's word from the letters and the unused
+/     bonuses of the squares it covers, read down or right from (row, col).
 /
+/   Caller Input:
 /     - Move *move: Pointer to the Move structure where the score will be stored.
+/     - Square board[BOARD_SIZE][BOARD_SIZE]: The game board.
+/     - int rackLettersUsed: Number of rack tiles the move places.
 /
 /   Caller Output:
 /     - void: No return value. The score is stored directly in the Move structure pointed to by 'move'.
 /
 /   Assumptions, Limitations, Known Bugs:
-/     - N/A
+/     - Perpendicular words are not included; the solvers add them.
+/     - Letters that would fall outside the board carry no bonus.
 /---------------------------------------------------------*/
-static void calculateScore(Move *move, Square board[BOARD_SIZE][BOARD_SIZE], int rackLettersUsed)
+void calculateScore(Move *move, Square board[BOARD_SIZE][BOARD_SIZE], int rackLettersUsed)
 {
 
-    int letterScores[26] = {
-        1, 3, 3, 2, 1, 4, 2, 4, 1, 8,
-        5, 1, 3, 1, 1, 3, 10, 1, 1, 1,
-        1, 4, 4, 8, 4, 10};
-
     int totalScore = 0;
     int wordMultiplier = 1;
 
-    for (unsigned long i = 0; i < strlen(move->word); i++)
+    for (int i = 0; move->word[i] != '\0'; i++)
     {
-        int row = move->row;
-        int col = move->col;
-
-        switch (move->direction)
-        {
-        case UP:
-            row -= i;
-            break;
-        case DOWN:
-            row += i;
-            break;
-        case LEFT:
-            col -= i;
-            break;
-        case RIGHT:
-            col += i;
-            break;
-        }
-
+        int row = move->row + (move->direction == DOWN ? i : 0);
+        int col = move->col + (move->direction == RIGHT ? i : 0);
         char c = move->word[i];
 
         if (c >= 'A' && c <= 'Z')
         {
             int letterScore = letterScores[c - 'A'];
+
+            if (row < 0 || row >= BOARD_SIZE || col < 0 || col >= BOARD_SIZE)
+            {
+                totalScore += letterScore;
+                continue;
+            }
             // Apply double/triple letter bonuses
             if (board[row][col].bonus == 1 && !board[row][col].usedBonus) // Double Letter
             {
@@ -300,7 +315,7 @@ static void calculateScore(Move *move, Square board[BOARD_SIZE][BOARD_SIZE], int
 /     Reverses a given string.
 /
 /   Caller Input:
-/     - char *oldString: The string to be reversed.
+/     - const char *oldString: The string to be reversed.
 /     - char *newString: The buffer to store the reversed string.
 /
 /   Caller Output:
@@ -309,7 +324,7 @@ static void calculateScore(Move *move, Square board[BOARD_SIZE][BOARD_SIZE], int
 /   Assumptions, Limitations, Known Bugs:
 /     - Assumes newString has enough allocated space.
 /---------------------------------------------------------*/
-static void reverseString(char *oldString, char *newString)
+static void reverseString(const char *oldString, char *newString)
 {
     int length = strlen(oldString);
     for (int i = 0; i < length; i++)
@@ -319,60 +334,82 @@ static void reverseString(char *oldString, char *newString)
     newString[length] = '\0';
 }
 
+/*---------- FUNCTION: findMovesForBoard -----------------------------------
+/   Function Description:
+/     Runs dfs in all four directions from every valid placement square,
+/     column by column, for one letter combination.
+/
+/   Caller Input:
+/     - TrieNode *root: Root node of the Trie used for word validation.
+/     - Move foundMoves[]: Array to store found moves.
+/     - int *totalMovesFound: Pointer to the total number of moves found.
+/     - Square board[BOARD_SIZE][BOARD_SIZE]: The game board.
+/     - char *combination: The letter combination to place.
+/     - int *depth: Search depth, reset after every dfs.
+/     - char *prefix: Prefix buffer, reset after every dfs.
+/     - int *currentCombinationIndex: Combination index, reset after every dfs.
+/
+/   Caller Output:
+/     - void: No return value. Updates the foundMoves array and totalMovesFound.
+/
+/   Assumptions, Limitations, Known Bugs:
+/     - N/A
+/---------------------------------------------------------*/
 static void findMovesForBoard(
     TrieNode *root,
     Move foundMoves[],
     int *totalMovesFound,
     Square board[BOARD_SIZE][BOARD_SIZE],
     char *combination,
-    int x,
-    int y,
     int *depth,
     char *prefix,
     int *currentCombinationIndex)
 {
-    if (x >= BOARD_SIZE)
+    TrieNode *reverseRoot = reverseTrieRoot(root);
+    if (reverseRoot == NULL)
     {
-        return;
+        reverseRoot = root; // Not walked by dfs without a reverse Trie
     }
 
-    if (y >= BOARD_SIZE)
+    for (int x = 0; x < BOARD_SIZE; x++)
     {
-        findMovesForBoard(root, foundMoves, totalMovesFound, board, combination, x + 1, 0, depth, prefix, currentCombinationIndex);
-        return;
-    }
+        for (int y = 0; y < BOARD_SIZE; y++)
+        {
+            if (!board[y][x].validPlacement)
+            {
+                continue;
+            }
 
-    if (board[y][x].validPlacement)
-    {
-        dfs(root, prefix, depth, x, y, board, combination, foundMoves, totalMovesFound, UP, currentCombinationIndex);
-        resetValues(depth, prefix, currentCombinationIndex);
+            dfs(root, reverseRoot, prefix, depth, x, y, board, combination, foundMoves, totalMovesFound, UP, currentCombinationIndex, 0);
+            resetValues(depth, prefix, currentCombinationIndex);
 
-        dfs(root, prefix, depth, x, y, board, combination, foundMoves, totalMovesFound, DOWN, currentCombinationIndex);
-        resetValues(depth, prefix, currentCombinationIndex);
+            dfs(root, root, prefix, depth, x, y, board, combination, foundMoves, totalMovesFound, DOWN, currentCombinationIndex, 0);
+            resetValues(depth, prefix, currentCombinationIndex);
 
-        dfs(root, prefix, depth, x, y, board, combination, foundMoves, totalMovesFound, LEFT, currentCombinationIndex);
-        resetValues(depth, prefix, currentCombinationIndex);
+            dfs(root, reverseRoot, prefix, depth, x, y, board, combination, foundMoves, totalMovesFound, LEFT, currentCombinationIndex, 0);
+            resetValues(depth, prefix, currentCombinationIndex);
 
-        dfs(root, prefix, depth, x, y, board, combination, foundMoves, totalMovesFound, RIGHT, currentCombinationIndex);
-        resetValues(depth, prefix, currentCombinationIndex);
+            dfs(root, root, prefix, depth, x, y, board, combination, foundMoves, totalMovesFound, RIGHT, currentCombinationIndex, 0);
+            resetValues(depth, prefix, currentCombinationIndex);
+        }
     }
-
-    findMovesForBoard(root, foundMoves, totalMovesFound, board, combination, x, y + 1, depth, prefix, currentCombinationIndex);
 }
+
 /*---------- FUNCTION: findStartingSquare -----------------------------------
 /   Function Description:
-/     Calculates the starting row and column coordinates of a word placement
-/     based on its ending coordinates, direction, and word length.
+/     Calculates the first square of a word placement and the direction it
+/     reads in from the last square searched, the search direction and the
+/     word length.
 /
 /   Caller Input:
-/     - const int x: The ending column coordinate of the word.
-/     - const int y: The ending row coordinate of the word.
-/     - const int direction: The direction of the word (UP, DOWN, LEFT, RIGHT).
+/     - const int x: The column of the last square searched.
+/     - const int y: The row of the last square searched.
+/     - const int direction: The search direction (UP, DOWN, LEFT, RIGHT).
 /     - const int combinationLength: The length of the word.
-/     - Move *move: Pointer to the Move structure where the starting coordinates will be stored.
+/     - Move *move: Pointer to the Move structure where the first square and the direction will be stored.
 /
 /   Caller Output:
-/     - void: No return value. The starting row and column are stored directly in the Move structure pointed to by 'move'.
+/     - void: No return value. The first square and the reading direction, DOWN or RIGHT, are stored directly in the Move structure pointed to by 'move'.
 /
 /   Assumptions, Limitations, Known Bugs:
 /     - Assumes 'move' is a valid pointer to a Move structure.
@@ -380,23 +417,24 @@ static void findMovesForBoard(
 /---------------------------------------------------------*/
 static void findStartingSquare(const int x, const int y, const int direction, const int combinationLength, Move *move)
 {
+    move->row = y;
+    move->col = x;
+
     switch (direction)
     {
     case UP:
-        move->row = y + combinationLength;
-        move->col = x;
+        move->direction = DOWN;
         break;
     case DOWN:
-        move->row = y - combinationLength;
-        move->col = x;
+        move->row = y - combinationLength + 1;
+        move->direction = DOWN;
         break;
     case LEFT:
-        move->col = x + combinationLength + 1;
-        move->row = y;
+        move->direction = RIGHT;
         break;
     case RIGHT:
-        move->col = x - combinationLength - 1;
-        move->row = y;
+        move->col = x - combinationLength + 1;
+        move->direction = RIGHT;
         break;
     }
 }
@@ -437,7 +475,7 @@ static void findMovesForCombination(
     int currentCombinationIndex = 0;
     int depth = 0;
     char prefix[BOARD_SIZE + 1] = "";
-    findMovesForBoard(root, foundMoves, totalMovesFound, board, combination, 0, 0, &depth, prefix, &currentCombinationIndex);
+    findMovesForBoard(root, foundMoves, totalMovesFound, board, combination, &depth, prefix, &currentCombinationIndex);
 }
 /*---------- FUNCTION: resetValues -----------------------------------
 /   Function Description:
@@ -491,203 +529,145 @@ void findMoves(
     char *combinationsToTest[],
     int totalCombinations)
 {
-
-    if (totalCombinations <= 0)
+    for (int i = 0; i < totalCombinations; i++)
     {
-        return;
+        findMovesForCombination(root, foundMoves, totalMovesFound, board, combinationsToTest[i], 0);
     }
-
-    findMovesForCombination(root, foundMoves, totalMovesFound, board, combinationsToTest[0], 0);
-
-    // Recurse to handle the rest of the combinations
-    findMoves(root, foundMoves, totalMovesFound, board, combinationsToTest + 1, totalCombinations - 1);
 }
 
-/*---------- FUNCTION: swap -----------------------------------
+/*---------- FUNCTION: initRackPermutations -----------------------------------
 /   Function Description:
-/     Swaps two characters.
+/     Starts an iterator over the distinct permutations of every subset of
+/     a rack (see nextRackPermutation).
 /
 /   Caller Input:
-/     - char *x: Pointer to the first character.
-/     - char *y: Pointer to the second character.
+/     - RackPermutations *permutations: The iterator to initialise.
+/     - const char *rack: The letters to permute.
 /
 /   Caller Output:
-/     - void: No return value. Swaps the characters directly.
+/     - void: No return value.
 /
 /   Assumptions, Limitations, Known Bugs:
-/     - N/A
-/---------------------------------------------------------*/
-static void swap(char *x, char *y)
-{
-    char temp = *x;
-    *x = *y;
-    *y = temp;
-}
-
-/*---------- FUNCTION: permuteRecursive -----------------------------------
-/   Function Description:
-/     Recursively generates unique permutations of a set of characters by
-/     swapping and tracking used characters.
-/   Caller Input:
-/     - char *letters: The string of letters to permute.
-/     - int left: The current left boundary of the permutation range.
-/     - int right: The right boundary of the permutation range.
-/     - char *combinations[]: Array to store generated permutations.
-/     - unsigned int *totalCombinations: Pointer to the total permutations found.
-/     - bool used[]: Tracks which characters have been used to avoid duplicates.
-/     - int i: The current index being evaluated.
-/   Caller Output:
-/     - void: Updates 'combinations' and 'totalCombinations'.
-/   Assumptions, Limitations, Known Bugs:
-/     - N/A
+/     - Only the first MAX_COMBINATION_LENGTH letters are used.
 /---------------------------------------------------------*/
-static void permuteRecursive(char *letters, int left, int right, char *combinations[], unsigned int *totalCombinations, bool used[], int i)
+void initRackPermutations(RackPermutations *permutations, const char *rack)
 {
-    if (i > right)
-    {
-        return;
-    }
+    permutations->totalLetters = 0;
+    permutations->length = 0;
+    permutations->finished = false;
+    permutations->current[0] = '\0';
 
-    unsigned char c = (unsigned char)letters[i];
-    if (!used[c])
+    // Distinct letters in strcmp order, with how often each occurs
+    for (int i = 0; rack[i] != '\0' && i < MAX_COMBINATION_LENGTH; i++)
     {
-        used[c] = true;
-        swap(&letters[left], &letters[i]);
-        permute(letters, left + 1, right, combinations, totalCombinations);
-        swap(&letters[left], &letters[i]);
+        unsigned char letter = (unsigned char)rack[i];
+        int position = 0;
+        while (position < permutations->totalLetters && (unsigned char)permutations->letters[position] < letter)
+        {
+            position++;
+        }
+        if (position < permutations->totalLetters && (unsigned char)permutations->letters[position] == letter)
+        {
+            permutations->counts[position]++;
+            continue;
+        }
+        for (int j = permutations->totalLetters; j > position; j--)
+        {
+            permutations->letters[j] = permutations->letters[j - 1];
+            permutations->counts[j] = permutations->counts[j - 1];
+        }
+        permutations->letters[position] = (char)letter;
+        permutations->counts[position] = 1;
+        permutations->totalLetters++;
     }
-
-    permuteRecursive(letters, left, right, combinations, totalCombinations, used, i + 1);
 }
 
-/*---------- FUNCTION: permute -----------------------------------
+/*---------- FUNCTION: nextRackPermutation -----------------------------------
 /   Function Description:
-/     Generates all permutations of a given string.
+/     Advances the iterator to the next distinct permutation in strcmp order.
+/     The permutations are the words of a tree whose children add one more
+/     rack letter, visited in preorder: the next one appends the smallest
+/     letter left, and once none is left the last letters are given back
+/     until one can be replaced by a larger letter left.
 /
 /   Caller Input:
-/     - char *letters: The string to permute.
-/     - int left: Starting index for permutation.
-/     - int right: Ending index for permutation.
-/     - char *combinations[]: Array to store generated combinations.
-/     - unsigned int *totalCombinations: Pointer to the total number of combinations.
+/     - RackPermutations *permutations: The iterator.
 /
 /   Caller Output:
-/     - void: No return value. Updates the combinations array and totalCombinations.
+/     - const char *: The permutation, valid until the next call; NULL once
+/       every permutation was returned.
 /
 /   Assumptions, Limitations, Known Bugs:
-/     - N/A
+/     - Never allocates; each step costs at most the rack length times the
+/       number of distinct letters.
 /---------------------------------------------------------*/
-
-static void permute(char *letters, int left, int right, char *combinations[], unsigned int *totalCombinations)
+const char *nextRackPermutation(RackPermutations *permutations)
 {
-    if (left == right)
-    {
-        combinations[*totalCombinations] = malloc(strlen(letters) + 1);
-        strcpy(combinations[*totalCombinations], letters);
-        (*totalCombinations)++;
-        return;
-    }
+    int candidate = 0; // Smallest letter that may go in the next position
 
-    bool used[256] = {false};
-    permuteRecursive(letters, left, right, combinations, totalCombinations, used, left);
-}
-
-/*---------- FUNCTION: generateCombinationsRecursive -----------------------------------
-/   Function Description:
-/     Recursively explores possible subsets of the input letters, adding them
-/     to the combination buffer and generating permutations.
-/   Caller Input:
-/     - const char *letters: The input letters.
-/     - int totalLetters: Total number of letters.
-/     - char *combination: Buffer for the current combination.
-/     - int i: Current index within the letters.
-/     - int index: Current length of the combination.
-/     - char *combinations[]: Array to store generated combinations.
-/     - unsigned int *totalCombinations: Pointer to track the total combinations.
-/     - bool used[]: Tracks used characters to avoid duplicates.
-/   Caller Output:
-/     - void: Updates 'combinations' and 'totalCombinations'.
-/   Assumptions, Limitations, Known Bugs:
-/     - N/A
-/---------------------------------------------------------*/
-static void generateCombinationsRecursive(const char *letters, int totalLetters, char *combination, int i, int index, char *combinations[], unsigned int *totalCombinations, bool used[])
-{
-    if (i >= totalLetters)
+    if (permutations->finished)
     {
-        return;
+        return NULL;
     }
 
-    unsigned char c = (unsigned char)letters[i];
-    if (!used[c])
+    while (true)
     {
-        used[c] = true;
-        combination[index] = letters[i];
-        generateCombinationsRecurse(letters, totalLetters, combination, i + 1, index + 1, combinations, totalCombinations);
-    }
+        int letter = candidate;
+        while (letter < permutations->totalLetters && permutations->counts[letter] == 0)
+        {
+            letter++;
+        }
 
-    generateCombinationsRecursive(letters, totalLetters, combination, i + 1, index, combinations, totalCombinations, used);
-}
+        if (letter < permutations->totalLetters)
+        {
+            int length = permutations->length++;
+            permutations->counts[letter]--;
+            permutations->picks[length] = letter;
+            permutations->current[length] = permutations->letters[letter];
+            permutations->current[length + 1] = '\0';
+            return permutations->current;
+        }
 
-/*---------- FUNCTION: generateCombinationsRecurse -----------------------------------
-/   Function Description:
-/     Recursively generates letter combinations and their permutations.
-/
-/   Caller Input:
-/     - const char *letters: The input letters.
-/     - int totalLetters: Total number of input letters.
-/     - char *combination: Buffer to store the current combination.
-/     - int start: Starting index for the next letter.
-/     - int index: Current index in the combination buffer.
-/     - char *combinations[]: Array to store generated combinations.
-/     - unsigned int *totalCombinations: Pointer to the total number of combinations.
-/
-/   Caller Output:
-/     - void: No return value. Updates the combinations array and totalCombinations.
-/
-/   Assumptions, Limitations, Known Bugs:
-/     - N/A
-/---------------------------------------------------------*/
+        if (permutations->length == 0)
+        {
+            permutations->finished = true;
+            return NULL;
+        }
 
-static void generateCombinationsRecurse(const char *letters, int totalLetters, char *combination, int start, int index, char *combinations[], unsigned int *totalCombinations)
-{
-    if (index > 0)
-    {
-        combination[index] = '\0';
-        permute(combination, 0, index - 1, combinations, totalCombinations);
+        // Give the last letter back and try a larger one in its place
+        int last = permutations->picks[--permutations->length];
+        permutations->counts[last]++;
+        permutations->current[permutations->length] = '\0';
+        candidate = last + 1;
     }
-
-    bool used[256] = {false};
-    generateCombinationsRecursive(letters, totalLetters, combination, start, index, combinations, totalCombinations, used);
 }
 
-/*---------- FUNCTION: sortArrayAlphabetically -----------------------------------
+/*---------- FUNCTION: takeRackPermutations -----------------------------------
 /   Function Description:
-/     Sorts an array of strings alphabetically.
+/     Copies the next permutations of an iterator into a chunk, so workers
+/     sharing one iterator can each take a batch under a single lock.
 /
 /   Caller Input:
-/     - char *array[]: Array of strings to sort.
-/     - unsigned int size: Size of the array.
+/     - RackPermutations *permutations: The iterator.
+/     - char chunk[][MAX_COMBINATION_LENGTH + 1]: Receives the permutations.
+/     - int maxPermutations: Capacity of chunk.
 /
 /   Caller Output:
-/     - void: No return value. Sorts the array directly.
+/     - int: Number of permutations copied, 0 once the iterator is exhausted.
 /
 /   Assumptions, Limitations, Known Bugs:
-/     - Uses bubble sort.
+/     - N/A
 /---------------------------------------------------------*/
-static void sortArrayAlphabetically(char *array[], unsigned int size)
+int takeRackPermutations(RackPermutations *permutations, char chunk[][MAX_COMBINATION_LENGTH + 1], int maxPermutations)
 {
-    for (unsigned int i = 0; i < size - 1; i++)
+    int taken = 0;
+    const char *permutation;
+
+    while (taken < maxPermutations && (permutation = nextRackPermutation(permutations)) != NULL)
     {
-        for (unsigned int j = 0; j < size - i - 1; j++)
-        {
-            if (strcmp(array[j], array[j + 1]) > 0)
-            {
-                char *temp = array[j];
-                array[j] = array[j + 1];
-                array[j + 1] = temp;
-            }
-        }
+        strcpy(chunk[taken++], permutation);
     }
+    return taken;
 }
 
 /*---------- FUNCTION: generateCombinations -----------------------------------
@@ -703,16 +683,24 @@ static void sortArrayAlphabetically(char *array[], unsigned int size)
 /     - void: No return value. The generated combinations are stored in the 'combinations' array, and the 'totalCombinations' variable is updated.
 /
 /   Assumptions, Limitations, Known Bugs:
-/     - N/A
+/     - The combinations come from a RackPermutations iterator, already
+/       sorted alphabetically; callers that do not need them all at once
+/       should use the iterator and avoid the allocations.
+/     - Only the first MAX_COMBINATION_LENGTH letters are used.
 /---------------------------------------------------------*/
 
 void generateCombinations(const char *letters, char *combinations[], unsigned int *totalCombinations)
 {
-    int totalLetters = strlen(letters);
-    char currCombination[totalLetters + 1];
+    RackPermutations permutations;
+    const char *permutation;
 
-    generateCombinationsRecurse(letters, totalLetters, currCombination, 0, 0, combinations, totalCombinations);
-    sortArrayAlphabetically(combinations, *totalCombinations);
+    initRackPermutations(&permutations, letters);
+    while ((permutation = nextRackPermutation(&permutations)) != NULL)
+    {
+        combinations[*totalCombinations] = malloc(strlen(permutation) + 1);
+        strcpy(combinations[*totalCombinations], permutation);
+        (*totalCombinations)++;
+    }
 }
 
 /*---------- FUNCTION: pickBestMove -----------------------------------
@@ -733,7 +721,7 @@ Move pickBestMove(Move foundMoves[], int totalMovesFound)
 {
     if (totalMovesFound <= 0)
     {
-        Move emptyMove = {0, 0, 0, " ", 0, false};
+        Move emptyMove = {0, 0, 0, " ", 0};
         return emptyMove;
     }
 
@@ -752,50 +740,152 @@ Move pickBestMove(Move foundMoves[], int totalMovesFound)
 /*---------- FUNCTION: findBestMove -----------------------------------
 /   Function Description:
 /     Finds the best possible move by generating all valid moves for the given rack
-/     and selecting the move with the highest score.
+/     with the anchor-based generator and selecting the move with the highest score.
 /   Caller Input:
 /     - TrieNode *root: Pointer to the Trie used for word validation.
-/     - Square board[BOARD_SIZE][BOARD_SIZE]: The game board.
+/     - Board *board: The game board.
 /     - char *rack: The letters the player has.
 /   Caller Output:
 /     - Move: The highest-scoring move.
 /   Assumptions, Limitations, Known Bugs:
 /     - N/A
 /---------------------------------------------------------*/
-Move findBestMove(TrieNode *root, Square board[BOARD_SIZE][BOARD_SIZE], char *rack)
+Move findBestMove(TrieNode *root, Board *board, char *rack)
 {
-    size_t rack_len = strlen(rack);
-    char *upper_rack = malloc(rack_len + 1);
-    unsigned int totalCombinations = 0;
-    char *combinations[MAX_TOTAL_COMBINATIONS];
-    int totalMovesFound = 0;
+    Dictionary dictionary = {root, NULL, NULL, NULL};
 
-    for (size_t i = 0; i < rack_len; i++)
-    {
-        upper_rack[i] = toupper(rack[i]);
-    }
-    upper_rack[rack_len] = '\0';
+    return findBestMoveInDictionary(&dictionary, board, rack);
+}
 
-    generateCombinations(upper_rack, combinations, &totalCombinations);
+/*---------- FUNCTION: findBestMoveInDictionary -----------------------------------
+/   Function Description:
+/     Finds the best possible move using whichever structures the dictionary
+/     holds. The GADDAG is preferred, then the DAWG, then the Trie.
+/   Caller Input:
+/     - const Dictionary *dictionary: The loaded dictionary.
+/     - Board *board: The game board.
+/     - char *rack: The letters the player has.
+/   Caller Output:
+/     - Move: The highest-scoring move, an empty move if there is none.
+/   Assumptions, Limitations, Known Bugs:
+/     - The dictionary must hold a Trie, a DAWG or a GADDAG.
+/     - Only the best move so far is kept while searching (see findTopMoves).
+/---------------------------------------------------------*/
+Move findBestMoveInDictionary(const Dictionary *dictionary, Board *board, char *rack)
+{
+    Move bestMove = {0, 0, 0, " ", 0};
 
-    Move *foundMoves = malloc(100000 * sizeof(Move));
-    if (foundMoves == NULL)
-    {
-        fprintf(stderr, "Memory allocation failed\n");
-        free(upper_rack);
-        freeTrie(root);
-    }
+    findTopMoves(dictionary, board, rack, &bestMove, 1, 1);
+
+    return bestMove;
+}
+
+/*---------- FUNCTION: findBestMoveWithin -----------------------------------
+/   Function Description:
+/     Finds the best move the search reaches within a budget.
+/   Caller Input:
+/     - const Dictionary *dictionary: The loaded dictionary.
+/     - Board *board: The game board.
+/     - char *rack: The letters the player has.
+/     - SearchBudget budget: Limits of the search, SEARCH_EXHAUSTIVE for none.
+/     - bool *complete: Set to false if the move may not be the best; may be NULL.
+/   Caller Output:
+/     - Move: The best move found, an empty move if none was.
+/   Assumptions, Limitations, Known Bugs:
+/     - See findTopMovesWithin.
+/---------------------------------------------------------*/
+Move findBestMoveWithin(const Dictionary *dictionary, Board *board, char *rack, SearchBudget budget, bool *complete)
+{
+    Move bestMove = {0, 0, 0, " ", 0};
 
-    findMoves(root, foundMoves, &totalMovesFound, board, combinations, totalCombinations);
+    findTopMovesWithin(dictionary, board, rack, &bestMove, 1, 1, budget, complete);
 
-    Move bestMove = pickBestMove(foundMoves, totalMovesFound);
+    return bestMove;
+}
 
-    free(upper_rack);
-    free(foundMoves);
-    for (unsigned int i = 0; i < totalCombinations; i++)
+/*---------- FUNCTION: findTopMoves -----------------------------------
+/   Function Description:
+/     Finds the highest-scoring moves, best first, with an exhaustive
+/     search (see findTopMovesWithin).
+/   Caller Input:
+/     - const Dictionary *dictionary: The loaded dictionary.
+/     - Board *board: The game board.
+/     - const char *rack: The letters the player has.
+/     - Move topMoves[]: Array to store the moves in.
+/     - int maxMoves: How many moves to find (the capacity of topMoves).
+/     - int threads: Number of threads to search with.
+/   Caller Output:
+/     - int: Number of moves stored, fewer than maxMoves if fewer exist.
+/   Assumptions, Limitations, Known Bugs:
+/     - N/A
+/---------------------------------------------------------*/
+int findTopMoves(const Dictionary *dictionary, Board *board, const char *rack, Move topMoves[], int maxMoves, int threads)
+{
+    return findTopMovesWithin(dictionary, board, rack, topMoves, maxMoves, threads, SEARCH_EXHAUSTIVE, NULL);
+}
+
+/*---------- FUNCTION: findTopMovesWithin -----------------------------------
+/   Function Description:
+/     Finds the highest-scoring moves, best first, keeping only as many
+/     moves as were asked for while the generator runs, and stops early
+/     once the budget is spent.
+/   Caller Input:
+/     - const Dictionary *dictionary: The loaded dictionary.
+/     - Board *board: The game board.
+/     - const char *rack: The letters the player has.
+/     - Move topMoves[]: Array to store the moves in.
+/     - int maxMoves: How many moves to find (the capacity of topMoves).
+/     - int threads: Number of threads to search with.
+/     - SearchBudget budget: Limits of the search, SEARCH_EXHAUSTIVE for none.
+/     - bool *complete: Set to false if the search stopped early; may be NULL.
+/   Caller Output:
+/     - int: Number of moves stored, fewer than maxMoves if fewer exist.
+/   Assumptions, Limitations, Known Bugs:
+/     - Moves with equal scores keep the order findMoves reports them in, so
+/       the first move is the one pickBestMove would choose.
+/     - Anchors whose score bound cannot reach the moves found so far are
+/       not searched; a search that is not stopped early returns the same
+/       moves as a full search, whatever the thread count.
+/     - Up to TOP_MOVES_ON_STACK moves are kept on the stack, so a search on
+/       one thread does not allocate.
+/     - The cross-checks are computed on a copy of the board, so only moves
+/       whose perpendicular words are valid are found and the board is not
+/       changed.
+/---------------------------------------------------------*/
+int findTopMovesWithin(const Dictionary *dictionary, Board *board, const char *rack, Move topMoves[], int maxMoves, int threads, SearchBudget budget, bool *complete)
+{
+    GeneratedMove scratch[TOP_MOVES_ON_STACK];
+    Board checkedBoard;
+    MoveSink sink;
+
+    if (complete != NULL)
+    {
+        *complete = true;
+    }
+    if (maxMoves <= 0)
     {
-        free(combinations[i]);
+        return 0;
+    }
+    if (maxMoves <= TOP_MOVES_ON_STACK)
+    {
+        initMoveSinkInBuffer(&sink, maxMoves, scratch, TOP_MOVES_ON_STACK);
+    }
+    else if (!initMoveSink(&sink, maxMoves))
+    {
+        return 0;
     }
 
-    return bestMove;
-}
\ No newline at end of file
+    sink.allowPruning = true;
+    setMoveSinkBudget(&sink, budget);
+    checkedBoard = *board;
+    computeCrossChecks(checkedBoard.squares, dictionary);
+    generateMovesIntoSink(dictionary, &checkedBoard, rack, &sink, threads);
+    int totalMoves = copyMoveSink(&sink, topMoves, maxMoves);
+    if (complete != NULL)
+    {
+        *complete = !sink.stoppedEarly;
+    }
+    freeMoveSink(&sink);
+
+    return totalMoves;
+}
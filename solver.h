@@ -18,14 +18,51 @@
 
 #include "io.h"
 #include "dataStruct.h"
+#include "moveSink.h"
 
 #define MAX_TOTAL_COMBINATIONS 150000 // Highest amount of total combinations possible with 7 pieces in the players Hand
+#define MAX_COMBINATION_LENGTH BOARD_SIZE // Longest combination generateCombinations builds
+#define TOP_MOVES_ON_STACK 16 // Largest number of moves findTopMoves keeps without allocating
+
+// Iterator over the distinct permutations of every subset of a rack, in strcmp order
+typedef struct RackPermutations {
+    char letters[MAX_COMBINATION_LENGTH];    // Distinct rack letters, in strcmp order.
+    int counts[MAX_COMBINATION_LENGTH];      // Copies of each letter not in the current permutation.
+    int totalLetters;                        // Number of distinct letters.
+    int picks[MAX_COMBINATION_LENGTH];       // Letter index at each position of the current permutation.
+    int length;                              // Length of the current permutation.
+    char current[MAX_COMBINATION_LENGTH + 1];
+    bool finished;
+} RackPermutations;
 
 // The following functions are only included in the header to enable easier testing in tester.c
 void findMoves(TrieNode *root, Move foundMoves[], int *totalMovesFound, Square board[BOARD_SIZE][BOARD_SIZE], char *combinationsToTest[], int totalCombinations);
 void generateCombinations(const char *letters, char *combinations[], unsigned int *totalCombinations);
 Move pickBestMove(Move foundMoves[], int totalMovesFound);
 
+/*---------- FUNCTION: nextRackPermutation -----------------------------------
+/   Function Description:
+/     Streams the permutations generateCombinations would build, in the same
+/     order, one at a time and without allocating. initRackPermutations
+/     starts the iterator; takeRackPermutations copies the next batch into a
+/     chunk.
+/   Caller Input:
+/     - RackPermutations *permutations: The iterator.
+/   Caller Output:
+/     - const char *: The next permutation, NULL once every one was returned.
+/   Assumptions, Limitations, Known Bugs:
+/     - The iterator is plain data: a copy resumes from the same point, so
+/       a search can be paused, or a shared iterator can hand out chunks to
+/       parallel workers while the caller holds a lock.
+/---------------------------------------------------------*/
+void initRackPermutations(RackPermutations *permutations, const char *rack);
+const char *nextRackPermutation(RackPermutations *permutations);
+int takeRackPermutations(RackPermutations *permutations, char chunk[][MAX_COMBINATION_LENGTH + 1], int maxPermutations);
+
+// Shared with the anchor-based generator in moveGenerator.c so both score moves identically
+extern const int letterScores[MAX_CHARACTERS];
+void calculateScore(Move *move, Square board[BOARD_SIZE][BOARD_SIZE], int rackLettersUsed);
+
 /*---------- FUNCTION: findBestMove -----------------------------------
 /   Function Description:
 /     Finds the best possible move by generating all valid moves for the given rack
@@ -34,13 +71,77 @@ Move pickBestMove(Move foundMoves[], int totalMovesFound);
 /     - This will be the only "public" function in the solver.c file.
 /   Caller Input:
 /     - TrieNode *root: Pointer to the Trie used for word validation.
-/     - Square board[BOARD_SIZE][BOARD_SIZE]: The game board.
+/     - Board *board: The game board.
 /     - char *rack: The letters the player has.
 /   Caller Output:
 /     - Move: The highest-scoring move.
 /   Assumptions, Limitations, Known Bugs:
 /     - N/A
 /---------------------------------------------------------*/
-Move findBestMove(TrieNode *root, Square board[BOARD_SIZE][BOARD_SIZE], char *rack);
+Move findBestMove(TrieNode *root, Board *board, char *rack);
+
+/*---------- FUNCTION: findBestMoveInDictionary -----------------------------------
+/   Function Description:
+/     Same as findBestMove, but generates moves with the GADDAG when the
+/     dictionary was loaded with one, falling back to the DAWG and then the
+/     Trie otherwise.
+/   Caller Input:
+/     - const Dictionary *dictionary: The loaded dictionary.
+/     - Board *board: The game board.
+/     - char *rack: The letters the player has.
+/   Caller Output:
+/     - Move: The highest-scoring move.
+/   Assumptions, Limitations, Known Bugs:
+/     - N/A
+/---------------------------------------------------------*/
+Move findBestMoveInDictionary(const Dictionary *dictionary, Board *board, char *rack);
+
+/*---------- FUNCTION: findTopMoves -----------------------------------
+/   Function Description:
+/     Finds up to maxMoves of the highest-scoring moves, best first, for
+/     callers that want ranked alternatives to the best move.
+/   Caller Input:
+/     - const Dictionary *dictionary: The loaded dictionary.
+/     - Board *board: The game board.
+/     - const char *rack: The letters the player has.
+/     - Move topMoves[]: Array to store the moves in.
+/     - int maxMoves: How many moves to find (the capacity of topMoves).
+/     - int threads: Number of threads to search with (values below 1 mean 1).
+/   Caller Output:
+/     - int: Number of moves stored.
+/   Assumptions, Limitations, Known Bugs:
+/     - Only maxMoves moves per thread are held in memory while searching.
+/     - The moves and their order do not depend on the thread count.
+/---------------------------------------------------------*/
+int findTopMoves(const Dictionary *dictionary, Board *board, const char *rack, Move topMoves[], int maxMoves, int threads);
+
+/*---------- FUNCTION: findTopMovesWithin -----------------------------------
+/   Function Description:
+/     Anytime variant of findTopMoves: the anchors are searched most
+/     promising first (highest score bound, which favours open premium
+/     squares), and once the time or move budget is spent the search stops
+/     and returns the best moves found so far.
+/   Caller Input:
+/     - const Dictionary *dictionary: The loaded dictionary.
+/     - Board *board: The game board.
+/     - const char *rack: The letters the player has.
+/     - Move topMoves[]: Array to store the moves in.
+/     - int maxMoves: How many moves to find (the capacity of topMoves).
+/     - int threads: Number of threads to search with (values below 1 mean 1).
+/     - SearchBudget budget: Limits of the search, SEARCH_EXHAUSTIVE for none.
+/     - bool *complete: Set to false if the search stopped early and the
+/       moves may not be the best; may be NULL.
+/   Caller Output:
+/     - int: Number of moves stored.
+/   Assumptions, Limitations, Known Bugs:
+/     - The budget is checked between anchor searches, so the search can
+/       overrun its time by the length of one anchor search.
+/     - A search that stopped early may return different moves for
+/       different thread counts.
+/     - The cross-checks are computed on a copy of the board, so the moves
+/       only form valid perpendicular words and the board is not changed.
+/---------------------------------------------------------*/
+int findTopMovesWithin(const Dictionary *dictionary, Board *board, const char *rack, Move topMoves[], int maxMoves, int threads, SearchBudget budget, bool *complete);
+Move findBestMoveWithin(const Dictionary *dictionary, Board *board, char *rack, SearchBudget budget, bool *complete);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,409 @@
+/*---------- ID HEADER -------------------------------------
+/   Author(s):    Aidan Andrews, Kyle Scidmore
+/   File Name:    solverClient.c
+/
+/   File Description:
+/     This file is a small client and load generator for the solver
+/     service (scrableSolver --serve, see server.h). It reads jobs in the
+/     batch job format, sends them over one or more connections, each
+/     waiting for a reply before sending its next request, and reports
+/     the throughput and the latency percentiles it saw. With one
+/     connection and one round the replies are printed as well.
+/
+/---------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "dataStruct.h"
+
+#define CLIENT_LINE_LENGTH 512
+
+// Jobs read from the job file, one request line each
+typedef struct ClientJobs
+{
+    char **lines;
+    int totalLines;
+} ClientJobs;
+
+// One connection of the load test
+typedef struct ClientConnection
+{
+    const char *socketPath;
+    const ClientJobs *jobs;
+    int rounds;
+    bool printReplies;
+    long *latencies; // Microseconds, one per request sent.
+    long totalRequests;
+    bool failed;
+    pthread_t thread;
+} ClientConnection;
+
+/* FUNCTION PROTOTYPES*/
+static double now(void);
+static int connectToServer(const char *socketPath);
+static bool sendRequest(int fd, const char *line, char **reply, size_t *replySize);
+static bool readJobs(FILE *input, ClientJobs *jobs);
+static void *runClientConnection(void *argument);
+static int compareLongs(const void *a, const void *b);
+
+int main(int argc, char *argv[])
+{
+    int connections = 1;
+    int rounds = 1;
+    bool showStats = false;
+
+    while (argc >= 2 && strncmp(argv[1], "--", 2) == 0 && strcmp(argv[1], "-") != 0)
+    {
+        if (strcmp(argv[1], "--stats") == 0)
+        {
+            showStats = true;
+            argv++;
+            argc--;
+            continue;
+        }
+        if (argc < 3 || (strcmp(argv[1], "--connections") != 0 && strcmp(argv[1], "--rounds") != 0))
+        {
+            argc = 0;
+            break;
+        }
+        int value = atoi(argv[2]);
+        value = value < 1 ? 1 : value;
+        if (strcmp(argv[1], "--connections") == 0)
+        {
+            connections = value;
+        }
+        else
+        {
+            rounds = value;
+        }
+        argv += 2;
+        argc -= 2;
+    }
+    if (argc != 2 && argc != 3)
+    {
+        fprintf(stderr, "Usage: solverClient [--connections <count>] [--rounds <count>] [--stats] <socket_path> [job_file|-]\n");
+        return 1;
+    }
+
+    // Without a job file only the counters are asked for
+    ClientJobs jobs = {NULL, 0};
+    if (argc == 3 || !showStats)
+    {
+        FILE *input = argc == 3 && strcmp(argv[2], "-") != 0 ? fopen(argv[2], "r") : stdin;
+        if (input == NULL || !readJobs(input, &jobs))
+        {
+            perror("Failed to read the jobs");
+            return 1;
+        }
+        if (input != stdin)
+        {
+            fclose(input);
+        }
+    }
+
+    int status = 0;
+    if (jobs.totalLines > 0)
+    {
+        ClientConnection *clients = (ClientConnection *)calloc(connections, sizeof(ClientConnection));
+        long perConnection = (long)jobs.totalLines * rounds;
+        long *latencies = (long *)malloc(perConnection * connections * sizeof(long));
+        if (clients == NULL || latencies == NULL)
+        {
+            perror("Failed to allocate memory");
+            return 1;
+        }
+
+        double start = now();
+        for (int i = 0; i < connections; i++)
+        {
+            clients[i].socketPath = argv[1];
+            clients[i].jobs = &jobs;
+            clients[i].rounds = rounds;
+            clients[i].printReplies = connections == 1 && rounds == 1;
+            clients[i].latencies = latencies + perConnection * i;
+            pthread_create(&clients[i].thread, NULL, runClientConnection, &clients[i]);
+        }
+
+        // Gather the latencies of every connection at the front of the array
+        long totalRequests = 0;
+        for (int i = 0; i < connections; i++)
+        {
+            pthread_join(clients[i].thread, NULL);
+            memmove(latencies + totalRequests, clients[i].latencies, clients[i].totalRequests * sizeof(long));
+            totalRequests += clients[i].totalRequests;
+            status |= clients[i].failed;
+        }
+        double seconds = now() - start;
+
+        qsort(latencies, totalRequests, sizeof(long), compareLongs);
+        fprintf(stderr, "Sent %ld requests on %d connections in %.2f s (%.1f requests/s)",
+                totalRequests, connections, seconds, seconds > 0 ? totalRequests / seconds : 0.0);
+        if (totalRequests > 0)
+        {
+            fprintf(stderr, ", p50 %ld us, p99 %ld us", latencies[(totalRequests - 1) / 2],
+                    latencies[(totalRequests * 99 + 99) / 100 - 1]);
+        }
+        fprintf(stderr, "\n");
+        free(latencies);
+        free(clients);
+    }
+
+    if (showStats)
+    {
+        char *reply = NULL;
+        size_t replySize = 0;
+        int fd = connectToServer(argv[1]);
+        if (fd < 0 || !sendRequest(fd, "STATS", &reply, &replySize))
+        {
+            status = 1;
+        }
+        else
+        {
+            fputs(reply, stdout);
+        }
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+        free(reply);
+    }
+
+    for (int i = 0; i < jobs.totalLines; i++)
+    {
+        free(jobs.lines[i]);
+    }
+    free(jobs.lines);
+    return status;
+}
+
+/*---------- FUNCTION: now -----------------------------------
+/   Function Description:
+/     Returns a monotonic time stamp.
+/   Caller Input:
+/     - None.
+/   Caller Output:
+/     - double: Seconds since an arbitrary point.
+/   Assumptions, Limitations, Known Bugs:
+/     - N/A
+/---------------------------------------------------------*/
+static double now(void)
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec + time.tv_nsec / 1e9;
+}
+
+/*---------- FUNCTION: connectToServer -----------------------------------
+/   Function Description:
+/     Opens a connection to the service.
+/   Caller Input:
+/     - const char *socketPath: Path of the service's socket.
+/   Caller Output:
+/     - int: The connection, -1 if it could not be opened.
+/   Assumptions, Limitations, Known Bugs:
+/     - N/A
+/---------------------------------------------------------*/
+static int connectToServer(const char *socketPath)
+{
+    struct sockaddr_un address;
+
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, socketPath, sizeof(address.sun_path) - 1);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, (struct sockaddr *)&address, sizeof(address)) != 0)
+    {
+        perror("Failed to connect to the server");
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+        return -1;
+    }
+    return fd;
+}
+
+/*---------- FUNCTION: sendRequest -----------------------------------
+/   Function Description:
+/     Sends one request line and reads its reply up to the empty line
+/     that ends it.
+/   Caller Input:
+/     - int fd: The connection.
+/     - const char *line: The request, without a line ending.
+/     - char **reply: Buffer receiving the reply; grown as needed.
+/     - size_t *replySize: Size of the reply buffer.
+/   Caller Output:
+/     - bool: False if the connection failed.
+/   Assumptions, Limitations, Known Bugs:
+/     - Only one request may be outstanding on the connection.
+/---------------------------------------------------------*/
+static bool sendRequest(int fd, const char *line, char **reply, size_t *replySize)
+{
+    size_t length = strlen(line);
+    if (send(fd, line, length, MSG_NOSIGNAL) != (ssize_t)length || send(fd, "\n", 1, MSG_NOSIGNAL) != 1)
+    {
+        return false;
+    }
+
+    size_t used = 0;
+    while (used < 2 || (*reply)[used - 1] != '\n' || (*reply)[used - 2] != '\n')
+    {
+        if (used + CLIENT_LINE_LENGTH >= *replySize)
+        {
+            char *grown = (char *)realloc(*reply, *replySize + 2 * CLIENT_LINE_LENGTH);
+            if (grown == NULL)
+            {
+                return false;
+            }
+            *reply = grown;
+            *replySize += 2 * CLIENT_LINE_LENGTH;
+        }
+        ssize_t received = recv(fd, *reply + used, *replySize - used - 1, 0);
+        if (received < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (received <= 0)
+        {
+            return false;
+        }
+        used += received;
+    }
+    (*reply)[used] = '\0';
+    return true;
+}
+
+/*---------- FUNCTION: readJobs -----------------------------------
+/   Function Description:
+/     Reads every job of a job file as a one-line request, turning jobs
+/     written as a rack line and 15 board rows into the compact form.
+/   Caller Input:
+/     - FILE *input: The job stream.
+/     - ClientJobs *jobs: Receives the request lines.
+/   Caller Output:
+/     - bool: False if memory ran out.
+/   Assumptions, Limitations, Known Bugs:
+/     - Board rows that are too short are padded with empty squares; the
+/       service reports such boards like any other.
+/---------------------------------------------------------*/
+static bool readJobs(FILE *input, ClientJobs *jobs)
+{
+    char line[CLIENT_LINE_LENGTH];
+    int capacity = 0;
+
+    while (fgets(line, sizeof(line), input) != NULL)
+    {
+        line[strcspn(line, "\r\n")] = '\0';
+        if (line[strspn(line, " \t")] == '\0' || line[0] == '#')
+        {
+            continue;
+        }
+
+        char request[CLIENT_LINE_LENGTH];
+        if (strchr(line, ' ') != NULL || strchr(line, '\t') != NULL)
+        {
+            strcpy(request, line);
+        }
+        else
+        {
+            char *squares = request + snprintf(request, sizeof(request) - BOARD_SQUARES - 1, "%s ", line);
+            memset(squares, '_', BOARD_SQUARES);
+            squares[BOARD_SQUARES] = '\0';
+            for (int row = 0; row < BOARD_SIZE && fgets(line, sizeof(line), input) != NULL; row++)
+            {
+                size_t length = strcspn(line, "\r\n");
+                memcpy(squares + row * BOARD_SIZE, line, length < BOARD_SIZE ? length : BOARD_SIZE);
+            }
+        }
+
+        if (jobs->totalLines == capacity)
+        {
+            capacity = capacity == 0 ? 64 : capacity * 2;
+            char **lines = (char **)realloc(jobs->lines, capacity * sizeof(char *));
+            if (lines == NULL)
+            {
+                return false;
+            }
+            jobs->lines = lines;
+        }
+        jobs->lines[jobs->totalLines] = strdup(request);
+        if (jobs->lines[jobs->totalLines++] == NULL)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*---------- FUNCTION: runClientConnection -----------------------------------
+/   Function Description:
+/     Sends every job, round after round, over one connection and keeps
+/     the latency of each request.
+/   Caller Input:
+/     - void *argument: The ClientConnection.
+/   Caller Output:
+/     - void *: Always NULL.
+/   Assumptions, Limitations, Known Bugs:
+/     - Stops at the first failed request and marks the connection failed.
+/---------------------------------------------------------*/
+static void *runClientConnection(void *argument)
+{
+    ClientConnection *client = (ClientConnection *)argument;
+    char *reply = NULL;
+    size_t replySize = 0;
+
+    int fd = connectToServer(client->socketPath);
+    client->failed = fd < 0;
+    for (int round = 0; round < client->rounds && !client->failed; round++)
+    {
+        for (int i = 0; i < client->jobs->totalLines; i++)
+        {
+            double start = now();
+            if (!sendRequest(fd, client->jobs->lines[i], &reply, &replySize))
+            {
+                fprintf(stderr, "Request failed: the server closed the connection\n");
+                client->failed = true;
+                break;
+            }
+            client->latencies[client->totalRequests++] = (long)((now() - start) * 1e6);
+            if (client->printReplies)
+            {
+                fputs(reply, stdout);
+            }
+        }
+    }
+
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+    free(reply);
+    return NULL;
+}
+
+/*---------- FUNCTION: compareLongs -----------------------------------
+/   Function Description:
+/     qsort comparator for ascending longs.
+/   Caller Input:
+/     - const void *a: First long.
+/     - const void *b: Second long.
+/   Caller Output:
+/     - int: Negative, zero or positive like strcmp.
+/   Assumptions, Limitations, Known Bugs:
+/     - N/A
+/---------------------------------------------------------*/
+static int compareLongs(const void *a, const void *b)
+{
+    long first = *(const long *)a;
+    long second = *(const long *)b;
+    return (first > second) - (first < second);
+}
@@ -0,0 +1,236 @@
+/*---------- ID HEADER -------------------------------------
+/   Author(s):    Aidan Andrews, Kyle Scidmore
+/   File Name:    solverContext.c
+/
+/   File Description:
+/     This file implements the SolverContext. A solve copies the board into
+/     the context, computes its cross-checks there and runs the generator
+/     into a limited sink kept in the context's move storage, using the
+/     context's thread pool when it has more than one thread.
+/
+/---------------------------------------------------------*/
+#include "solverContext.h"
+#include "io.h"
+#include "solver.h"
+#include "moveGenerator.h"
+
+struct SolverContext {
+    const Dictionary *dictionary;  // Dictionary every solve walks.
+    Dictionary *ownedDictionary;   // The same dictionary when the context loaded it, else NULL.
+    GeneratorPool *pool;           // Worker threads, NULL to solve on the calling thread.
+    Board board;                   // Copy of the board being solved, with its cross-checks.
+    GeneratedMove *moves;          // Storage of the move sink.
+    int capacity;                  // Moves the storage holds.
+};
+
+/*---------- FUNCTION: createSolverContext -----------------------------------
+/   Function Description:
+/     Loads a dictionary and creates a context that owns it.
+/   Caller Input:
+/     - const char *dictionaryFile: A word list or a precompiled dictionary image.
+/     - int structures: Structures to build from a word list (DICTIONARY_* flags).
+/     - int threads: Number of threads every solve searches with.
+/   Caller Output:
+/     - SolverContext *: The context, NULL if the dictionary could not be loaded.
+/   Assumptions, Limitations, Known Bugs:
+/     - N/A
+/---------------------------------------------------------*/
+SolverContext *createSolverContext(const char *dictionaryFile, int structures, int threads)
+{
+    Dictionary *dictionary;
+
+    if (isDawgImage(dictionaryFile))
+    {
+        dictionary = loadDictionaryImage(dictionaryFile);
+    }
+    else
+    {
+        dictionary = loadDictionaryStructures(dictionaryFile, structures);
+    }
+    if (dictionary == NULL)
+    {
+        return NULL;
+    }
+
+    SolverContext *context = createSolverContextForDictionary(dictionary, threads);
+    if (context == NULL)
+    {
+        freeDictionary(dictionary);
+        return NULL;
+    }
+    context->ownedDictionary = dictionary;
+    return context;
+}
+
+/*---------- FUNCTION: createSolverContextForDictionary -----------------------------------
+/   Function Description:
+/     Creates a context that solves with a dictionary owned by the caller.
+/   Caller Input:
+/     - const Dictionary *dictionary: The loaded dictionary.
+/     - int threads: Number of threads every solve searches with.
+/   Caller Output:
+/     - SolverContext *: The context, NULL if it could not be allocated.
+/   Assumptions, Limitations, Known Bugs:
+/     - The pool threads are started here and wait between solves.
+/---------------------------------------------------------*/
+SolverContext *createSolverContextForDictionary(const Dictionary *dictionary, int threads)
+{
+    SolverContext *context = (SolverContext *)malloc(sizeof(SolverContext));
+    if (context == NULL)
+    {
+        perror("Failed to allocate memory");
+        return NULL;
+    }
+
+    context->dictionary = dictionary;
+    context->ownedDictionary = NULL;
+    context->pool = NULL;
+    context->moves = NULL;
+    context->capacity = 0;
+
+    if (threads > 1)
+    {
+        context->pool = createGeneratorPool(threads);
+        if (context->pool == NULL)
+        {
+            free(context);
+            return NULL;
+        }
+    }
+    return context;
+}
+
+/*---------- FUNCTION: solveTopMoves -----------------------------------
+/   Function Description:
+/     Finds the highest-scoring moves for a rack, best first, with an
+/     exhaustive search.
+/   Caller Input:
+/     - SolverContext *context: The context.
+/     - Board *board: The loaded game board.
+/     - const char *rack: The letters the player has.
+/     - Move topMoves[]: Array to store the moves in.
+/     - int maxMoves: How many moves to find (the capacity of topMoves).
+/   Caller Output:
+/     - int: Number of moves stored, 0 if the move storage could not grow.
+/   Assumptions, Limitations, Known Bugs:
+/     - N/A
+/---------------------------------------------------------*/
+int solveTopMoves(SolverContext *context, Board *board, const char *rack, Move topMoves[], int maxMoves)
+{
+    return solveTopMovesWithin(context, board, rack, topMoves, maxMoves, SEARCH_EXHAUSTIVE, NULL);
+}
+
+/*---------- FUNCTION: solveTopMovesWithin -----------------------------------
+/   Function Description:
+/     Finds the highest-scoring moves for a rack, best first, stopping once
+/     the budget is spent.
+/   Caller Input:
+/     - SolverContext *context: The context.
+/     - Board *board: The loaded game board.
+/     - const char *rack: The letters the player has.
+/     - Move topMoves[]: Array to store the moves in.
+/     - int maxMoves: How many moves to find (the capacity of topMoves).
+/     - SearchBudget budget: Limits of the search, SEARCH_EXHAUSTIVE for none.
+/     - bool *complete: Set to false if the search stopped early; may be NULL.
+/   Caller Output:
+/     - int: Number of moves stored, 0 if the move storage could not grow.
+/   Assumptions, Limitations, Known Bugs:
+/     - Anchors whose score bound cannot reach the moves found so far are
+/       not searched, as in findTopMoves.
+/---------------------------------------------------------*/
+int solveTopMovesWithin(SolverContext *context, Board *board, const char *rack, Move topMoves[], int maxMoves, SearchBudget budget, bool *complete)
+{
+    MoveSink sink;
+
+    if (complete != NULL)
+    {
+        *complete = true;
+    }
+    if (maxMoves <= 0)
+    {
+        return 0;
+    }
+    if (maxMoves > context->capacity)
+    {
+        GeneratedMove *moves = (GeneratedMove *)realloc(context->moves, maxMoves * sizeof(GeneratedMove));
+        if (moves == NULL)
+        {
+            perror("Failed to allocate memory");
+            return 0;
+        }
+        context->moves = moves;
+        context->capacity = maxMoves;
+    }
+
+    initMoveSinkInBuffer(&sink, maxMoves, context->moves, context->capacity);
+    sink.allowPruning = true;
+    setMoveSinkBudget(&sink, budget);
+
+    context->board = *board;
+    computeCrossChecks(context->board.squares, context->dictionary);
+    generateMovesInPool(context->dictionary, &context->board, rack, &sink, context->pool);
+
+    if (complete != NULL)
+    {
+        *complete = !sink.stoppedEarly;
+    }
+    return copyMoveSink(&sink, topMoves, maxMoves);
+}
+
+/*---------- FUNCTION: solveBestMove -----------------------------------
+/   Function Description:
+/     Finds the highest-scoring move for a rack.
+/   Caller Input:
+/     - SolverContext *context: The context.
+/     - Board *board: The loaded game board.
+/     - const char *rack: The letters the player has.
+/   Caller Output:
+/     - Move: The best move, an empty move if there is none.
+/   Assumptions, Limitations, Known Bugs:
+/     - N/A
+/---------------------------------------------------------*/
+Move solveBestMove(SolverContext *context, Board *board, const char *rack)
+{
+    Move bestMove = {0, 0, 0, " ", 0};
+
+    solveTopMoves(context, board, rack, &bestMove, 1);
+    return bestMove;
+}
+
+/*---------- FUNCTION: solverContextDictionary -----------------------------------
+/   Function Description:
+/     Returns the dictionary a context solves with.
+/   Caller Input:
+/     - const SolverContext *context: The context.
+/   Caller Output:
+/     - const Dictionary *: The dictionary.
+/   Assumptions, Limitations, Known Bugs:
+/     - N/A
+/---------------------------------------------------------*/
+const Dictionary *solverContextDictionary(const SolverContext *context)
+{
+    return context->dictionary;
+}
+
+/*---------- FUNCTION: freeSolverContext -----------------------------------
+/   Function Description:
+/     Stops the threads of a context and frees it, with its dictionary if
+/     the context loaded it.
+/   Caller Input:
+/     - SolverContext *context: The context, may be NULL.
+/   Caller Output:
+/     - void: No return value.
+/   Assumptions, Limitations, Known Bugs:
+/     - N/A
+/---------------------------------------------------------*/
+void freeSolverContext(SolverContext *context)
+{
+    if (context == NULL)
+    {
+        return;
+    }
+    freeGeneratorPool(context->pool);
+    freeDictionary(context->ownedDictionary);
+    free(context->moves);
+    free(context);
+}
@@ -0,0 +1,101 @@
+/*---------- ID HEADER -------------------------------------
+/   Author(s):    Aidan Andrews, Kyle Scidmore
+/   File Name:    solverContext.h
+/
+/   File Description:
+/     This header file declares the SolverContext, which keeps everything a
+/     solve needs resident between solves: the loaded dictionary, the
+/     worker thread pool, a scratch board for the cross-checks and the
+/     storage of the move sink. An application creates one context, issues
+/     any number of solves against it and frees it at the end; after the
+/     first solve no solve starts a thread or allocates.
+/
+/---------------------------------------------------------*/
+#ifndef SOLVERCONTEXT_H
+#define SOLVERCONTEXT_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "dataStruct.h"
+#include "dictionary.h"
+#include "moveSink.h"
+
+// Resident dictionary and scratch state for repeated solves (see createSolverContext)
+typedef struct SolverContext SolverContext;
+
+/*---------- FUNCTION: createSolverContext -----------------------------------
+/   Function Description:
+/     Loads a dictionary and creates a context that owns it.
+/   Caller Input:
+/     - const char *dictionaryFile: A word list or a precompiled dictionary image.
+/     - int structures: Structures to build from a word list (DICTIONARY_* flags).
+/     - int threads: Number of threads every solve searches with.
+/   Caller Output:
+/     - SolverContext *: The context, NULL if the dictionary could not be loaded.
+/   Assumptions, Limitations, Known Bugs:
+/     - An image is recognised by its header; structures is then ignored.
+/---------------------------------------------------------*/
+SolverContext *createSolverContext(const char *dictionaryFile, int structures, int threads);
+
+/*---------- FUNCTION: createSolverContextForDictionary -----------------------------------
+/   Function Description:
+/     Creates a context that solves with a dictionary the caller keeps
+/     owning, so several contexts (one per thread) can share one dictionary.
+/   Caller Input:
+/     - const Dictionary *dictionary: The loaded dictionary.
+/     - int threads: Number of threads every solve searches with.
+/   Caller Output:
+/     - SolverContext *: The context, NULL if it could not be allocated.
+/   Assumptions, Limitations, Known Bugs:
+/     - The dictionary must outlive the context.
+/---------------------------------------------------------*/
+SolverContext *createSolverContextForDictionary(const Dictionary *dictionary, int threads);
+
+/*---------- FUNCTION: solveTopMoves -----------------------------------
+/   Function Description:
+/     Finds the highest-scoring moves for a rack, best first, like
+/     findTopMoves, computing the cross-checks on the context's copy of the
+/     board so the caller's board is left untouched.
+/   Caller Input:
+/     - SolverContext *context: The context.
+/     - Board *board: The loaded game board.
+/     - const char *rack: The letters the player has.
+/     - Move topMoves[]: Array to store the moves in.
+/     - int maxMoves: How many moves to find (the capacity of topMoves).
+/   Caller Output:
+/     - int: Number of moves stored, fewer than maxMoves if fewer exist.
+/   Assumptions, Limitations, Known Bugs:
+/     - Only one solve at a time may use a context.
+/     - Allocates only when maxMoves is larger than in any earlier solve.
+/---------------------------------------------------------*/
+int solveTopMoves(SolverContext *context, Board *board, const char *rack, Move topMoves[], int maxMoves);
+
+/*---------- FUNCTION: solveTopMovesWithin -----------------------------------
+/   Function Description:
+/     Anytime variant of solveTopMoves (see findTopMovesWithin): searches the
+/     most promising anchors first and returns the best moves found so far
+/     once the budget is spent.
+/   Caller Input:
+/     - SolverContext *context: The context.
+/     - Board *board: The loaded game board.
+/     - const char *rack: The letters the player has.
+/     - Move topMoves[]: Array to store the moves in.
+/     - int maxMoves: How many moves to find (the capacity of topMoves).
+/     - SearchBudget budget: Limits of the search, SEARCH_EXHAUSTIVE for none.
+/     - bool *complete: Set to false if the moves may not be the best; may be NULL.
+/   Caller Output:
+/     - int: Number of moves stored.
+/   Assumptions, Limitations, Known Bugs:
+/     - The time budget includes computing the cross-checks.
+/---------------------------------------------------------*/
+int solveTopMovesWithin(SolverContext *context, Board *board, const char *rack, Move topMoves[], int maxMoves, SearchBudget budget, bool *complete);
+
+// Function prototypes
+Move solveBestMove(SolverContext *context, Board *board, const char *rack);
+const Dictionary *solverContextDictionary(const SolverContext *context);
+void freeSolverContext(SolverContext *context);
+
+#endif